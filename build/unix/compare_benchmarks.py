@@ -0,0 +1,91 @@
+#! /usr/bin/env python
+
+'''
+Compare two sets of results of the ROOT micro-benchmarks, as written in JSON
+by the target run-benchmarks, and report the benchmarks which became slower.
+The exit code is 1 if any did by more than the threshold.
+'''
+from __future__ import print_function
+import argparse
+import glob
+import json
+import os
+import sys
+
+_unitToNs = {'ns': 1., 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+#-------------------------------------------------------------------------------
+def getParser():
+    parser = argparse.ArgumentParser(description='Compare the results of the ROOT micro-benchmarks.')
+    parser.add_argument("baseline", help='The JSON file, or the directory of JSON files, of the reference results.')
+    parser.add_argument("contender", help='The JSON file, or the directory of JSON files, of the new results.')
+    parser.add_argument("-t", "--threshold", dest='threshold', type=float, default=5.,
+                        help='The slowdown, in percent, above which a benchmark is reported as a regression.')
+    parser.add_argument("-m", "--metric", dest='metric', choices=['cpu_time', 'real_time'], default='cpu_time',
+                        help='The time which is compared.')
+    parser.add_argument("-a", "--all", dest='all', action='store_true',
+                        help='Print all the benchmarks, not only the regressions.')
+    return parser
+
+#-------------------------------------------------------------------------------
+def readResults(path, metric):
+    '''
+    Return a dictionary from the name of the benchmarks to their time in ns.
+    If the benchmarks were repeated, their median is used.
+    '''
+    if os.path.isdir(path):
+        files = sorted(glob.glob(os.path.join(path, '*.json')))
+    else:
+        files = [path]
+    results = {}
+    medians = {}
+    for fileName in files:
+        with open(fileName) as ifile:
+            data = json.load(ifile)
+        for bench in data.get('benchmarks', []):
+            if 'error_occurred' in bench and bench['error_occurred']:
+                continue
+            time = bench[metric] * _unitToNs[bench.get('time_unit', 'ns')]
+            if bench.get('run_type') == 'aggregate':
+                if bench.get('aggregate_name') == 'median':
+                    medians[bench['run_name']] = time
+                continue
+            # Without aggregates, the last repetition wins.
+            results[bench.get('run_name', bench['name'])] = time
+    results.update(medians)
+    return results
+
+#-------------------------------------------------------------------------------
+def main():
+    args = getParser().parse_args()
+    baseline = readResults(args.baseline, args.metric)
+    contender = readResults(args.contender, args.metric)
+
+    common = sorted(set(baseline) & set(contender))
+    if not common:
+        print('No benchmark in common between %s and %s' % (args.baseline, args.contender), file=sys.stderr)
+        return 2
+
+    width = max(len(name) for name in common)
+    nRegressions = 0
+    print('%-*s %14s %14s %9s' % (width, 'benchmark', 'baseline [ns]', 'contender [ns]', 'change'))
+    for name in common:
+        old = baseline[name]
+        new = contender[name]
+        change = 100. * (new - old) / old if old else 0.
+        isRegression = change > args.threshold
+        if isRegression:
+            nRegressions += 1
+        if isRegression or args.all:
+            print('%-*s %14.1f %14.1f %+8.1f%%%s' % (width, name, old, new, change, ' <--' if isRegression else ''))
+
+    for name in sorted(set(baseline) - set(contender)):
+        print('Missing from the contender: %s' % name)
+    for name in sorted(set(contender) - set(baseline)):
+        print('New in the contender: %s' % name)
+
+    print('%d out of %d benchmarks slower by more than %g%%' % (nRegressions, len(common), args.threshold))
+    return 1 if nRegressions else 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,44 @@
+#---------------------------------------------------------------------------------------------------
+#  RootBenchmarks.cmake
+#   - builds the micro-benchmarks of ROOT with Google Benchmark and the target running them
+#---------------------------------------------------------------------------------------------------
+
+#---Benchmark products should not be poluting the standard destinations---------------------------
+unset(CMAKE_LIBRARY_OUTPUT_DIRECTORY)
+unset(CMAKE_ARCHIVE_OUTPUT_DIRECTORY)
+unset(CMAKE_RUNTIME_OUTPUT_DIRECTORY)
+
+#---Add all subdirectories with benchmarks--------------------------------------------------------
+get_property(bench_list GLOBAL PROPERTY ROOT_BENCHMARK_SUBDIRS)
+if(bench_list)
+  list(SORT bench_list)
+endif()
+
+foreach(d ${bench_list})
+  add_subdirectory(${d})
+endforeach()
+
+#---Target running all the benchmarks, with their results in JSON---------------------------------
+# The results of two builds can be compared with build/unix/compare_benchmarks.py.
+set(ROOT_BENCHMARK_RESULTS_DIR ${CMAKE_BINARY_DIR}/benchmarks CACHE PATH
+    "Directory where the target run-benchmarks writes the results of the benchmarks")
+set(ROOT_BENCHMARK_ARGS "" CACHE STRING
+    "Extra arguments given to the benchmarks by run-benchmarks, e.g. --benchmark_repetitions=5")
+separate_arguments(_bench_args UNIX_COMMAND "${ROOT_BENCHMARK_ARGS}")
+
+file(MAKE_DIRECTORY ${ROOT_BENCHMARK_RESULTS_DIR})
+
+get_property(benchmarks GLOBAL PROPERTY ROOT_BENCHMARKS)
+set(_bench_commands)
+foreach(b ${benchmarks})
+  list(APPEND _bench_commands
+       COMMAND $<TARGET_FILE:${b}> ${_bench_args}
+               --benchmark_out=${ROOT_BENCHMARK_RESULTS_DIR}/${b}.json
+               --benchmark_out_format=json)
+endforeach()
+
+add_custom_target(run-benchmarks ${_bench_commands}
+                  DEPENDS ${benchmarks}
+                  WORKING_DIRECTORY ${ROOT_BENCHMARK_RESULTS_DIR}
+                  COMMENT "Running the benchmarks, results in ${ROOT_BENCHMARK_RESULTS_DIR}"
+                  VERBATIM)
@@ -168,6 +168,7 @@ ROOT_BUILD_OPTION(xml ON "Enable support for XML (requires libxml2)")
 ROOT_BUILD_OPTION(xrootd ON "Enable support for XRootD file server and client")
 
 option(all "Enable all optional components by default" OFF)
+option(benchmarks "Build the micro-benchmarks of the bench/ directories, with Google Benchmark" OFF)
 option(clingtest "Enable cling tests (Note: that this makes llvm/clang symbols visible in libCling)" OFF)
 option(fail-on-missing "Fail at configure time if a required package cannot be found" OFF)
 option(gminimal "Enable only required options by default, but include X11" OFF)
@@ -1386,6 +1386,41 @@ function(ROOT_ADD_TEST_SUBDIRECTORY subdir)
   set_property(GLOBAL APPEND PROPERTY ROOT_TEST_SUBDIRS ${subdir})
 endfunction()
 
+#----------------------------------------------------------------------------
+# ROOT_ADD_BENCHMARK_SUBDIRECTORY( <name> )
+#----------------------------------------------------------------------------
+function(ROOT_ADD_BENCHMARK_SUBDIRECTORY subdir)
+  file(RELATIVE_PATH subdir ${CMAKE_SOURCE_DIR} ${CMAKE_CURRENT_SOURCE_DIR}/${subdir})
+  set_property(GLOBAL APPEND PROPERTY ROOT_BENCHMARK_SUBDIRS ${subdir})
+endfunction()
+
+#----------------------------------------------------------------------------
+# function ROOT_ADD_BENCHMARK(<benchmark> source1 source2... LIBRARIES)
+#
+# Builds a Google Benchmark executable. It is run by the target run-benchmarks,
+# which writes its results in ${CMAKE_BINARY_DIR}/benchmarks/<benchmark>.json,
+# and, if testing is enabled, every benchmark is also run once as a test.
+#----------------------------------------------------------------------------
+function(ROOT_ADD_BENCHMARK benchmark)
+  CMAKE_PARSE_ARGUMENTS(ARG "" "" "LIBRARIES" ${ARGN})
+  include_directories(${CMAKE_CURRENT_BINARY_DIR} ${GBENCHMARK_INCLUDE_DIR})
+
+  ROOT_GET_SOURCES(source_files . ${ARG_UNPARSED_ARGUMENTS})
+  ROOT_EXECUTABLE(${benchmark} ${source_files} NOINSTALL LIBRARIES ${ARG_LIBRARIES})
+  target_link_libraries(${benchmark} benchmark_main benchmark)
+  set_property(GLOBAL APPEND PROPERTY ROOT_BENCHMARKS ${benchmark})
+
+  if(testing)
+    ROOT_PATH_TO_STRING(mangled_name ${benchmark} PATH_SEPARATOR_REPLACEMENT "-")
+    ROOT_ADD_TEST(
+      benchmark${mangled_name}
+      COMMAND ${benchmark} --benchmark_min_time=0
+      WORKING_DIR ${CMAKE_CURRENT_BINARY_DIR}
+      LABELS benchmark
+    )
+  endif()
+endfunction()
+
 #----------------------------------------------------------------------------
 # ROOT_ADD_PYUNITTESTS( <name> )
 #----------------------------------------------------------------------------
@@ -1502,6 +1502,61 @@ if (testing)
 
 endif()
 
+#---Download Google Benchmark--------------------------------------------------------
+if(benchmarks)
+  set(_gbench_byproduct_binary_dir
+    ${CMAKE_CURRENT_BINARY_DIR}/googlebenchmark-prefix/src/googlebenchmark-build/src/)
+  set(_gbench_byproducts
+    ${_gbench_byproduct_binary_dir}/${CMAKE_STATIC_LIBRARY_PREFIX}benchmark${CMAKE_STATIC_LIBRARY_SUFFIX}
+    ${_gbench_byproduct_binary_dir}/${CMAKE_STATIC_LIBRARY_PREFIX}benchmark_main${CMAKE_STATIC_LIBRARY_SUFFIX}
+    )
+
+  if(APPLE)
+    set(EXTRA_GBENCH_OPTS
+      -DCMAKE_OSX_SYSROOT=${CMAKE_OSX_SYSROOT})
+  endif()
+
+  ExternalProject_Add(
+    googlebenchmark
+    GIT_REPOSITORY https://github.com/google/benchmark.git
+    GIT_TAG v1.5.0
+    UPDATE_COMMAND ""
+    # The benchmarks are only meaningful in an optimized build.
+    CMAKE_ARGS -G ${CMAKE_GENERATOR}
+                  -DCMAKE_BUILD_TYPE=Release
+                  -DCMAKE_C_COMPILER=${CMAKE_C_COMPILER}
+                  -DCMAKE_C_FLAGS=${CMAKE_C_FLAGS}
+                  -DCMAKE_CXX_COMPILER=${CMAKE_CXX_COMPILER}
+                  -DCMAKE_CXX_FLAGS=${CMAKE_CXX_FLAGS}
+                  -DCMAKE_AR=${CMAKE_AR}
+                  -DBENCHMARK_ENABLE_TESTING=OFF
+                  -DBENCHMARK_ENABLE_GTEST_TESTS=OFF
+                  -DBENCHMARK_ENABLE_INSTALL=OFF
+                  ${EXTRA_GBENCH_OPTS}
+    # Disable install step
+    INSTALL_COMMAND ""
+    BUILD_BYPRODUCTS ${_gbench_byproducts}
+    # Wrap download, configure and build steps in a script to log output
+    LOG_DOWNLOAD ON
+    LOG_CONFIGURE ON
+    LOG_BUILD ON)
+
+  ExternalProject_Get_Property(googlebenchmark source_dir)
+  set(GBENCHMARK_INCLUDE_DIR ${source_dir}/include)
+
+  # Register benchmark, benchmark_main
+  foreach(lib benchmark benchmark_main)
+    add_library(${lib} IMPORTED STATIC GLOBAL)
+    add_dependencies(${lib} googlebenchmark)
+    set_property(TARGET ${lib} PROPERTY IMPORTED_LOCATION
+                 ${_gbench_byproduct_binary_dir}/${CMAKE_STATIC_LIBRARY_PREFIX}${lib}${CMAKE_STATIC_LIBRARY_SUFFIX})
+  endforeach()
+  set_property(TARGET benchmark PROPERTY INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+  if(CMAKE_SYSTEM_NAME MATCHES Linux)
+    set_property(TARGET benchmark APPEND PROPERTY INTERFACE_LINK_LIBRARIES rt)
+  endif()
+endif()
+
 #------------------------------------------------------------------------------------
 if(webgui)
   ExternalProject_Add(
@@ -0,0 +1,109 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TObjectArena
+#define ROOT_TObjectArena
+
+#include <cstddef>
+#include <vector>
+
+namespace ROOT {
+
+/**
+ * \class ROOT::TObjectArena
+ * \ingroup Base
+ *
+ * A memory arena for short-lived TObjects.
+ *
+ * The TObjects created with `new (arena)` are carved out of large chunks of
+ * memory owned by the arena, by bumping a pointer. Deleting such an object
+ * runs its destructor as usual but does not give its memory back: all of it
+ * is reclaimed at once by Release() and by the destructor of the arena.
+ * Only the objects created explicitly in the arena are served by it: the
+ * objects that ROOT creates meanwhile, e.g. the baskets of a TTree or the
+ * elements of a TClonesArray, come from the heap as usual.
+ *
+ * ~~~{.cpp}
+ * ROOT::TObjectArena arena;
+ * for (Long64_t e = 0; e < nEvents; ++e) {
+ *    tree->GetEntry(e);
+ *    auto v = new (arena) TLorentzVector(px, py, pz, E); // served by the arena
+ *    ...
+ *    delete v;                                           // no call to free
+ *    arena.Release();                                    // the memory is reused
+ * }
+ * ~~~
+ *
+ * The objects allocated from an arena are on the heap for ROOT (IsOnHeap()
+ * is true) and can be owned, and deleted, by collections and directories.
+ * The objects still alive when the memory is reclaimed are not destroyed:
+ * they must not be used anymore, nor be referenced by anything that outlives
+ * the arena (e.g. gROOT's list of cleanups or a TDirectory). They are taken
+ * out of the gObjectTable, if object statistics are on.
+ *
+ * An arena must not be used by several threads at the same time. The objects
+ * it serves may be deleted by any thread. Arrays of TObjects are not served
+ * by arenas.
+ */
+
+class TObjectArena {
+private:
+   static constexpr std::size_t kAlign = alignof(std::max_align_t);
+
+   struct TChunk {
+      char *fMemory;     ///< Memory allocated for the chunk
+      char *fBegin;      ///< Start of the chunk, aligned for the table of chunks
+      std::size_t fSize; ///< Size of the chunk in bytes, a power of two
+      int fSlot;         ///< Index of the chunk in the table of all the chunks
+   };
+
+   std::vector<TChunk> fChunks;   ///< Memory owned by the arena, the current chunk is the last
+   char *fCursor = nullptr;       ///< Next free byte of the current chunk
+   char *fEnd = nullptr;          ///< End of the current chunk
+   std::size_t fChunkSize;        ///< Size of the next chunk to allocate
+   std::size_t fAllocated = 0;    ///< Bytes served since the last Release()
+
+   void *AllocateSlow(std::size_t size);
+   void FreeChunks(std::size_t keep);
+
+public:
+   explicit TObjectArena(std::size_t chunkSize = 65536);
+   ~TObjectArena();
+
+   TObjectArena(const TObjectArena &) = delete;
+   TObjectArena &operator=(const TObjectArena &) = delete;
+
+   /// Return size bytes of memory aligned for any object, valid until the
+   /// next Release(), or nullptr if the arena cannot grow anymore.
+   void *Allocate(std::size_t size)
+   {
+      size = (size + kAlign - 1) & ~(kAlign - 1);
+      if (size <= std::size_t(fEnd - fCursor)) {
+         void *space = fCursor;
+         fCursor += size;
+         fAllocated += size;
+         return space;
+      }
+      return AllocateSlow(size);
+   }
+
+   bool Contains(const void *ptr) const;
+   void Release();
+
+   /// Bytes served since the last Release().
+   std::size_t GetAllocated() const { return fAllocated; }
+   std::size_t GetCapacity() const;
+
+   static bool Owns(const void *ptr);
+};
+
+} // namespace ROOT
+
+#endif
@@ -0,0 +1,73 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TStartupProfile
+#define ROOT_TStartupProfile
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/// The time spent in one phase of the initialization of ROOT.
+struct TStartupPhase {
+   std::string fName;    ///< Name of the phase, e.g. "TCling::LoadLibraryMap"
+   double fSeconds = 0.; ///< Wall clock time spent in the phase, summed over all the calls
+   unsigned fCount = 0;  ///< Number of times the phase was entered
+};
+
+bool IsStartupProfileEnabled();
+void AddStartupTime(const char *phase, double seconds);
+std::vector<TStartupPhase> GetStartupProfile();
+void PrintStartupProfile();
+
+/**
+ * \class TStartupTimer
+ * \ingroup Base
+ *
+ * Adds the time elapsed between its construction and its destruction to a
+ * phase of the startup profile. It does nothing unless the profile was
+ * enabled by setting the environment variable ROOT_STARTUP_PROFILE, in which
+ * case the profile is printed on stderr when the process exits.
+ *
+ * Nested timers are accounted independently: the time of an inner phase is
+ * also part of the time of the enclosing one.
+ */
+
+class TStartupTimer {
+private:
+   using Clock_t = std::chrono::steady_clock;
+
+   const char *fPhase;         ///< Name of the phase, nullptr if the profile is disabled
+   Clock_t::time_point fStart; ///< When the phase was entered
+
+public:
+   explicit TStartupTimer(const char *phase) : fPhase(IsStartupProfileEnabled() ? phase : nullptr)
+   {
+      if (fPhase)
+         fStart = Clock_t::now();
+   }
+
+   ~TStartupTimer()
+   {
+      if (fPhase)
+         AddStartupTime(fPhase, std::chrono::duration<double>(Clock_t::now() - fStart).count());
+   }
+
+   TStartupTimer(const TStartupTimer &) = delete;
+   TStartupTimer &operator=(const TStartupTimer &) = delete;
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -153,6 +153,7 @@ public:
    void    *operator new[](size_t sz) { return TStorage::ObjectAllocArray(sz); }
    void    *operator new(size_t sz, void *vp) { return TStorage::ObjectAlloc(sz, vp); }
    void    *operator new[](size_t sz, void *vp) { return TStorage::ObjectAlloc(sz, vp); }
+   void    *operator new(size_t sz, ROOT::TObjectArena &arena) { return TStorage::ObjectAlloc(sz, arena); }
    void     operator delete(void *ptr);
    void     operator delete[](void *ptr);
 #ifdef R__SIZEDDELETE
@@ -164,6 +165,7 @@ public:
    void     operator delete(void *ptr, void *vp);
    void     operator delete[](void *ptr, void *vp);
 #endif
+   void     operator delete(void *ptr, ROOT::TObjectArena &arena);
 
    //----- bit manipulation
    void     SetBit(UInt_t f, Bool_t set);
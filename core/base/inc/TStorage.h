@@ -24,6 +24,10 @@
 #include "RConfigure.h"
 #include "Rtypes.h"
 
+namespace ROOT {
+class TObjectArena;
+}
+
 typedef void (*FreeHookFun_t)(void*, void *addr, size_t);
 typedef void *(*ReAllocFun_t)(void*, size_t);
 typedef void *(*ReAllocCFun_t)(void*, size_t, size_t);
@@ -66,6 +70,7 @@ public:
    static void          *ObjectAlloc(size_t size);
    static void          *ObjectAllocArray(size_t size);
    static void          *ObjectAlloc(size_t size, void *vp);
+   static void          *ObjectAlloc(size_t size, ROOT::TObjectArena &arena);
    static void           ObjectDealloc(void *vp);
 #ifdef R__SIZEDDELETE
    static void           ObjectDealloc(void *vp, size_t size);
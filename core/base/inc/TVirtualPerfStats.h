@@ -64,6 +64,12 @@ public:
 
    virtual void UnzipEvent(TObject *tree, Long64_t pos, Double_t start, Int_t complen, Int_t objlen) = 0;
 
+   // A basket of branch, nbytes long on file, was read starting at time start and, if objlen
+   // is not zero, inflated to objlen bytes from time unzipStart on; fromUnzipCache tells that
+   // it was taken already inflated from the TTreeCacheUnzip, start being when it was requested.
+   virtual void BasketReadEvent(TBranch * /*branch*/, Int_t /*nbytes*/, Int_t /*objlen*/, Double_t /*start*/,
+                                Double_t /*unzipStart*/, Bool_t /*fromUnzipCache*/) {}
+
    virtual void RateEvent(Double_t proctime, Double_t deltatime,
                           Long64_t eventsprocessed, Long64_t bytesRead) = 0;
 
@@ -1025,6 +1025,15 @@ void TObject::operator delete[](void *ptr, size_t size)
 }
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+/// Only called by new (arena) when the constructor throws an exception: the
+/// memory is left to the arena.
+
+void TObject::operator delete(void *ptr, ROOT::TObjectArena &)
+{
+   TStorage::ObjectDealloc(ptr);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print value overload
 
@@ -0,0 +1,203 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TObjectArena.hxx"
+
+#include "TObject.h"
+#include "TObjectTable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace {
+
+/// The chunks of all the arenas alive, so that TStorage can tell whether an
+/// object was served by an arena when it is deleted, on any thread, without
+/// taking a lock. Each entry holds the address of a chunk, which is aligned
+/// to kChunkAlign, or'ed with the logarithm of its size, or 0 if unused.
+/// Only the registration and unregistration of chunks take gChunkMutex.
+const int kMaxChunks = 4096;
+const std::uintptr_t kChunkAlign = 64;
+std::atomic<std::uintptr_t> gChunkTable[kMaxChunks];
+/// One past the last used entry of gChunkTable.
+std::atomic<int> gChunkTableEnd{0};
+
+std::mutex &GetChunkMutex()
+{
+   // Never deleted: objects may be deleted while the static objects are being destroyed.
+   static auto mutex = new std::mutex;
+   return *mutex;
+}
+
+/// Add a chunk to the table and return its index, or -1 if the table is full.
+int RegisterChunk(const char *begin, std::size_t size)
+{
+   std::uintptr_t log2 = 0;
+   while ((std::size_t(1) << log2) < size)
+      ++log2;
+   const std::uintptr_t entry = reinterpret_cast<std::uintptr_t>(begin) | log2;
+
+   std::lock_guard<std::mutex> lock(GetChunkMutex());
+   for (int i = 0; i < kMaxChunks; ++i) {
+      if (!gChunkTable[i].load(std::memory_order_relaxed)) {
+         gChunkTable[i].store(entry, std::memory_order_release);
+         if (i >= gChunkTableEnd.load(std::memory_order_relaxed))
+            gChunkTableEnd.store(i + 1, std::memory_order_release);
+         return i;
+      }
+   }
+   return -1;
+}
+
+void UnregisterChunk(int slot)
+{
+   std::lock_guard<std::mutex> lock(GetChunkMutex());
+   gChunkTable[slot].store(0, std::memory_order_release);
+   int end = gChunkTableEnd.load(std::memory_order_relaxed);
+   while (end > 0 && !gChunkTable[end - 1].load(std::memory_order_relaxed))
+      --end;
+   gChunkTableEnd.store(end, std::memory_order_release);
+}
+
+/// Chunks grow geometrically up to this size.
+const std::size_t kMaxChunkSize = 32 * 1024 * 1024;
+
+/// The smallest power of two not smaller than size.
+std::size_t RoundUpToPowerOfTwo(std::size_t size)
+{
+   std::size_t power = 1;
+   while (power < size)
+      power *= 2;
+   return power;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create an arena. The first chunk of memory, of at least chunkSize bytes,
+/// is allocated on first use.
+
+ROOT::TObjectArena::TObjectArena(std::size_t chunkSize)
+   : fChunkSize(RoundUpToPowerOfTwo(std::max<std::size_t>(chunkSize, 1024)))
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reclaim the memory of the arena.
+
+ROOT::TObjectArena::~TObjectArena()
+{
+   Release();
+   FreeChunks(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start a new chunk, large enough for size bytes, and serve them from it.
+/// Return nullptr if the chunk cannot be registered, in which case the
+/// caller takes the memory from the heap.
+
+void *ROOT::TObjectArena::AllocateSlow(std::size_t size)
+{
+   const std::size_t chunkSize = std::max(fChunkSize, RoundUpToPowerOfTwo(size));
+   char *memory = static_cast<char *>(::operator new(chunkSize + kChunkAlign - 1));
+   char *begin = reinterpret_cast<char *>((reinterpret_cast<std::uintptr_t>(memory) + kChunkAlign - 1) &
+                                          ~(kChunkAlign - 1));
+   const int slot = RegisterChunk(begin, chunkSize);
+   if (slot < 0) {
+      ::operator delete(memory);
+      return nullptr;
+   }
+   fChunks.push_back({memory, begin, chunkSize, slot});
+   fChunkSize = std::min(2 * fChunkSize, kMaxChunkSize);
+   fCursor = begin + size;
+   fEnd = begin + chunkSize;
+   fAllocated += size;
+   return begin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Free all the chunks but the last keep ones.
+
+void ROOT::TObjectArena::FreeChunks(std::size_t keep)
+{
+   const std::size_t nfree = fChunks.size() - std::min(keep, fChunks.size());
+   for (std::size_t i = 0; i < nfree; ++i) {
+      UnregisterChunk(fChunks[i].fSlot);
+      ::operator delete(fChunks[i].fMemory);
+   }
+   fChunks.erase(fChunks.begin(), fChunks.begin() + nfree);
+   if (fChunks.empty()) {
+      fCursor = fEnd = nullptr;
+   } else {
+      fCursor = fChunks.back().fBegin;
+      fEnd = fCursor + fChunks.back().fSize;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if ptr points into the memory of this arena.
+
+bool ROOT::TObjectArena::Contains(const void *ptr) const
+{
+   const char *p = static_cast<const char *>(ptr);
+   // The most recent chunks are the most likely ones.
+   for (auto chunk = fChunks.rbegin(); chunk != fChunks.rend(); ++chunk) {
+      if (p >= chunk->fBegin && p < chunk->fBegin + chunk->fSize)
+         return true;
+   }
+   return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reclaim all the memory served by the arena. The objects still alive are
+/// not destroyed and must not be used anymore. The largest chunk is kept to
+/// serve the next objects.
+
+void ROOT::TObjectArena::Release()
+{
+   if (TObject::GetObjectStat() && gObjectTable) {
+      for (auto &chunk : fChunks)
+         gObjectTable->RemoveRange(chunk.fBegin, chunk.fBegin + chunk.fSize);
+   }
+   FreeChunks(1);
+   fAllocated = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Bytes of memory held by the arena.
+
+std::size_t ROOT::TObjectArena::GetCapacity() const
+{
+   std::size_t capacity = 0;
+   for (auto &chunk : fChunks)
+      capacity += chunk.fSize;
+   return capacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if ptr was served by an arena that is still alive, in which
+/// case its memory must not be freed. It does not take any lock, and costs a
+/// single atomic load when no arena holds memory.
+
+bool ROOT::TObjectArena::Owns(const void *ptr)
+{
+   const int end = gChunkTableEnd.load(std::memory_order_acquire);
+   const std::uintptr_t p = reinterpret_cast<std::uintptr_t>(ptr);
+   for (int i = 0; i < end; ++i) {
+      const std::uintptr_t entry = gChunkTable[i].load(std::memory_order_acquire);
+      const std::uintptr_t begin = entry & ~(kChunkAlign - 1);
+      if (entry && p - begin < (std::uintptr_t(1) << (entry & (kChunkAlign - 1))))
+         return true;
+   }
+   return false;
+}
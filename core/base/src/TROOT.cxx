@@ -154,6 +154,7 @@ FARPROC dlsym(void *library, const char *function_name)
 #include "TFunctionTemplate.h"
 #include "ThreadLocalStorage.h"
 #include "TVirtualRWMutex.h"
+#include "ROOT/TStartupProfile.hxx"
 
 #include <string>
 namespace std {} using namespace std;
@@ -696,6 +697,8 @@ TROOT::TROOT(const char *name, const char *title, VoidFuncPtr_t *initfunc)
       return;
    }
 
+   ROOT::Internal::TStartupTimer startupTimer("TROOT::TROOT");
+
    R__LOCKGUARD(gROOTMutex);
 
    ROOT::Internal::gROOTLocal = this;
@@ -1940,6 +1943,8 @@ Int_t TROOT::IgnoreInclude(const char *fname, const char * /*expandedfname*/)
 
 void TROOT::InitSystem()
 {
+   ROOT::Internal::TStartupTimer startupTimer("TROOT::InitSystem");
+
    if (gSystem == 0) {
 #if defined(R__UNIX)
 #if defined(R__HAS_COCOA)
@@ -2032,6 +2037,8 @@ void TROOT::InitThreads()
 
 void TROOT::InitInterpreter()
 {
+   ROOT::Internal::TStartupTimer startupTimer("TROOT::InitInterpreter");
+
    // usedToIdentifyRootClingByDlSym is available when TROOT is part of
    // rootcling.
    if (!dlsym(RTLD_DEFAULT, "usedToIdentifyRootClingByDlSym")
@@ -2052,6 +2059,7 @@ void TROOT::InitInterpreter()
                "after the call to TROOT::InitInterpreter()!");
       }
 
+      ROOT::Internal::TStartupTimer loadTimer("TROOT::InitInterpreter: load libCling");
       char *libRIO = gSystem->DynamicPathName("libRIO");
       void *libRIOHandle = dlopen(libRIO, RTLD_NOW|RTLD_GLOBAL);
       delete [] libRIO;
@@ -2137,11 +2145,15 @@ void TROOT::InitInterpreter()
    }
    GetModuleHeaderInfoBuffer().clear();
 
-   fInterpreter->Initialize();
+   {
+      ROOT::Internal::TStartupTimer initTimer("TCling::Initialize");
+      fInterpreter->Initialize();
+   }
 
    // Read the rules before enabling the auto loading to not inadvertently
    // load the libraries for the classes concerned even-though the user is
    // *not* using them.
+   ROOT::Internal::TStartupTimer rulesTimer("TClass::ReadRules");
    TClass::ReadRules(); // Read the default customization rules ...
 }
 
@@ -0,0 +1,98 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TStartupProfile.hxx"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+namespace {
+
+/// The phases recorded so far, in the order they were first entered.
+/// Allocated once and never deleted: phases may still be recorded, and the
+/// profile is printed, while the static objects are being destroyed.
+struct TStartupProfileData {
+   std::mutex fMutex;
+   std::vector<ROOT::Internal::TStartupPhase> fPhases;
+};
+
+TStartupProfileData &GetProfileData()
+{
+   static auto data = new TStartupProfileData;
+   return *data;
+}
+
+void PrintStartupProfileAtExit()
+{
+   ROOT::Internal::PrintStartupProfile();
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the environment variable ROOT_STARTUP_PROFILE is set to
+/// anything but 0. It is read directly from the environment, since the
+/// startup profile covers the time before gSystem and gEnv exist.
+
+bool ROOT::Internal::IsStartupProfileEnabled()
+{
+   static const bool enabled = [] {
+      const char *value = ::getenv("ROOT_STARTUP_PROFILE");
+      return value && *value && strcmp(value, "0") != 0;
+   }();
+   return enabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add seconds to the time spent in phase. The first time something is
+/// recorded, the printing of the profile at exit is scheduled.
+
+void ROOT::Internal::AddStartupTime(const char *phase, double seconds)
+{
+   auto &data = GetProfileData();
+   std::lock_guard<std::mutex> lock(data.fMutex);
+   if (data.fPhases.empty())
+      atexit(PrintStartupProfileAtExit);
+   for (auto &p : data.fPhases) {
+      if (p.fName == phase) {
+         p.fSeconds += seconds;
+         ++p.fCount;
+         return;
+      }
+   }
+   data.fPhases.push_back({phase, seconds, 1});
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a copy of the phases recorded so far, in the order they were first
+/// entered.
+
+std::vector<ROOT::Internal::TStartupPhase> ROOT::Internal::GetStartupProfile()
+{
+   auto &data = GetProfileData();
+   std::lock_guard<std::mutex> lock(data.fMutex);
+   return data.fPhases;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the startup profile on stderr.
+
+void ROOT::Internal::PrintStartupProfile()
+{
+   const auto phases = GetStartupProfile();
+   if (phases.empty())
+      return;
+   fprintf(stderr, "ROOT startup profile:\n");
+   fprintf(stderr, "  %-40s %12s %8s\n", "phase", "time [ms]", "calls");
+   for (auto &p : phases)
+      fprintf(stderr, "  %-40s %12.3f %8u\n", p.fName.c_str(), 1000. * p.fSeconds, p.fCount);
+}
@@ -38,6 +38,7 @@ and statistics gathering in the system.
 #include "TString.h"
 #include "TVirtualMutex.h"
 #include "TInterpreter.h"
+#include "ROOT/TObjectArena.hxx"
 
 #if !defined(R__NOSTATS)
 #   define MEM_DEBUG
@@ -332,6 +333,20 @@ void *TStorage::ObjectAlloc(size_t sz)
    return space;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Used to allocate a TObject in a ROOT::TObjectArena (via
+/// TObject::operator new(size_t,ROOT::TObjectArena&)). The memory is taken
+/// from the heap if the arena cannot grow anymore.
+
+void *TStorage::ObjectAlloc(size_t sz, ROOT::TObjectArena &arena)
+{
+   void* space = arena.Allocate(sz);
+   if (!space)
+      space = ::operator new(sz);
+   memset(space, kObjectAllocMemValue, sz);
+   return space;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Used to allocate array of TObject on the heap (via TObject::operator new[]()).
 /// Unlike the 'singular' ObjectAlloc, we do not mark those object has being
@@ -358,7 +373,9 @@ void *TStorage::ObjectAlloc(size_t , void *vp)
 
 void TStorage::ObjectDealloc(void *vp)
 {
-
+   // The memory of the objects served by an arena is reclaimed by the arena.
+   if (R__unlikely(ROOT::TObjectArena::Owns(vp)))
+      return;
    ::operator delete(vp);
 }
 
@@ -377,6 +394,8 @@ void TStorage::ObjectDealloc(void *vp, void *ptr)
 
 void TStorage::ObjectDealloc(void *vp, size_t size)
 {
+   if (R__unlikely(ROOT::TObjectArena::Owns(vp)))
+      return;
    ::operator delete(vp, size);
 }
 #endif
@@ -0,0 +1,100 @@
+#include "TList.h"
+#include "TNamed.h"
+#include "TObjectTable.h"
+#include "TObjString.h"
+
+#include "ROOT/TObjectArena.hxx"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <stdexcept>
+
+TEST(TObjectArena, Allocation)
+{
+   std::unique_ptr<TObjString> outside(new TObjString("outside"));
+
+   ROOT::TObjectArena arena;
+   EXPECT_FALSE(ROOT::TObjectArena::Owns(outside.get()));
+
+   auto str = new (arena) TObjString("a");
+   EXPECT_TRUE(arena.Contains(str));
+   EXPECT_TRUE(ROOT::TObjectArena::Owns(str));
+   EXPECT_TRUE(str->IsOnHeap());
+   EXPECT_STREQ("a", str->GetName());
+   delete str;
+
+   // Only the objects created in the arena are served by it.
+   std::unique_ptr<TNamed> plain(new TNamed("plain", ""));
+   EXPECT_FALSE(arena.Contains(plain.get()));
+   EXPECT_FALSE(ROOT::TObjectArena::Owns(plain.get()));
+
+   // Owning collections delete the objects as usual.
+   TList list;
+   list.SetOwner();
+   for (Int_t i = 0; i < 10000; ++i)
+      list.Add(new (arena) TNamed("n", "t"));
+   EXPECT_TRUE(arena.Contains(list.Last()));
+   EXPECT_GE(arena.GetAllocated(), 10000 * sizeof(TNamed));
+   list.Delete();
+
+   const auto capacity = arena.GetCapacity();
+   arena.Release();
+   EXPECT_EQ(0u, arena.GetAllocated());
+   EXPECT_GT(capacity, arena.GetCapacity());
+   EXPECT_LT(0u, arena.GetCapacity());
+}
+
+TEST(TObjectArena, SeveralArenas)
+{
+   auto outer = std::make_unique<ROOT::TObjectArena>();
+   auto a = new (*outer) TNamed("a", "");
+   {
+      ROOT::TObjectArena inner;
+      auto b = new (inner) TNamed("b", "");
+      EXPECT_TRUE(inner.Contains(b));
+      EXPECT_FALSE(outer->Contains(b));
+      EXPECT_TRUE(ROOT::TObjectArena::Owns(a));
+      EXPECT_TRUE(ROOT::TObjectArena::Owns(b));
+      delete a;
+      delete b;
+   }
+   auto c = new (*outer) TNamed("c", "");
+   EXPECT_TRUE(outer->Contains(c));
+   delete c;
+   outer.reset();
+   // The memory of the arenas is gone.
+   EXPECT_FALSE(ROOT::TObjectArena::Owns(c));
+}
+
+namespace {
+class TThrowing : public TNamed {
+public:
+   TThrowing() { throw std::runtime_error("TThrowing"); }
+};
+} // namespace
+
+TEST(TObjectArena, ThrowingConstructor)
+{
+   ROOT::TObjectArena arena;
+   EXPECT_THROW(new (arena) TThrowing, std::runtime_error);
+   auto n = new (arena) TNamed("n", "");
+   EXPECT_TRUE(arena.Contains(n));
+   delete n;
+}
+
+TEST(TObjectArena, ObjectTable)
+{
+   const Bool_t objectStat = TObject::GetObjectStat();
+   TObject::SetObjectStat(kTRUE);
+   {
+      ROOT::TObjectArena arena;
+      auto leaked = new (arena) TNamed("leaked", "");
+      ASSERT_NE(nullptr, gObjectTable);
+      EXPECT_TRUE(gObjectTable->PtrIsValid(leaked));
+      arena.Release();
+      // The objects left in the arena are gone from the table of objects.
+      EXPECT_FALSE(gObjectTable->PtrIsValid(leaked));
+   }
+   TObject::SetObjectStat(objectStat);
+}
@@ -0,0 +1,49 @@
+#include "ROOT/TStartupProfile.hxx"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+using ROOT::Internal::TStartupPhase;
+
+static const TStartupPhase *FindPhase(const std::vector<TStartupPhase> &phases, const char *name)
+{
+   auto it = std::find_if(phases.begin(), phases.end(), [name](const TStartupPhase &p) { return p.fName == name; });
+   return it == phases.end() ? nullptr : &*it;
+}
+
+TEST(TStartupProfile, AddStartupTime)
+{
+   ROOT::Internal::AddStartupTime("TStartupProfileTests::A", 0.25);
+   ROOT::Internal::AddStartupTime("TStartupProfileTests::B", 1.);
+   ROOT::Internal::AddStartupTime("TStartupProfileTests::A", 0.5);
+
+   const auto phases = ROOT::Internal::GetStartupProfile();
+   auto a = FindPhase(phases, "TStartupProfileTests::A");
+   auto b = FindPhase(phases, "TStartupProfileTests::B");
+   ASSERT_NE(nullptr, a);
+   ASSERT_NE(nullptr, b);
+   EXPECT_DOUBLE_EQ(0.75, a->fSeconds);
+   EXPECT_EQ(2u, a->fCount);
+   EXPECT_DOUBLE_EQ(1., b->fSeconds);
+   EXPECT_EQ(1u, b->fCount);
+   // The phases are kept in the order they were first entered.
+   EXPECT_LT(a, b);
+}
+
+TEST(TStartupProfile, Timer)
+{
+   {
+      ROOT::Internal::TStartupTimer timer("TStartupProfileTests::Timer");
+   }
+   // The timers only record something when ROOT_STARTUP_PROFILE is set.
+   const auto phases = ROOT::Internal::GetStartupProfile();
+   auto timer = FindPhase(phases, "TStartupProfileTests::Timer");
+   if (ROOT::Internal::IsStartupProfileEnabled()) {
+      ASSERT_NE(nullptr, timer);
+      EXPECT_EQ(1u, timer->fCount);
+      EXPECT_LE(0., timer->fSeconds);
+   } else {
+      EXPECT_EQ(nullptr, timer);
+   }
+}
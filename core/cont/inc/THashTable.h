@@ -20,7 +20,8 @@
 // THashTable implements a hash table to store TObject's. The hash      //
 // value is calculated using the value returned by the TObject's        //
 // Hash() function. Each class inheriting from TObject can override     //
-// Hash() as it sees fit.                                               //
+// Hash() as it sees fit. The objects are stored by open addressing,    //
+// together with their hash value.                                      //
 //                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
@@ -28,7 +29,6 @@
 #include "TString.h"
 
 class TList;
-class TListIter;
 class THashTableIter;
 
 
@@ -37,20 +37,36 @@ class THashTable : public TCollection {
 friend class  THashTableIter;
 
 private:
-   TList     **fCont;          //Hash table (table of lists)
+   struct TSlot;
+   struct TBucketViews;
+
+   signed char *fCtrl;         //Control byte of each slot: empty, deleted or 7 bits of the hash
+   TSlot      *fSlots;         //Objects stored in the slots, with their hash value
    Int_t       fEntries;       //Number of objects in table
-   Int_t       fUsedSlots;     //Number of used slots
+   Int_t       fDeleted;       //Number of slots freed by a removal but still in probe sequences
+   Long64_t    fProbes;        //Number of slot groups probed to reach each of the objects, summed
+   Long64_t    fNextOrder;     //Insertion rank of the next object added
    Int_t       fRehashLevel;   //Average collision rate which triggers rehash
-
-   Int_t       GetCheckedHashValue(TObject *obj) const;
-   Int_t       GetHashValue(const TObject *obj) const;
-   Int_t       GetHashValue(TString &s) const { return s.Hash() % fSize; }
-   Int_t       GetHashValue(const char *str) const { return ::Hash(str) % fSize; }
-
-   void        AddImpl(Int_t slot, TObject *object);
-
-   THashTable(const THashTable&);             // not implemented
-   THashTable& operator=(const THashTable&);  // not implemented
+   mutable TBucketViews *fViews; //!Lists handed out by GetListForObject(), built lazily by the const lookups
+
+   ULong_t     GetCheckedHashValue(TObject *obj) const { return obj->CheckedHash(); }
+   ULong_t     GetHashValue(const TObject *obj) const { return obj->Hash(); }
+   ULong_t     GetHashValue(TString &s) const { return s.Hash(); }
+   ULong_t     GetHashValue(const char *str) const { return ::Hash(str); }
+
+   void        AddImpl(ULong_t hash, TObject *object, Long64_t order);
+   void        AllocateSlots(Int_t nslots);
+   void        EraseSlot(Int_t slot);
+   const TList *GetListForHash(ULong_t hash) const;
+   Int_t       InsertSlot(ULong_t hash);
+   Int_t       ProbeLength(Int_t slot) const;
+   void        ReserveSlot();
+   void        Resize(Int_t nslots, Bool_t checkObjValidity);
+   void        ResetSlots();
+   TList      *TakeObjects();
+
+   template <typename Func> void  ForEachSlot(ULong_t hash, Func &&func) const;
+   template <typename Match> Int_t FindSlot(ULong_t hash, Match &&match) const;
 
 public:
    THashTable(Int_t capacity = TCollection::kInitHashTableCapacity, Int_t rehash = 0);
@@ -83,24 +99,12 @@ public:
 
 inline Float_t THashTable::AverageCollisions() const
 {
-   if (fUsedSlots)
-      return ((Float_t)fEntries)/((Float_t)fUsedSlots);
+   if (fEntries)
+      return ((Float_t)fProbes)/((Float_t)fEntries);
    else
       return 0.0;
 }
 
-inline Int_t THashTable::GetCheckedHashValue(TObject *obj) const
-{
-   Int_t i = Int_t(obj->CheckedHash() % fSize); // need intermediary i for Linux g++
-   return i;
-}
-
-inline Int_t THashTable::GetHashValue(const TObject *obj) const
-{
-   Int_t i = Int_t(obj->Hash() % fSize);  // need intermediary i for Linux g++
-   return i;
-}
-
 
 //////////////////////////////////////////////////////////////////////////
 //                                                                      //
@@ -114,17 +118,15 @@ class THashTableIter : public TIterator {
 
 private:
    const THashTable *fTable;       //hash table being iterated
-   Int_t             fCursor;      //current position in table
-   TListIter        *fListCursor;  //current position in collision list
+   Int_t             fCursor;      //next slot to look at
+   Int_t             fCurrent;     //slot of the object last returned by Next(), -1 if none
    Bool_t            fDirection;   //iteration direction
 
-   THashTableIter() : fTable(0), fCursor(0), fListCursor(0), fDirection(kIterForward) { }
-   Int_t             NextSlot();
+   THashTableIter() : fTable(0), fCursor(0), fCurrent(-1), fDirection(kIterForward) { }
 
 public:
    THashTableIter(const THashTable *ht, Bool_t dir = kIterForward);
    THashTableIter(const THashTableIter &iter);
-   ~THashTableIter();
    TIterator      &operator=(const TIterator &rhs);
    THashTableIter &operator=(const THashTableIter &rhs);
 
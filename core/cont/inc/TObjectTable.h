@@ -62,6 +62,7 @@ public:
    Bool_t    PtrIsValid(TObject *obj);
    void      Remove(TObject *obj);
    void      RemoveQuietly(TObject *obj);
+   void      RemoveRange(const void *begin, const void *end);
    void      Statistics() { Print(); }
    void      Terminate();
    void      UpdateInstCount() const;
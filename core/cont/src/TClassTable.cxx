@@ -31,6 +31,7 @@ initialized when the program starts (see the ClassImp macro).
 #include "TMap.h"
 
 #include "TInterpreter.h"
+#include "ROOT/TStartupProfile.hxx"
 
 #include <map>
 #include <memory>
@@ -345,6 +346,8 @@ void TClassTable::Add(const char *cname, Version_t id,  const std::type_info &in
    if (!gClassTable)
       new TClassTable;
 
+   ROOT::Internal::TStartupTimer startupTimer("TClassTable::Add");
+
    if (!cname || *cname == 0)
       ::Fatal("TClassTable::Add()", "Failed to deduce type for '%s'", info.name());
 
@@ -398,6 +401,8 @@ void TClassTable::Add(TProtoClass *proto)
    if (!gClassTable)
       new TClassTable;
 
+   ROOT::Internal::TStartupTimer startupTimer("TClassTable::Add");
+
    // By definition the name in the TProtoClass is (must be) the normalized
    // name, so there is no need to tweak it.
    const char *cname = proto->GetName();
@@ -437,6 +442,8 @@ void TClassTable::AddAlternate(const char *normName, const char *alternate)
    if (!gClassTable)
       new TClassTable;
 
+   ROOT::Internal::TStartupTimer startupTimer("TClassTable::AddAlternate");
+
    UInt_t slot = ROOT::ClassTableHash(alternate, fgSize);
 
    for (const TClassAlt *a = fgAlternate[slot]; a; a = a->fNext.get()) {
@@ -16,9 +16,18 @@ value is calculated using the value returned by the TObject's
 Hash() function. Each class inheriting from TObject can override
 Hash() as it sees fit.
 
+The objects are stored by open addressing: each slot holds an object
+together with its full hash value, and one control byte per slot holds
+7 bits of the (mixed) hash. Lookups compare the control bytes of a group
+of 16 slots at once (with SSE2 when available) and only look at the
+objects whose control byte and stored hash value match. The table grows
+automatically when it gets 7/8 full.
+
 THashTable does not preserve the insertion order of the objects.
 If the insertion order is important AND fast retrieval is needed
-use THashList instead.
+use THashList instead. Objects with the same hash value are however
+kept in the order they were added in: FindObject() returns the first
+one matching, and GetListForObject() lists them in that order.
 */
 
 #include "THashTable.h"
@@ -27,18 +36,169 @@ use THashList instead.
 #include "TError.h"
 #include "TROOT.h"
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define R__HASHTABLE_SSE2
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// An object stored in the table.
+
+struct THashTable::TSlot {
+   TObject  *fObject;  ///< The object
+   ULong_t   fHash;    ///< Value returned by its Hash() when it was added
+   Long64_t  fOrder;   ///< Rank used to order the objects with the same hash value
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// The lists returned by GetListForObject(), by hash value. Once created, a
+/// list is kept up to date until it gets empty or the table is cleared, so
+/// that callers can hold on to it as they could to a bucket of the former
+/// chained table; as these buckets, the lists are deleted when they get
+/// empty, so there are never more lists than objects in the table.
+
+struct THashTable::TBucketViews {
+   std::unordered_map<ULong_t, std::unique_ptr<TList>> fLists;
+
+   TList *Find(ULong_t hash) const
+   {
+      auto iter = fLists.find(hash);
+      return iter == fLists.end() ? nullptr : iter->second.get();
+   }
+
+   void Remove(ULong_t hash, TObject *obj)
+   {
+      auto iter = fLists.find(hash);
+      if (iter == fLists.end()) return;
+      TList *list = iter->second.get();
+      for (TObjLink *lnk = list->FirstLink(); lnk; lnk = lnk->Next()) {
+         if (lnk->GetObject() == obj) {
+            list->Remove(lnk);
+            break;
+         }
+      }
+      if (list->IsEmpty())
+         fLists.erase(iter);
+   }
+};
+
+namespace {
+
+/// Number of slots whose control bytes are matched at once.
+constexpr Int_t kGroupSize = 16;
+/// Control byte of a slot that never held an object; probing stops in its group.
+constexpr signed char kEmpty = -128;
+/// Control byte of a slot whose object was removed; probing goes on past it.
+constexpr signed char kDeleted = -2;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Spread the bits of a hash value. TObject::Hash() of an unnamed object is
+/// its address, whose low bits are mostly the same for all objects.
+
+inline ULong64_t MixHash(ULong_t hash)
+{
+   ULong64_t mixed = (ULong64_t)hash * 0x9E3779B97F4A7C15ULL;
+   return mixed ^ (mixed >> 32);
+}
+
+/// The 7 bits of the mixed hash kept in the control byte.
+inline signed char ControlByte(ULong64_t mixed)
+{
+   return (signed char)(mixed & 0x7F);
+}
+
+/// The first group probed for a mixed hash.
+inline Int_t FirstGroup(ULong64_t mixed, Int_t groupMask)
+{
+   return (Int_t)((mixed >> 7) & (ULong64_t)groupMask);
+}
+
+/// Index of the lowest bit set in a non zero mask.
+inline Int_t LowestBit(UInt_t bits)
+{
+#ifdef _MSC_VER
+   unsigned long index;
+   _BitScanForward(&index, bits);
+   return (Int_t)index;
+#else
+   return __builtin_ctz(bits);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Smallest number of slots holding capacity objects without growing.
+
+Int_t SlotsFor(Int_t capacity)
+{
+   Int_t nslots = kGroupSize;
+   while (nslots / 8 * 7 < capacity && nslots < (1 << 30))
+      nslots *= 2;
+   return nslots;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The control bytes of a group of slots; each Match function returns a mask
+/// with bit i set if the i-th slot of the group matches.
+
+class TGroup {
+#ifdef R__HASHTABLE_SSE2
+   __m128i fCtrl;
+
+public:
+   explicit TGroup(const signed char *ctrl) : fCtrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) {}
+
+   UInt_t Match(signed char c) const { return _mm_movemask_epi8(_mm_cmpeq_epi8(fCtrl, _mm_set1_epi8(c))); }
+   UInt_t MatchEmpty() const { return Match(kEmpty); }
+   UInt_t MatchFree() const { return _mm_movemask_epi8(fCtrl); }
+#else
+   const signed char *fCtrl;
+
+public:
+   explicit TGroup(const signed char *ctrl) : fCtrl(ctrl) {}
+
+   UInt_t Match(signed char c) const
+   {
+      UInt_t bits = 0;
+      for (Int_t i = 0; i < kGroupSize; ++i)
+         bits |= UInt_t(fCtrl[i] == c) << i;
+      return bits;
+   }
+   UInt_t MatchEmpty() const { return Match(kEmpty); }
+   UInt_t MatchFree() const
+   {
+      UInt_t bits = 0;
+      for (Int_t i = 0; i < kGroupSize; ++i)
+         bits |= UInt_t(fCtrl[i] < 0) << i;
+      return bits;
+   }
+#endif
+};
+
+} // anonymous namespace
+
 ClassImp(THashTable);
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Create a THashTable object. Capacity is the initial hashtable capacity
-/// (i.e. number of slots), by default kInitHashTableCapacity = 17, and
-/// rehashlevel is the value at which a rehash will be triggered. I.e. when
-/// the average size of the linked lists at a slot becomes longer than
-/// rehashlevel then the hashtable will be resized and refilled to reduce
-/// the collision rate to about 1. The higher the collision rate, i.e. the
-/// longer the linked lists, the longer lookup will take. If rehashlevel=0
-/// the table will NOT automatically be rehashed. Use Rehash() for manual
-/// rehashing.
+/// Create a THashTable object. Capacity is the number of objects the table
+/// can hold before it has to grow, by default kInitHashTableCapacity = 17;
+/// the slots are only allocated when the first object is added. The table
+/// grows automatically when it gets 7/8 full. Rehashlevel is the average
+/// number of slot groups probed to reach an object above which the table is
+/// rehashed in addition (this only happens with poor hash functions or after
+/// many removals). If rehashlevel=0 the table will only be rehashed when it
+/// grows: unlike the table of lists used up to ROOT 6.18, which never grew
+/// by itself with rehashlevel=0, an open addressing table must grow when it
+/// gets full. Use Rehash() for manual rehashing.
 
 THashTable::THashTable(Int_t capacity, Int_t rehashlevel)
 {
@@ -48,12 +208,15 @@ THashTable::THashTable(Int_t capacity, Int_t rehashlevel)
    } else if (capacity == 0)
       capacity = TCollection::kInitHashTableCapacity;
 
-   fSize = (Int_t)TMath::NextPrime(TMath::Max(capacity,(int)TCollection::kInitHashTableCapacity));
-   fCont = new TList* [fSize];
-   memset(fCont, 0, fSize*sizeof(TList*));
+   fSize = SlotsFor(capacity);
+   fCtrl  = 0;
+   fSlots = 0;
+   fViews = 0;
 
    fEntries   = 0;
-   fUsedSlots = 0;
+   fDeleted   = 0;
+   fProbes    = 0;
+   fNextOrder = 0;
    if (rehashlevel < 2) rehashlevel = 0;
    fRehashLevel = rehashlevel;
 }
@@ -64,25 +227,199 @@ THashTable::THashTable(Int_t capacity, Int_t rehashlevel)
 
 THashTable::~THashTable()
 {
-   if (fCont) Clear();
-   delete [] fCont;
-   fCont = 0;
-   fSize = 0;
+   if (fEntries) Clear();
+   delete [] fCtrl;
+   delete [] fSlots;
+   delete fViews;
+   fCtrl  = 0;
+   fSlots = 0;
+   fViews = 0;
+   fSize  = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Helper function doing the actual add to the table give a slot and object.
+/// Call func for each slot holding an object with the given hash value, in
+/// probing order. This does not take any lock.
+
+template <typename Func>
+void THashTable::ForEachSlot(ULong_t hash, Func &&func) const
+{
+   if (!fCtrl) return;
+
+   const ULong64_t mixed = MixHash(hash);
+   const signed char ctrl = ControlByte(mixed);
+   const Int_t groupMask = fSize / kGroupSize - 1;
+   for (Int_t group = FirstGroup(mixed, groupMask), step = 0;; group = (group + ++step) & groupMask) {
+      const Int_t first = group * kGroupSize;
+      const TGroup bytes(fCtrl + first);
+      for (UInt_t bits = bytes.Match(ctrl); bits; bits &= bits - 1) {
+         const Int_t slot = first + LowestBit(bits);
+         if (fSlots[slot].fHash == hash)
+            func(slot);
+      }
+      // The table is never full, so every probe sequence reaches an empty slot.
+      if (bytes.MatchEmpty())
+         return;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the slot of the first added object with the given hash value for
+/// which match(object) is true, or -1. This does not take any lock.
+
+template <typename Match>
+Int_t THashTable::FindSlot(ULong_t hash, Match &&match) const
+{
+   Int_t found = -1;
+   ForEachSlot(hash, [&](Int_t slot) {
+      if ((found == -1 || fSlots[slot].fOrder < fSlots[found].fOrder) && match(fSlots[slot].fObject))
+         found = slot;
+   });
+   return found;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate nslots empty slots, dropping the current ones.
+
+void THashTable::AllocateSlots(Int_t nslots)
+{
+   fSize  = nslots;
+   fCtrl  = new signed char[nslots];
+   fSlots = new TSlot[nslots];
+   ResetSlots();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Mark all the slots as empty.
+
+void THashTable::ResetSlots()
+{
+   if (fCtrl) memset(fCtrl, kEmpty, fSize);
+   fEntries = 0;
+   fDeleted = 0;
+   fProbes  = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make sure there is room for one more object, growing the table if needed.
+
+void THashTable::ReserveSlot()
+{
+   if (!fCtrl)
+      AllocateSlots(fSize);
+   else if (8 * (Long64_t(fEntries) + fDeleted + 1) > 7 * Long64_t(fSize))
+      Resize(SlotsFor(2 * (fEntries + 1)), kFALSE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Claim a free slot for an object with the given hash value and return it.
+/// There must be room in the table (see ReserveSlot()).
+
+Int_t THashTable::InsertSlot(ULong_t hash)
+{
+   const ULong64_t mixed = MixHash(hash);
+   const Int_t groupMask = fSize / kGroupSize - 1;
+   for (Int_t group = FirstGroup(mixed, groupMask), step = 0;; group = (group + ++step) & groupMask) {
+      const Int_t first = group * kGroupSize;
+      if (UInt_t bits = TGroup(fCtrl + first).MatchFree()) {
+         const Int_t slot = first + LowestBit(bits);
+         if (fCtrl[slot] == kDeleted)
+            --fDeleted;
+         fCtrl[slot] = ControlByte(mixed);
+         fSlots[slot].fHash = hash;
+         fProbes += step + 1;
+         ++fEntries;
+         return slot;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of groups probed to reach the object in slot.
+
+Int_t THashTable::ProbeLength(Int_t slot) const
+{
+   const Int_t groupMask = fSize / kGroupSize - 1;
+   Int_t group = FirstGroup(MixHash(fSlots[slot].fHash), groupMask);
+   Int_t length = 1;
+   for (Int_t step = 0; group != slot / kGroupSize; ++length)
+      group = (group + ++step) & groupMask;
+   return length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Free a slot. If its group still has an empty slot, probing stops in that
+/// group anyway and the slot can be marked empty; otherwise it must be marked
+/// deleted so that probing goes on past it.
+
+void THashTable::EraseSlot(Int_t slot)
+{
+   fProbes -= ProbeLength(slot);
+   if (TGroup(fCtrl + slot / kGroupSize * kGroupSize).MatchEmpty()) {
+      fCtrl[slot] = kEmpty;
+   } else {
+      fCtrl[slot] = kDeleted;
+      ++fDeleted;
+   }
+   fSlots[slot].fObject = 0;
+   --fEntries;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move the objects to nslots new slots. Objects not valid anymore are
+/// dropped if checkObjValidity is true (see Rehash()).
+
+void THashTable::Resize(Int_t nslots, Bool_t checkObjValidity)
+{
+   signed char *oldCtrl  = fCtrl;
+   TSlot  *oldSlots = fSlots;
+   Int_t   oldSize  = fSize;
+
+   Bool_t check = checkObjValidity && TObject::GetObjectStat() && gObjectTable;
+
+   AllocateSlots(nslots);
+   if (!oldCtrl) return;
+
+   for (Int_t i = 0; i < oldSize; i++) {
+      if (oldCtrl[i] < 0) continue;
+      const TSlot &old = oldSlots[i];
+      if (check && !gObjectTable->PtrIsValid(old.fObject)) {
+         if (fViews) fViews->Remove(old.fHash, old.fObject);
+         continue;
+      }
+      fSlots[InsertSlot(old.fHash)] = old;
+   }
+
+   delete [] oldCtrl;
+   delete [] oldSlots;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove all the objects from the slots and return them in a new list.
+
+TList *THashTable::TakeObjects()
+{
+   TList *objects = new TList;
+   if (fCtrl) {
+      for (Int_t i = 0; i < fSize; i++)
+         if (fCtrl[i] >= 0) objects->Add(fSlots[i].fObject);
+   }
+   ResetSlots();
+   return objects;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Helper function doing the actual add to the table given the object's
+/// hash value and its rank among the objects with the same hash value.
 /// This does not take any lock.
 
 inline
-void THashTable::AddImpl(Int_t slot, TObject *obj)
+void THashTable::AddImpl(ULong_t hash, TObject *obj, Long64_t order)
 {
-   if (!fCont[slot]) {
-      fCont[slot] = new TList;
-      ++fUsedSlots;
-   }
-   fCont[slot]->Add(obj);
-   ++fEntries;
+   ReserveSlot();
+   const Int_t slot = InsertSlot(hash);
+   fSlots[slot].fObject = obj;
+   fSlots[slot].fOrder  = order;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -93,11 +430,13 @@ void THashTable::Add(TObject *obj)
 {
    if (IsArgNull("Add", obj)) return;
 
-   Int_t slot = GetCheckedHashValue(obj);
+   ULong_t hash = GetCheckedHashValue(obj);
 
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
-   AddImpl(slot,obj);
+   AddImpl(hash, obj, fNextOrder++);
+   if (fViews)
+      if (TList *view = fViews->Find(hash)) view->Add(obj);
 
    if (fRehashLevel && AverageCollisions() > fRehashLevel)
       Rehash(fEntries);
@@ -106,26 +445,45 @@ void THashTable::Add(TObject *obj)
 ////////////////////////////////////////////////////////////////////////////////
 /// Add object to the hash table. Its position in the table will be
 /// determined by the value returned by its Hash() function.
-/// If and only if 'before' is in the same bucket as obj, obj is added
-/// in front of 'before' within the bucket's list.
+/// If and only if 'before' has the same hash value as obj, obj is placed
+/// in front of 'before' among the objects with that hash value (see
+/// FindObject() and GetListForObject()).
 
 void THashTable::AddBefore(const TObject *before, TObject *obj)
 {
    if (IsArgNull("Add", obj)) return;
 
-   Int_t slot = GetCheckedHashValue(obj);
+   ULong_t hash = GetCheckedHashValue(obj);
 
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
-   if (!fCont[slot]) {
-      fCont[slot] = new TList;
-      fUsedSlots++;
-   }
-   if (before && GetHashValue(before) == slot) {
-      fCont[slot]->AddBefore(before,obj);
+
+   Int_t beforeSlot = -1;
+   if (before && GetHashValue(before) == hash)
+      beforeSlot = FindSlot(hash, [before](TObject *ob) { return ob->IsEqual(before); });
+
+   Long64_t order;
+   if (beforeSlot != -1) {
+      // Give obj the next rank, then re-rank 'before' and the objects that
+      // came after it so that they now come after obj.
+      const Long64_t beforeOrder = fSlots[beforeSlot].fOrder;
+      std::vector<TSlot *> after;
+      ForEachSlot(hash, [&](Int_t slot) {
+         if (fSlots[slot].fOrder >= beforeOrder) after.push_back(&fSlots[slot]);
+      });
+      std::sort(after.begin(), after.end(), [](const TSlot *a, const TSlot *b) { return a->fOrder < b->fOrder; });
+      order = fNextOrder++;
+      for (auto s : after) s->fOrder = fNextOrder++;
    } else {
-      fCont[slot]->Add(obj);
+      order = fNextOrder++;
+   }
+
+   AddImpl(hash, obj, order);
+   if (fViews) {
+      if (TList *view = fViews->Find(hash)) {
+         if (beforeSlot != -1) view->AddBefore(before, obj);
+         else view->Add(obj);
+      }
    }
-   fEntries++;
 
    if (fRehashLevel && AverageCollisions() > fRehashLevel)
       Rehash(fEntries);
@@ -139,25 +497,13 @@ void THashTable::AddAll(const TCollection *col)
 {
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
-   // Hashing after AddAll can be much more expensive than
-   // hashing before, as we need to add more elements.
-   // We assume an ideal hash, i.e. fUsedSlots==fSize.
-   Int_t sumEntries=fEntries+col->GetEntries();
-   Bool_t rehashBefore=fRehashLevel && (sumEntries > fSize*fRehashLevel);
-   if (rehashBefore)
-      Rehash(sumEntries);
-
-   // prevent Add from Rehashing
-   Int_t saveRehashLevel=fRehashLevel;
-   fRehashLevel=0;
+   // Growing before adding is cheaper than growing repeatedly
+   // while adding.
+   Int_t sumEntries = fEntries + col->GetEntries();
+   if (!fCtrl || 8 * (Long64_t(sumEntries) + fDeleted) > 7 * Long64_t(fSize))
+      Resize(std::max(fSize, SlotsFor(sumEntries)), kFALSE);
 
    TCollection::AddAll(col);
-
-   fRehashLevel=saveRehashLevel;
-   // If we didn't Rehash before, we might have to do it
-   // now, due to a non-perfect hash function.
-   if (!rehashBefore && fRehashLevel && AverageCollisions() > fRehashLevel)
-      Rehash(fEntries);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -168,50 +514,61 @@ void THashTable::Clear(Option_t *option)
 {
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
-   for (int i = 0; i < fSize; i++) {
-      // option "nodelete" is passed when Clear is called from
-      // THashList::Clear() or THashList::Delete() or Rehash().
-      if (fCont[i]) {
-         if (IsOwner())
-            fCont[i]->SetOwner();
-         fCont[i]->Clear(option);
-      }
-      SafeDelete(fCont[i]);
+   SafeDelete(fViews);
+
+   // option "nodelete" is passed when Clear is called from
+   // THashList::Clear() or THashList::Delete() or Rehash().
+   Bool_t nodel = option && !strcmp(option, "nodelete");
+   Bool_t candelete = !nodel && IsOwner();
+   for (Int_t i = 0; !nodel && !candelete && fCtrl && i < fSize; i++)
+      if (fCtrl[i] >= 0 && fSlots[i].fObject->TestBit(kCanDelete)) candelete = kTRUE;
+
+   if (!candelete) {
+      ResetSlots();
+      return;
    }
 
-   fEntries   = 0;
-   fUsedSlots = 0;
+   // Let TList::Clear() decide which objects to delete; the table is
+   // already empty when they are.
+   TList *objects = TakeObjects();
+   if (IsOwner())
+      objects->SetOwner();
+   objects->Clear(option);
+   delete objects;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of collisions for an object with a certain name
-/// (i.e. number of objects in same slot in the hash table, i.e. length
-/// of linked list).
+/// (i.e. number of objects with the same hash value, i.e. length of
+/// the list returned by GetListForObject()).
 
 Int_t THashTable::Collisions(const char *name) const
 {
-   Int_t slot = GetHashValue(name);
+   ULong_t hash = GetHashValue(name);
 
    R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
-   if (fCont[slot]) return fCont[slot]->GetSize();
-   return 0;
+   Int_t n = 0;
+   ForEachSlot(hash, [&n](Int_t) { ++n; });
+   return n;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of collisions for an object (i.e. number of objects
-/// in same slot in the hash table, i.e. length of linked list).
+/// with the same hash value, i.e. length of the list returned by
+/// GetListForObject()).
 
 Int_t THashTable::Collisions(TObject *obj) const
 {
    if (IsArgNull("Collisions", obj)) return 0;
 
-   Int_t slot = GetHashValue(obj);
+   ULong_t hash = GetHashValue(obj);
 
    R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
-   if (fCont[slot]) return fCont[slot]->GetSize();
-   return 0;
+   Int_t n = 0;
+   ForEachSlot(hash, [&n](Int_t) { ++n; });
+   return n;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -221,14 +578,11 @@ void THashTable::Delete(Option_t *)
 {
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
-   for (int i = 0; i < fSize; i++)
-      if (fCont[i]) {
-         fCont[i]->Delete();
-         SafeDelete(fCont[i]);
-      }
+   SafeDelete(fViews);
 
-   fEntries   = 0;
-   fUsedSlots = 0;
+   TList *objects = TakeObjects();
+   objects->Delete();
+   delete objects;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -237,12 +591,15 @@ void THashTable::Delete(Option_t *)
 
 TObject *THashTable::FindObject(const char *name) const
 {
-   Int_t slot = GetHashValue(name);
+   ULong_t hash = GetHashValue(name);
 
    R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
-   if (fCont[slot]) return fCont[slot]->FindObject(name);
-   return 0;
+   Int_t slot = FindSlot(hash, [name](TObject *ob) {
+      const char *obname = ob->GetName();
+      return obname && strcmp(name, obname) == 0;
+   });
+   return slot == -1 ? 0 : fSlots[slot].fObject;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -252,39 +609,64 @@ TObject *THashTable::FindObject(const TObject *obj) const
 {
    if (IsArgNull("FindObject", obj)) return 0;
 
-   Int_t slot = GetHashValue(obj);
-   if (fCont[slot]) return fCont[slot]->FindObject(obj);
-   return 0;
+   ULong_t hash = GetHashValue(obj);
+   Int_t slot = FindSlot(hash, [obj](TObject *ob) { return ob->IsEqual(obj); });
+   return slot == -1 ? 0 : fSlots[slot].fObject;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Return the TList corresponding to object's name based hash value.
-/// One can iterate this list "manually" to find, e.g. objects with
-/// the same name.
+/// Return the list of the objects with the given hash value, in the order
+/// they were added in, or 0 if there are none. The list is built the first
+/// time it is asked for.
 
-const TList *THashTable::GetListForObject(const char *name) const
+const TList *THashTable::GetListForHash(ULong_t hash) const
 {
-   Int_t slot = GetHashValue(name);
+   // The lists are built by readers of a const table, which may run
+   // concurrently even if the table does not UseRWLock(): serialize them.
+   static std::mutex viewsMutex;
 
    R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
+   std::lock_guard<std::mutex> lock(viewsMutex);
+
+   if (fViews) {
+      if (TList *view = fViews->Find(hash))
+         return view;
+   }
+
+   std::vector<Int_t> slots;
+   ForEachSlot(hash, [&slots](Int_t slot) { slots.push_back(slot); });
+   if (slots.empty()) return 0;
+   std::sort(slots.begin(), slots.end(), [this](Int_t a, Int_t b) { return fSlots[a].fOrder < fSlots[b].fOrder; });
 
-   return fCont[slot];
+   if (!fViews) fViews = new TBucketViews;
+   std::unique_ptr<TList> &view = fViews->fLists[hash];
+   view.reset(new TList);
+   for (auto slot : slots) view->Add(fSlots[slot].fObject);
+   return view.get();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Return the TList corresponding to object's hash value.
-/// One can iterate this list "manually" to find, e.g. identical
-/// objects.
+/// Return the TList of the objects with the same hash value as name, in
+/// the order they were added in. One can iterate this list "manually" to
+/// find, e.g. objects with the same name. The list stays valid, and up to
+/// date, until all its objects are removed or the table is cleared.
 
-const TList *THashTable::GetListForObject(const TObject *obj) const
+const TList *THashTable::GetListForObject(const char *name) const
 {
-   if (IsArgNull("GetListForObject", obj)) return 0;
+   return GetListForHash(GetHashValue(name));
+}
 
-   Int_t slot = GetHashValue(obj);
+////////////////////////////////////////////////////////////////////////////////
+/// Return the TList of the objects with the same hash value as obj, in
+/// the order they were added in. One can iterate this list "manually" to
+/// find, e.g. identical objects. The list stays valid, and up to date,
+/// until all its objects are removed or the table is cleared.
 
-   R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
+const TList *THashTable::GetListForObject(const TObject *obj) const
+{
+   if (IsArgNull("GetListForObject", obj)) return 0;
 
-   return fCont[slot];
+   return GetListForHash(GetHashValue(obj));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -294,12 +676,12 @@ TObject **THashTable::GetObjectRef(const TObject *obj) const
 {
    if (IsArgNull("GetObjectRef", obj)) return 0;
 
-   Int_t slot = GetHashValue(obj);
+   ULong_t hash = GetHashValue(obj);
 
    R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
-   if (fCont[slot]) return fCont[slot]->GetObjectRef(obj);
-   return 0;
+   Int_t slot = FindSlot(hash, [obj](TObject *ob) { return ob->IsEqual(obj); });
+   return slot == -1 ? 0 : &fSlots[slot].fObject;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -337,11 +719,11 @@ void THashTable::Print(Option_t *option, Int_t recurse) const
       for (Int_t cursor = 0; cursor < Capacity();
            cursor++) {
          printf("Slot #%d:\n",cursor);
-         if (fCont[cursor])
-            fCont[cursor]->Print();
+         if (fCtrl && fCtrl[cursor] >= 0)
+            PrintCollectionEntry(fSlots[cursor].fObject, option, recurse - 1);
          else {
             TROOT::IndentLevel();
-            printf("empty\n");
+            printf(fCtrl && fCtrl[cursor] == kDeleted ? "deleted\n" : "empty\n");
          }
 
       }
@@ -350,62 +732,25 @@ void THashTable::Print(Option_t *option, Int_t recurse) const
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Rehash the hashtable. If the collision rate becomes too high (i.e.
-/// the average size of the linked lists become too long) then lookup
-/// efficiency decreases since relatively long lists have to be searched
-/// every time. To improve performance rehash the hashtable. This resizes
-/// the table to newCapacity slots and refills the table. Use
-/// AverageCollisions() to check if you need to rehash. Set checkObjValidity
-/// to kFALSE if you know that all objects in the table are still valid
-/// (i.e. have not been deleted from the system in the meanwhile).
+/// Rehash the hashtable. The table grows by itself when it gets 7/8 full,
+/// but many removals or a poor hash function make the probe sequences
+/// longer, and lookup efficiency decreases. Rehashing refills the table,
+/// sized to hold newCapacity objects (or the current number of objects, if
+/// larger) without growing. Use AverageCollisions() to check if you need to
+/// rehash. Set checkObjValidity to kFALSE if you know that all objects in
+/// the table are still valid (i.e. have not been deleted from the system
+/// in the meanwhile).
 
 void THashTable::Rehash(Int_t newCapacity, Bool_t checkObjValidity)
 {
-   THashTable *ht = new THashTable(newCapacity);
-
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
-   TIter next(this);
-   TObject *obj;
-
-   auto initialSize = GetEntries();
-
-   if (checkObjValidity && TObject::GetObjectStat() && gObjectTable) {
-      while ((obj = next()))
-         if (gObjectTable->PtrIsValid(obj))
-            ht->AddImpl(ht->GetHashValue(obj),obj);
-   } else {
-      while ((obj = next()))
-         ht->AddImpl(ht->GetHashValue(obj),obj);
-   }
-
-   if (initialSize != GetEntries()) {
-      // Somehow in the process of copy the pointer from one hash to
-      // other we ended up inducing the addition of more element to
-      // the table.  Most likely those elements have not been copied ....
-      // i.e. Adding *during* the Rehashing is illegal and fatal.
-
-      Fatal("Rehash",
-            "During the rehash of %p one or more element was added or removed. The initalize size was %d and now it is %d",
-            this, initialSize, GetEntries());
-
-   }
-
-   Clear("nodelete");
-   delete [] fCont;
-   fCont = ht->fCont;
-   ht->fCont = 0;
-
-   fSize      = ht->fSize;     // idem
-   fEntries   = ht->fEntries;
-   fUsedSlots = ht->fUsedSlots;
+   Resize(SlotsFor(std::max(newCapacity, fEntries)), checkObjValidity);
 
    // this should not happen, but it will prevent an endless loop
    // in case of a very bad hash function
    if (fRehashLevel && AverageCollisions() > fRehashLevel)
       fRehashLevel = (int)AverageCollisions() + 1;
-
-   delete ht;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -413,24 +758,23 @@ void THashTable::Rehash(Int_t newCapacity, Bool_t checkObjValidity)
 
 TObject *THashTable::Remove(TObject *obj)
 {
-   Int_t slot = GetHashValue(obj);
+   ULong_t hash = GetHashValue(obj);
+   auto match = [obj](TObject *ob) { return ob->IsEqual(obj); };
 
    R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
-   if (fCont[slot]) {
-      R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   if (FindSlot(hash, match) == -1) return 0;
 
-      TObject *ob = fCont[slot]->Remove(obj);
-      if (ob) {
-         fEntries--;
-         if (fCont[slot]->GetSize() == 0) {
-            SafeDelete(fCont[slot]);
-            fUsedSlots--;
-         }
-         return ob;
-      }
-   }
-   return 0;
+   R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
+
+   // Acquiring the write lock lets other writers in: look for the object again.
+   Int_t slot = FindSlot(hash, match);
+   if (slot == -1) return 0;
+
+   TObject *ob = fSlots[slot].fObject;
+   if (fViews) fViews->Remove(hash, ob);
+   EraseSlot(slot);
+   return ob;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -441,20 +785,18 @@ TObject *THashTable::RemoveSlow(TObject *obj)
 
    R__COLLECTION_WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
-   for (int i = 0; i < fSize; i++) {
-      if (fCont[i]) {
-         TObject *ob = fCont[i]->Remove(obj);
-         if (ob) {
-            fEntries--;
-            if (fCont[i]->GetSize() == 0) {
-               SafeDelete(fCont[i]);
-               fUsedSlots--;
-            }
-            return ob;
-         }
-      }
+   Int_t found = -1;
+   for (Int_t i = 0; fCtrl && i < fSize; i++) {
+      if (fCtrl[i] >= 0 && (found == -1 || fSlots[i].fOrder < fSlots[found].fOrder) &&
+          fSlots[i].fObject->IsEqual(obj))
+         found = i;
    }
-   return 0;
+   if (found == -1) return 0;
+
+   TObject *ob = fSlots[found].fObject;
+   if (fViews) fViews->Remove(fSlots[found].fHash, ob);
+   EraseSlot(found);
+   return ob;
 }
 
 /** \class THashTableIter
@@ -471,7 +813,6 @@ THashTableIter::THashTableIter(const THashTable *ht, Bool_t dir)
 {
    fTable      = ht;
    fDirection  = dir;
-   fListCursor = 0;
    Reset();
 }
 
@@ -483,12 +824,7 @@ THashTableIter::THashTableIter(const THashTableIter &iter) : TIterator(iter)
    fTable      = iter.fTable;
    fDirection  = iter.fDirection;
    fCursor     = iter.fCursor;
-   fListCursor = 0;
-   if (iter.fListCursor) {
-      fListCursor = (TListIter *)iter.fListCursor->GetCollection()->MakeIterator();
-      if (fListCursor)
-         fListCursor->operator=(*iter.fListCursor);
-   }
+   fCurrent    = iter.fCurrent;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -501,13 +837,7 @@ TIterator &THashTableIter::operator=(const TIterator &rhs)
       fTable     = rhs1.fTable;
       fDirection = rhs1.fDirection;
       fCursor    = rhs1.fCursor;
-      if (rhs1.fListCursor) {
-         // R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
-
-         fListCursor = (TListIter *)rhs1.fListCursor->GetCollection()->MakeIterator();
-         if (fListCursor)
-            fListCursor->operator=(*rhs1.fListCursor);
-      }
+      fCurrent   = rhs1.fCurrent;
    }
    return *this;
 }
@@ -521,25 +851,11 @@ THashTableIter &THashTableIter::operator=(const THashTableIter &rhs)
       fTable     = rhs.fTable;
       fDirection = rhs.fDirection;
       fCursor    = rhs.fCursor;
-      if (rhs.fListCursor) {
-         // R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
-
-         fListCursor = (TListIter *)rhs.fListCursor->GetCollection()->MakeIterator();
-         if (fListCursor)
-            fListCursor->operator=(*rhs.fListCursor);
-      }
+      fCurrent   = rhs.fCurrent;
    }
    return *this;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-/// Delete hashtable iterator.
-
-THashTableIter::~THashTableIter()
-{
-   delete fListCursor;
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 /// Return next object in hashtable. Returns 0 when no more objects in table.
 
@@ -547,42 +863,28 @@ TObject *THashTableIter::Next()
 {
    // R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
 
-   while (kTRUE) {
-      if (!fListCursor) {
-         int slot = NextSlot();
-         if (slot == -1) return 0;
-         fListCursor = new TListIter(fTable->fCont[slot], fDirection);
-      }
-
-      TObject *obj = fListCursor->Next();
-      if (obj) return obj;
-
-      SafeDelete(fListCursor);
-   }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-/// Returns index of next slot in table containing list to be iterated.
-
-Int_t THashTableIter::NextSlot()
-{
-   // R__COLLECTION_READ_LOCKGUARD(ROOT::gCoreMutex);
+   fCurrent = -1;
+   const signed char *ctrl = fTable->fCtrl;
+   if (!ctrl) return 0;
 
    if (fDirection == kIterForward) {
-      for ( ; fCursor < fTable->Capacity() && fTable->fCont[fCursor] == 0;
-              fCursor++) { }
-
-      if (fCursor < fTable->Capacity())
-         return fCursor++;
-
+      for ( ; fCursor < fTable->Capacity(); fCursor++) {
+         if (ctrl[fCursor] >= 0) {
+            fCurrent = fCursor++;
+            return fTable->fSlots[fCurrent].fObject;
+         }
+      }
    } else {
-      for ( ; fCursor >= 0 && fTable->fCont[fCursor] == 0;
-              fCursor--) { }
-
-      if (fCursor >= 0)
-         return fCursor--;
+      if (fCursor >= fTable->Capacity())
+         fCursor = fTable->Capacity() - 1;
+      for ( ; fCursor >= 0; fCursor--) {
+         if (ctrl[fCursor] >= 0) {
+            fCurrent = fCursor--;
+            return fTable->fSlots[fCurrent].fObject;
+         }
+      }
    }
-   return -1;
+   return 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -595,7 +897,7 @@ void THashTableIter::Reset()
       fCursor = 0;
    else
       fCursor = fTable->Capacity() - 1;
-   SafeDelete(fListCursor);
+   fCurrent = -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -605,7 +907,7 @@ Bool_t THashTableIter::operator!=(const TIterator &aIter) const
 {
    if (aIter.IsA() == THashTableIter::Class()) {
       const THashTableIter &iter(dynamic_cast<const THashTableIter &>(aIter));
-      return (fListCursor != iter.fListCursor);
+      return (operator*() != iter.operator*());
    }
    return false; // for base class we don't implement a comparison
 }
@@ -615,7 +917,7 @@ Bool_t THashTableIter::operator!=(const TIterator &aIter) const
 
 Bool_t THashTableIter::operator!=(const THashTableIter &aIter) const
 {
-   return (fListCursor != aIter.fListCursor);
+   return (operator*() != aIter.operator*());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -623,5 +925,7 @@ Bool_t THashTableIter::operator!=(const THashTableIter &aIter) const
 
 TObject *THashTableIter::operator*() const
 {
-   return (fListCursor ? fListCursor->operator*() : nullptr);
+   if (fCurrent < 0 || fCurrent >= fTable->Capacity() || !fTable->fCtrl || fTable->fCtrl[fCurrent] < 0)
+      return nullptr;
+   return fTable->fSlots[fCurrent].fObject;
 }
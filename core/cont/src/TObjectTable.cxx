@@ -257,6 +257,30 @@ void TObjectTable::RemoveQuietly(TObject *op)
    fTally--;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Quietly remove all the objects located in the memory range [begin, end).
+/// Used by ROOT::TObjectArena when it reclaims the memory of the objects
+/// that were not deleted.
+
+void TObjectTable::RemoveRange(const void *begin, const void *end)
+{
+   if (!fTable)
+      return;
+
+   const char *b = static_cast<const char *>(begin);
+   const char *e = static_cast<const char *>(end);
+   Int_t nremoved = 0;
+   for (int i = 0; i < fSize; i++) {
+      const char *p = reinterpret_cast<const char *>(fTable[i]);
+      if (p && p >= b && p < e) {
+         fTable[i] = 0;
+         nremoved++;
+      }
+   }
+   if (nremoved)
+      Expand(fSize); // rehash the remaining objects
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Deletes the object table (this static class function calls the dtor).
 
@@ -0,0 +1,222 @@
+#include "THashList.h"
+#include "THashTable.h"
+#include "TList.h"
+#include "TNamed.h"
+#include "TObjString.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// An object whose hash value does not depend on its name, to fill the table
+/// with objects having the same hash value.
+class TConstantHash : public TNamed {
+public:
+   TConstantHash(const char *name) : TNamed(name, "") {}
+   ULong_t Hash() const { return 42; }
+};
+
+} // anonymous namespace
+
+TEST(THashTable, AddFindRemove)
+{
+   THashTable table;
+   std::vector<std::unique_ptr<TObjString>> objects;
+   for (Int_t i = 0; i < 5000; ++i)
+      objects.emplace_back(new TObjString(std::to_string(i).c_str()));
+
+   for (auto &obj : objects)
+      table.Add(obj.get());
+   EXPECT_EQ(5000, table.GetSize());
+   EXPECT_GE(table.Capacity(), 5000);
+   EXPECT_LT(table.AverageCollisions(), 2);
+
+   for (auto &obj : objects) {
+      EXPECT_EQ(obj.get(), table.FindObject(obj->GetName()));
+      EXPECT_EQ(obj.get(), table.FindObject(obj.get()));
+   }
+   EXPECT_EQ(nullptr, table.FindObject("5000"));
+
+   // Remove every other object: the others must still be found past the
+   // freed slots, and the freed slots must be reused.
+   for (Int_t i = 0; i < 5000; i += 2)
+      EXPECT_EQ(objects[i].get(), table.Remove(objects[i].get()));
+   EXPECT_EQ(2500, table.GetSize());
+   for (Int_t i = 0; i < 5000; ++i)
+      EXPECT_EQ(i % 2 ? objects[i].get() : nullptr, table.FindObject(objects[i]->GetName()));
+
+   for (Int_t round = 0; round < 10; ++round) {
+      for (Int_t i = 0; i < 5000; i += 2)
+         table.Add(objects[i].get());
+      for (Int_t i = 0; i < 5000; i += 2)
+         table.Remove(objects[i].get());
+   }
+   EXPECT_EQ(2500, table.GetSize());
+   EXPECT_LT(table.AverageCollisions(), 2);
+
+   std::set<TObject *> seen;
+   for (auto obj : table)
+      EXPECT_TRUE(seen.insert(obj).second);
+   EXPECT_EQ(2500u, seen.size());
+
+   seen.clear();
+   TIter backward(&table, kIterBackward);
+   while (TObject *obj = backward())
+      EXPECT_TRUE(seen.insert(obj).second);
+   EXPECT_EQ(2500u, seen.size());
+
+   table.Clear();
+   EXPECT_EQ(0, table.GetSize());
+   EXPECT_EQ(nullptr, table.FindObject("1"));
+}
+
+TEST(THashTable, SameHash)
+{
+   THashTable table;
+   TConstantHash a("a"), b("b"), b2("b"), c("c");
+   table.Add(&a);
+   table.Add(&b);
+   table.Add(&b2);
+
+   EXPECT_EQ(3, table.Collisions(&a));
+   EXPECT_EQ(&a, table.FindObject("a"));
+   // The first object added wins.
+   EXPECT_EQ(&b, table.FindObject("b"));
+
+   const TList *list = table.GetListForObject(&a);
+   ASSERT_NE(nullptr, list);
+   ASSERT_EQ(3, list->GetSize());
+   EXPECT_EQ(&a, list->At(0));
+   EXPECT_EQ(&b, list->At(1));
+   EXPECT_EQ(&b2, list->At(2));
+
+   // The list is kept up to date.
+   table.AddBefore(&b, &c);
+   EXPECT_EQ(list, table.GetListForObject(&a));
+   ASSERT_EQ(4, list->GetSize());
+   EXPECT_EQ(&c, list->At(1));
+   table.Remove(&b);
+   EXPECT_EQ(&b2, table.FindObject("b"));
+   EXPECT_EQ(3, list->GetSize());
+
+   // AddBefore changes the order of the objects with the same hash value.
+   TConstantHash b3("b");
+   table.AddBefore(&b2, &b3);
+   EXPECT_EQ(&b3, table.FindObject("b"));
+
+   table.Rehash(1000);
+   EXPECT_EQ(&b3, table.FindObject("b"));
+   EXPECT_EQ(4, table.Collisions(&a));
+   EXPECT_EQ(4, list->GetSize());
+   // The name lookup uses the hash value of the name, which is not 42.
+   EXPECT_EQ(nullptr, table.GetListForObject("a"));
+}
+
+TEST(THashTable, ListForObjectAfterRemove)
+{
+   THashTable table;
+   TNamed a("a", ""), a2("a", "");
+   table.Add(&a);
+   table.Add(&a2);
+   const TList *list = table.GetListForObject("a");
+   ASSERT_NE(nullptr, list);
+   EXPECT_EQ(2, list->GetSize());
+   table.Remove(&a);
+   EXPECT_EQ(1, list->GetSize());
+   EXPECT_EQ(&a2, list->First());
+
+   // As a bucket of a chained table, the list is gone once it is empty.
+   table.Remove(&a2);
+   EXPECT_EQ(nullptr, table.GetListForObject("a"));
+   table.Add(&a);
+   list = table.GetListForObject("a");
+   ASSERT_NE(nullptr, list);
+   EXPECT_EQ(1, list->GetSize());
+   EXPECT_EQ(&a, list->First());
+   table.Remove(&a);
+}
+
+TEST(THashTable, GrowsAtRehashLevelZero)
+{
+   THashTable table(16, 0);
+   std::vector<std::unique_ptr<TNamed>> objects;
+   for (Int_t i = 0; i < 1000; ++i) {
+      objects.emplace_back(new TNamed(TString::Format("obj%d", i).Data(), ""));
+      table.Add(objects.back().get());
+   }
+   EXPECT_EQ(0, table.GetRehashLevel());
+   EXPECT_LE(1000, table.Capacity());
+   for (auto &obj : objects)
+      EXPECT_EQ(obj.get(), table.FindObject(obj->GetName()));
+   table.Clear();
+}
+
+// The lists of GetListForObject are built by the const lookups, which may run
+// concurrently on a table that does not use the read-write lock.
+TEST(THashTable, ConcurrentListForObject)
+{
+   THashTable table;
+   std::vector<std::unique_ptr<TNamed>> objects;
+   for (Int_t i = 0; i < 1000; ++i) {
+      objects.emplace_back(new TNamed(TString::Format("obj%d", i).Data(), ""));
+      table.Add(objects.back().get());
+   }
+   const THashTable &constTable = table;
+   std::vector<std::thread> threads;
+   for (Int_t t = 0; t < 4; ++t) {
+      threads.emplace_back([&constTable, &objects]() {
+         for (auto &obj : objects) {
+            const TList *list = constTable.GetListForObject(obj->GetName());
+            EXPECT_NE(nullptr, list);
+            if (list)
+               EXPECT_NE(nullptr, list->FindObject(obj.get()));
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   table.Clear();
+}
+
+TEST(THashTable, Owner)
+{
+   THashTable table;
+   table.SetOwner();
+   for (Int_t i = 0; i < 100; ++i)
+      table.Add(new TNamed(std::to_string(i).c_str(), ""));
+   table.Delete();
+   EXPECT_EQ(0, table.GetSize());
+   for (Int_t i = 0; i < 100; ++i)
+      table.Add(new TNamed(std::to_string(i).c_str(), ""));
+   EXPECT_EQ(100, table.GetSize());
+}
+
+TEST(THashList, FindAfterRemove)
+{
+   THashList list;
+   std::vector<std::unique_ptr<TNamed>> objects;
+   for (Int_t i = 0; i < 1000; ++i) {
+      objects.emplace_back(new TNamed(("obj" + std::to_string(i)).c_str(), ""));
+      list.Add(objects.back().get());
+   }
+   for (Int_t i = 0; i < 1000; i += 3)
+      list.Remove(objects[i].get());
+   for (Int_t i = 0; i < 1000; ++i)
+      EXPECT_EQ(i % 3 ? objects[i].get() : nullptr, list.FindObject(objects[i]->GetName()));
+
+   // Same name: the list order decides which one is found.
+   TNamed first("obj1", "");
+   list.AddFirst(&first);
+   EXPECT_EQ(objects[1].get(), list.FindObject("obj1"));
+   const TList *bucket = list.GetListForObject("obj1");
+   ASSERT_NE(nullptr, bucket);
+   EXPECT_EQ(2, bucket->GetSize());
+   list.Remove(&first);
+   EXPECT_EQ(1, bucket->GetSize());
+}
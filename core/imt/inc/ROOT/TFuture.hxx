@@ -16,8 +16,15 @@
 
 #include "ROOT/TTaskGroup.hxx"
 
-#include <type_traits>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // exclude in case ROOT does not have IMT support
 #ifndef R__USE_IMT
@@ -33,33 +40,105 @@ namespace ROOT {
 namespace Experimental {
 template <typename T>
 class TFuture;
+
+template <typename T>
+TFuture<std::vector<TFuture<T>>> WhenAll(std::vector<TFuture<T>> &&futures);
 }
 
+namespace Internal {
+////////////////////////////////////////////////////////////////////////////////
+/// The continuations of a TFuture, which are run on the ROOT thread pool once
+/// the value of the future is ready, without any thread waiting for it.
+class TFutureContinuations {
+private:
+   std::mutex fMutex;
+   bool fReady{false};
+   std::vector<std::function<void(void)>> fContinuations;
+
+public:
+   void Add(std::function<void(void)> &&continuation);
+   void SetReady();
+};
+
+void EnqueueTask(std::function<void(void)> &&task);
+
+/// Call the continuation f with the value of the ready future antecedent.
+template <typename T>
+struct TContinuationCaller {
+   template <typename F>
+   static auto Call(F &f, std::future<T> &antecedent) -> decltype(f(antecedent.get()))
+   {
+      return f(antecedent.get());
+   }
+};
+
+template <>
+struct TContinuationCaller<void> {
+   template <typename F>
+   static auto Call(F &f, std::future<void> &antecedent) -> decltype(f())
+   {
+      antecedent.get();
+      return f();
+   }
+};
+
+template <typename T, typename F>
+using ContinuationResult_t = decltype(
+   TContinuationCaller<T>::Call(std::declval<typename std::decay<F>::type &>(), std::declval<std::future<T> &>()));
+
+template <typename T>
+struct TWhenAllState {
+   std::atomic<std::size_t> fRemaining{0};
+   std::promise<std::vector<Experimental::TFuture<T>>> fPromise;
+   std::vector<Experimental::TFuture<T>> fFutures;
+};
+} // namespace Internal
+
 namespace Detail {
 template <typename T>
 class TFutureImpl {
    template <typename V>
    friend class Experimental::TFuture;
+   template <typename V>
+   friend class TFutureImpl;
+   template <typename V>
+   friend Experimental::TFuture<std::vector<Experimental::TFuture<V>>>
+   Experimental::WhenAll(std::vector<Experimental::TFuture<V>> &&futures);
 
 protected:
    using TTaskGroup = Experimental::TTaskGroup;
+   using TaskGroups_t = std::vector<std::unique_ptr<TTaskGroup>>;
+   using Continuations_t = std::shared_ptr<Internal::TFutureContinuations>;
    std::future<T> fStdFut;
-   std::unique_ptr<TTaskGroup> fTg{nullptr};
+   /// The task groups running the work this future depends on, which wait() helps to complete.
+   TaskGroups_t fTgs;
+   /// Null if the future wraps an std::future, of which the readiness cannot be observed.
+   Continuations_t fContinuations;
 
-   TFutureImpl(std::future<T> &&fut, std::unique_ptr<TTaskGroup> &&tg) : fStdFut(std::move(fut))
+   TFutureImpl(std::future<T> &&fut, TaskGroups_t &&tgs, const Continuations_t &continuations)
+      : fStdFut(std::move(fut)), fTgs(std::move(tgs)), fContinuations(continuations)
    {
-      fTg = std::move(tg);
-   };
+   }
    TFutureImpl(){};
 
    TFutureImpl(std::future<T> &&fut) : fStdFut(std::move(fut)) {}
 
-   TFutureImpl(TFutureImpl<T> &&other) : fStdFut(std::move(other.fStdFut)), fTg(std::move(other.fTg)) {}
+   TFutureImpl(TFutureImpl<T> &&other)
+      : fStdFut(std::move(other.fStdFut)), fTgs(std::move(other.fTgs)),
+        fContinuations(std::move(other.fContinuations))
+   {
+   }
 
    TFutureImpl &operator=(std::future<T> &&other) { fStdFut = std::move(other); }
 
    TFutureImpl<T> &operator=(TFutureImpl<T> &&other) = default;
 
+   template <typename R>
+   static Experimental::TFuture<R> MakeFuture(std::future<R> &&fut, TaskGroups_t &&tgs, const Continuations_t &continuations)
+   {
+      return Experimental::TFuture<R>(std::move(fut), std::move(tgs), continuations);
+   }
+
 public:
    TFutureImpl<T> &operator=(TFutureImpl<T> &other) = delete;
 
@@ -67,11 +146,60 @@ public:
 
    void wait()
    {
-      if (fTg)
-         fTg->Wait();
+      if (!is_ready()) {
+         for (auto &tg : fTgs)
+            tg->Wait();
+      }
+      if (fStdFut.valid())
+         fStdFut.wait();
    }
 
    bool valid() const { return fStdFut.valid(); };
+
+   /// Return true if the value, or the exception, of the future is available.
+   bool is_ready() const
+   {
+      return fStdFut.valid() && fStdFut.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Attach a continuation to the future: f is run on the ROOT thread pool with
+   /// the value of the future, or without argument for a TFuture<void>, once it
+   /// is ready. Return a future holding the result of f. If the future holds an
+   /// exception, f is not run and the returned future holds that exception.
+   ///
+   /// No thread waits for the value, unless the future was built from an
+   /// std::future, in which case a thread of the pool does. The future is not
+   /// valid anymore afterwards.
+   template <typename F>
+   Experimental::TFuture<Internal::ContinuationResult_t<T, F>> then(F &&f)
+   {
+      using Ret_t = Internal::ContinuationResult_t<T, F>;
+      using Func_t = typename std::decay<F>::type;
+
+      if (!fStdFut.valid())
+         throw std::future_error(std::future_errc::no_state);
+
+      auto antecedent = std::make_shared<std::future<T>>(std::move(fStdFut));
+      Func_t func(std::forward<F>(f));
+      auto task = std::make_shared<std::packaged_task<Ret_t()>>(
+         [antecedent, func]() mutable -> Ret_t { return Internal::TContinuationCaller<T>::Call(func, *antecedent); });
+      // Obtained before the task may run, with which get_future() is not thread safe.
+      auto result = task->get_future();
+      auto continuations = std::make_shared<Internal::TFutureContinuations>();
+      std::function<void(void)> run = [task, continuations]() {
+         (*task)();
+         continuations->SetReady();
+      };
+
+      if (fContinuations) {
+         fContinuations->Add(std::move(run));
+         fContinuations.reset();
+      } else {
+         Internal::EnqueueTask(std::move(run));
+      }
+      return MakeFuture<Ret_t>(std::move(result), std::move(fTgs), continuations);
+   }
 };
 }
 
@@ -86,9 +214,15 @@ class TFuture final : public ROOT::Detail::TFutureImpl<T> {
       typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type>
    Async(Function &&f, Args &&... args);
 
+   template <typename V>
+   friend class ROOT::Detail::TFutureImpl;
+
 private:
-   TFuture(std::future<T> &&fut, std::unique_ptr<TTaskGroup> &&tg)
-      : ROOT::Detail::TFutureImpl<T>(std::forward<std::future<T>>(fut), std::move(tg)){};
+   using typename ROOT::Detail::TFutureImpl<T>::TaskGroups_t;
+   using typename ROOT::Detail::TFutureImpl<T>::Continuations_t;
+
+   TFuture(std::future<T> &&fut, TaskGroups_t &&tgs, const Continuations_t &continuations)
+      : ROOT::Detail::TFutureImpl<T>(std::forward<std::future<T>>(fut), std::move(tgs), continuations){};
 
 public:
    TFuture(std::future<T> &&fut) : ROOT::Detail::TFutureImpl<T>(std::forward<std::future<T>>(fut)){};
@@ -108,9 +242,15 @@ class TFuture<void> final : public ROOT::Detail::TFutureImpl<void> {
       typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type>
    Async(Function &&f, Args &&... args);
 
+   template <typename V>
+   friend class ROOT::Detail::TFutureImpl;
+
 private:
-   TFuture(std::future<void> &&fut, std::unique_ptr<TTaskGroup> &&tg)
-      : ROOT::Detail::TFutureImpl<void>(std::forward<std::future<void>>(fut), std::move(tg)){};
+   using typename ROOT::Detail::TFutureImpl<void>::TaskGroups_t;
+   using typename ROOT::Detail::TFutureImpl<void>::Continuations_t;
+
+   TFuture(std::future<void> &&fut, TaskGroups_t &&tgs, const Continuations_t &continuations)
+      : ROOT::Detail::TFutureImpl<void>(std::forward<std::future<void>>(fut), std::move(tgs), continuations){};
 
 public:
    TFuture(std::future<void> &&fut) : ROOT::Detail::TFutureImpl<void>(std::forward<std::future<void>>(fut)){};
@@ -129,9 +269,15 @@ class TFuture<T &> final : public ROOT::Detail::TFutureImpl<T &> {
       typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type>
    Async(Function &&f, Args &&... args);
 
+   template <typename V>
+   friend class ROOT::Detail::TFutureImpl;
+
 private:
-   TFuture(std::future<T &> &&fut, std::unique_ptr<TTaskGroup> &&tg)
-      : ROOT::Detail::TFutureImpl<T &>(std::forward<std::future<T &>>(fut), std::move(tg)){};
+   using typename ROOT::Detail::TFutureImpl<T &>::TaskGroups_t;
+   using typename ROOT::Detail::TFutureImpl<T &>::Continuations_t;
+
+   TFuture(std::future<T &> &&fut, TaskGroups_t &&tgs, const Continuations_t &continuations)
+      : ROOT::Detail::TFutureImpl<T &>(std::forward<std::future<T &>>(fut), std::move(tgs), continuations){};
 
 public:
    TFuture(std::future<T &> &&fut) : ROOT::Detail::TFutureImpl<T &>(std::forward<std::future<T &>>(fut)){};
@@ -158,10 +304,77 @@ Async(Function &&f, Args &&... args)
    using Ret_t = typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type;
 
    auto thisPt = std::make_shared<std::packaged_task<Ret_t()>>(std::bind(f, args...));
-   std::unique_ptr<ROOT::Experimental::TTaskGroup> tg(new ROOT::Experimental::TTaskGroup());
-   tg->Run([thisPt]() { (*thisPt)(); });
+   auto continuations = std::make_shared<ROOT::Internal::TFutureContinuations>();
+   std::vector<std::unique_ptr<ROOT::Experimental::TTaskGroup>> tgs;
+   tgs.emplace_back(new ROOT::Experimental::TTaskGroup());
+   tgs.back()->Run([thisPt, continuations]() {
+      (*thisPt)();
+      continuations->SetReady();
+   });
+
+   return ROOT::Experimental::TFuture<Ret_t>(thisPt->get_future(), std::move(tgs), continuations);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a future which becomes ready when all the futures are, holding them.
+/// Their values, or exceptions, can then be obtained with get() without
+/// blocking, e.g. in a continuation attached with then():
+/// ~~~{.cpp}
+/// std::vector<TFuture<Buffer>> reads;
+/// for (auto &cluster : clusters)
+///    reads.emplace_back(Async(ReadCluster, cluster).then(Unzip));
+/// auto done = WhenAll(std::move(reads)).then([](std::vector<TFuture<Buffer>> &&buffers) {
+///    for (auto &b : buffers)
+///       Process(b.get());
+/// });
+/// ~~~
+/// No thread waits for the futures, unless they were built from an
+/// std::future, in which case a thread of the pool waits for each of them.
+template <typename T>
+TFuture<std::vector<TFuture<T>>> WhenAll(std::vector<TFuture<T>> &&futures)
+{
+   using Result_t = std::vector<TFuture<T>>;
+   using Impl_t = ROOT::Detail::TFutureImpl<T>;
+
+   auto state = std::make_shared<ROOT::Internal::TWhenAllState<T>>();
+   auto continuations = std::make_shared<ROOT::Internal::TFutureContinuations>();
+   typename Impl_t::TaskGroups_t tgs;
+   std::vector<typename Impl_t::Continuations_t> inputs;
+   for (auto &f : futures) {
+      if (!f.valid())
+         throw std::future_error(std::future_errc::no_state);
+      // The task groups go to the returned future, whose wait() helps them.
+      for (auto &tg : f.fTgs)
+         tgs.emplace_back(std::move(tg));
+      f.fTgs.clear();
+      inputs.emplace_back(std::move(f.fContinuations));
+   }
+   state->fFutures = std::move(futures);
+   // One more than the number of inputs, so that the result is not set before
+   // all the continuations are registered.
+   state->fRemaining = inputs.size() + 1;
+
+   auto result = state->fPromise.get_future();
+   std::function<void(void)> done = [state, continuations]() {
+      if (--state->fRemaining == 0) {
+         state->fPromise.set_value(std::move(state->fFutures));
+         continuations->SetReady();
+      }
+   };
+   for (std::size_t i = 0; i < inputs.size(); ++i) {
+      if (inputs[i]) {
+         std::function<void(void)> copy = done;
+         inputs[i]->Add(std::move(copy));
+      } else {
+         ROOT::Internal::EnqueueTask([state, i, done]() {
+            state->fFutures[i].fStdFut.wait();
+            done();
+         });
+      }
+   }
+   done();
 
-   return ROOT::Experimental::TFuture<Ret_t>(thisPt->get_future(), std::move(tg));
+   return Impl_t::template MakeFuture<Result_t>(std::move(result), std::move(tgs), continuations);
 }
 }
 }
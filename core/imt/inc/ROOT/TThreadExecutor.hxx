@@ -26,6 +26,7 @@
 #include "ROOT/TPoolManager.hxx"
 #include "TROOT.h"
 #include "TError.h"
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <numeric>
@@ -100,6 +101,7 @@ namespace ROOT {
 
    private:
       void   ParallelFor(unsigned start, unsigned end, unsigned step, const std::function<void(unsigned int i)> &f);
+      void   ParallelForRange(unsigned nIterations, const std::function<void(unsigned begin, unsigned end)> &f);
       double ParallelReduce(const std::vector<double> &objs, const std::function<double(double a, double b)> &redfunc);
       float  ParallelReduce(const std::vector<float> &objs, const std::function<float(float a, float b)> &redfunc);
       template<class T, class R>
@@ -114,10 +116,14 @@ namespace ROOT {
    /// Execute func (with no arguments) nTimes in parallel.
    /// Functions that take more than zero arguments can be executed (with
    /// fixed arguments) by wrapping them in a lambda or with std::bind.
+   /// If nChunks is 0, the executions are partitioned automatically.
    template<class F>
    void TThreadExecutor::Foreach(F func, unsigned nTimes, unsigned nChunks) {
       if (nChunks == 0) {
-         ParallelFor(0U, nTimes, 1, [&](unsigned int){func();});
+         ParallelForRange(nTimes, [&](unsigned begin, unsigned end) {
+            for (unsigned i = begin; i < end; ++i)
+               func();
+         });
          return;
       }
 
@@ -137,7 +143,12 @@ namespace ROOT {
    template<class F, class INTEGER>
    void TThreadExecutor::Foreach(F func, ROOT::TSeq<INTEGER> args, unsigned nChunks) {
       if (nChunks == 0) {
-         ParallelFor(*args.begin(), *args.end(), args.step(), [&](unsigned int i){func(i);});
+         unsigned start = *args.begin();
+         unsigned seqStep = args.step();
+         ParallelForRange(args.size(), [&](unsigned begin, unsigned end) {
+            for (unsigned i = begin; i < end; ++i)
+               func(start + i * seqStep);
+         });
          return;
       }
       unsigned start = *args.begin();
@@ -172,7 +183,10 @@ namespace ROOT {
    void TThreadExecutor::Foreach(F func, std::vector<T> &args, unsigned nChunks) {
       unsigned int nToProcess = args.size();
       if (nChunks == 0) {
-         ParallelFor(0U, nToProcess, 1, [&](unsigned int i){func(args[i]);});
+         ParallelForRange(nToProcess, [&](unsigned begin, unsigned end) {
+            for (unsigned i = begin; i < end; ++i)
+               func(args[i]);
+         });
          return;
       }
 
@@ -192,7 +206,10 @@ namespace ROOT {
    void TThreadExecutor::Foreach(F func, const std::vector<T> &args, unsigned nChunks) {
       unsigned int nToProcess = args.size();
       if (nChunks == 0) {
-         ParallelFor(0U, nToProcess, 1, [&](unsigned int i){func(args[i]);});
+         ParallelForRange(nToProcess, [&](unsigned begin, unsigned end) {
+            for (unsigned i = begin; i < end; ++i)
+               func(args[i]);
+         });
          return;
       }
 
@@ -215,11 +232,12 @@ namespace ROOT {
    auto TThreadExecutor::Map(F func, unsigned nTimes) -> std::vector<typename std::result_of<F()>::type> {
       using retType = decltype(func());
       std::vector<retType> reslist(nTimes);
-      auto lambda = [&](unsigned int i)
+      auto lambda = [&](unsigned begin, unsigned end)
       {
-         reslist[i] = func();
+         for (unsigned i = begin; i < end; ++i)
+            reslist[i] = func();
       };
-      ParallelFor(0U, nTimes, 1, lambda);
+      ParallelForRange(nTimes, lambda);
 
       return reslist;
    }
@@ -231,16 +249,16 @@ namespace ROOT {
    template<class F, class INTEGER, class Cond>
    auto TThreadExecutor::Map(F func, ROOT::TSeq<INTEGER> args) -> std::vector<typename std::result_of<F(INTEGER)>::type> {
       unsigned start = *args.begin();
-      unsigned end = *args.end();
       unsigned seqStep = args.step();
 
       using retType = decltype(func(start));
       std::vector<retType> reslist(args.size());
-      auto lambda = [&](unsigned int i)
+      auto lambda = [&](unsigned begin, unsigned end)
       {
-         reslist[i] = func(i);
+         for (unsigned i = begin; i < end; ++i)
+            reslist[i] = func(start + i * seqStep);
       };
-      ParallelFor(start, end, seqStep, lambda);
+      ParallelForRange(args.size(), lambda);
 
       return reslist;
    }
@@ -288,12 +306,13 @@ namespace ROOT {
       unsigned int nToProcess = args.size();
       std::vector<retType> reslist(nToProcess);
 
-      auto lambda = [&](unsigned int i)
+      auto lambda = [&](unsigned begin, unsigned end)
       {
-         reslist[i] = func(args[i]);
+         for (unsigned i = begin; i < end; ++i)
+            reslist[i] = func(args[i]);
       };
 
-      ParallelFor(0U, nToProcess, 1, lambda);
+      ParallelForRange(nToProcess, lambda);
 
       return reslist;
    }
@@ -0,0 +1,85 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TFuture.hxx"
+
+#include "TROOT.h"
+#include "tbb/task.h"
+
+#include <stdexcept>
+
+namespace {
+
+/// A TBB task running a function, for the tasks nobody waits for.
+class TFunctionTask : public tbb::task {
+private:
+   std::function<void(void)> fFunction;
+
+public:
+   TFunctionTask(std::function<void(void)> &&function) : fFunction(std::move(function)) {}
+
+   tbb::task *execute()
+   {
+      fFunction();
+      return nullptr;
+   }
+};
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Run task on the ROOT thread pool, in the arena of the scheduler set up by
+/// the TPoolManager, without anybody waiting for it. Enqueued tasks run even
+/// if the pool has a single thread.
+
+void EnqueueTask(std::function<void(void)> &&task)
+{
+   if (!ROOT::IsImplicitMTEnabled())
+      throw std::runtime_error("Implicit parallelism not enabled. Cannot run the continuation of a TFuture.");
+   tbb::task::enqueue(*new (tbb::task::allocate_root()) TFunctionTask(std::move(task)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Run continuation once the value is ready, now if it already is. It is
+/// always run by a task of its own, never by the thread calling Add() or
+/// SetReady().
+
+void TFutureContinuations::Add(std::function<void(void)> &&continuation)
+{
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (!fReady) {
+         fContinuations.emplace_back(std::move(continuation));
+         return;
+      }
+   }
+   EnqueueTask(std::move(continuation));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Mark the value as ready and run the continuations added so far.
+
+void TFutureContinuations::SetReady()
+{
+   std::vector<std::function<void(void)>> continuations;
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fReady = true;
+      continuations.swap(fContinuations);
+   }
+   for (auto &continuation : continuations)
+      EnqueueTask(std::move(continuation));
+}
+
+} // namespace Internal
+} // namespace ROOT
@@ -12,6 +12,9 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <algorithm>
+#include <chrono>
+
 //////////////////////////////////////////////////////////////////////////
 ///
 /// \class ROOT::TThreadExecutor
@@ -72,6 +75,22 @@
 /// An integer can be passed as the fourth argument indicating the number of chunks we want to divide our work in.
 /// This may be useful to avoid the overhead introduced when running really short tasks.
 ///
+/// ### Partitioning of the work
+/// When no number of chunks is given, Foreach and Map partition the work
+/// automatically. The cost of an execution is first measured on the calling
+/// thread on a few executions, which sets the smallest chunk size worth a task
+/// (about 100 microseconds of work). The rest of the range is then split
+/// recursively into chunks not smaller than that, and idle threads steal
+/// halves of the ranges of busy ones, which balances heterogeneous executions.
+///
+/// All TThreadExecutors share the same pool of threads as the implicit
+/// multi-threading, so that an executor used from inside a task of another
+/// executor (or of an IMT task) does not spawn more threads. A loop run from
+/// an iteration of another TThreadExecutor loop is split in at most as many
+/// chunks as threads in the pool, since the outer loop already keeps them busy.
+/// Only the loops of TThreadExecutor are tracked: a loop run from an IMT task
+/// (e.g. TTaskGroup) is partitioned as a top level one.
+///
 /// #### Examples:
 /// ~~~{.cpp}
 /// root[] ROOT::TThreadExecutor pool; auto ten = pool.MapReduce([]() { return 1; }, 10, [](std::vector<int> v) { return std::accumulate(v.begin(), v.end(), 0); })
@@ -104,6 +123,24 @@ and transformations guarantee that each entry is processed from the beginning to
 the end without being interrupted by the processing of outer tasks.
 */
 
+namespace {
+
+/// Number of TThreadExecutor loops the calling thread is running an iteration of.
+thread_local unsigned gNestingLevel = 0;
+
+/// Mark the calling thread as running an iteration of a TThreadExecutor loop.
+struct TNestingGuard {
+   TNestingGuard() { ++gNestingLevel; }
+   ~TNestingGuard() { --gNestingLevel; }
+};
+
+/// Amount of work the automatically partitioned chunks aim at, in microseconds.
+constexpr double kTargetChunkTime = 100.;
+/// Time spent measuring the cost of the executions before going parallel, in microseconds.
+constexpr double kProbeTime = 20.;
+
+} // anonymous namespace
+
 namespace ROOT {
 namespace Internal {
 
@@ -147,7 +184,61 @@ namespace ROOT {
    void TThreadExecutor::ParallelFor(unsigned int start, unsigned int end, unsigned step, const std::function<void(unsigned int i)> &f)
    {
       tbb::this_task_arena::isolate([&]{
-         tbb::parallel_for(start, end, step, f);
+         tbb::parallel_for(start, end, step, [&](unsigned int i) {
+            TNestingGuard guard;
+            f(i);
+         });
+      });
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// Execute f on chunks of the range [0, nIterations), partitioned automatically.
+   /// The first iterations are run on the calling thread, doubling their number
+   /// until kProbeTime is reached, to measure their cost: this sets the grain
+   /// size, i.e. the smallest chunk worth a task. The rest of the range is then
+   /// split recursively, and stolen by idle threads, down to the grain size.
+   void TThreadExecutor::ParallelForRange(unsigned nIterations, const std::function<void(unsigned begin, unsigned end)> &f)
+   {
+      if (nIterations == 0)
+         return;
+
+      const unsigned poolSize = std::max(GetPoolSize(), 1U);
+      // Do not spend more than a small fraction of the range on the calling thread.
+      const unsigned maxProbe = nIterations / (8 * poolSize);
+      unsigned done = 0;
+      double elapsed = 0.;
+      for (unsigned probe = 1; done < maxProbe && elapsed < kProbeTime; probe *= 2) {
+         const unsigned n = std::min(probe, maxProbe - done);
+         const auto start = std::chrono::steady_clock::now();
+         {
+            TNestingGuard guard;
+            f(done, done + n);
+         }
+         elapsed += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+         done += n;
+      }
+
+      const unsigned remaining = nIterations - done;
+      if (remaining == 0)
+         return;
+      // Keep at least two chunks per thread to balance the load.
+      const unsigned maxGrain = std::max(remaining / (2 * poolSize), 1U);
+      unsigned grain = 1;
+      if (done > 0)
+         grain = elapsed > 0. ? std::min<double>(done * kTargetChunkTime / elapsed, maxGrain) : maxGrain;
+      grain = std::max(grain, 1U);
+      // A loop nested in a TThreadExecutor loop runs while the outer one keeps the pool busy:
+      // do not split it further than the pool size.
+      if (gNestingLevel > 0)
+         grain = std::max(grain, remaining / poolSize);
+
+      tbb::this_task_arena::isolate([&]{
+         tbb::parallel_for(tbb::blocked_range<unsigned>(done, nIterations, grain),
+                           [&](const tbb::blocked_range<unsigned> &r) {
+                              TNestingGuard guard;
+                              f(r.begin(), r.end());
+                           },
+                           tbb::auto_partitioner());
       });
    }
 
@@ -2,6 +2,10 @@
 #include "ROOT/TFuture.hxx"
 
 #include <future>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -50,4 +54,65 @@ TEST(TFuture, BuildFromAsync_void)
    f.get();
 }
 
+TEST(TFuture, Then)
+{
+   auto f = Async([]() { return 1; });
+   auto g = f.then([](int i) { return i + 1; }).then([](int i) { return std::to_string(i); });
+   EXPECT_FALSE(f.valid());
+   EXPECT_EQ("2", g.get());
+}
+
+TEST(TFuture, Then_void)
+{
+   int a(0);
+   auto f = Async([&a]() { a = 1; }).then([&a]() { return a + 1; }).then([&a](int i) { a = i; });
+   f.get();
+   EXPECT_EQ(2, a);
+}
+
+TEST(TFuture, Then_ref)
+{
+   int a(0);
+   auto f = Async([&a]() -> int & { return a; }).then([](int &r) -> int & { return ++r; });
+   EXPECT_EQ(&a, &f.get());
+   EXPECT_EQ(1, a);
+}
+
+TEST(TFuture, Then_exception)
+{
+   bool called = false;
+   auto f = Async([]() -> int { throw std::runtime_error("error"); }).then([&called](int i) {
+      called = true;
+      return i;
+   });
+   EXPECT_THROW(f.get(), std::runtime_error);
+   EXPECT_FALSE(called);
+}
+
+TEST(TFuture, ThenFromSTLFuture)
+{
+   TFuture<int> f = std::async([]() { return 1; });
+   EXPECT_EQ(2, f.then([](int i) { return i + 1; }).get());
+}
+
+TEST(TFuture, WhenAll)
+{
+   std::vector<TFuture<int>> futures;
+   for (int i = 0; i < 100; ++i)
+      futures.emplace_back(Async([i]() { return i; }).then([](int j) { return 2 * j; }));
+   futures.emplace_back(std::async([]() { return 1; }));
+   auto sum = WhenAll(std::move(futures)).then([](std::vector<TFuture<int>> &&ready) {
+      int total = 0;
+      for (auto &f : ready) {
+         EXPECT_TRUE(f.is_ready());
+         total += f.get();
+      }
+      return total;
+   });
+   EXPECT_EQ(2 * 99 * 100 / 2 + 1, sum.get());
+
+   auto none = WhenAll(std::vector<TFuture<int>>());
+   EXPECT_TRUE(none.get().empty());
+}
+
 #endif
@@ -0,0 +1,79 @@
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+TEST(TThreadExecutor, ManySmallTasks)
+{
+   ROOT::TThreadExecutor pool(4);
+   const unsigned nTimes = 1000000;
+   std::atomic<unsigned> counter(0);
+   pool.Foreach([&] { ++counter; }, nTimes);
+   EXPECT_EQ(nTimes, counter);
+
+   std::vector<unsigned> visits(nTimes, 0);
+   pool.Foreach([&](unsigned i) { ++visits[i]; }, ROOT::TSeqU(nTimes));
+   EXPECT_EQ(nTimes, std::accumulate(visits.begin(), visits.end(), 0U));
+   EXPECT_EQ(1U, *std::min_element(visits.begin(), visits.end()));
+}
+
+TEST(TThreadExecutor, MapSequence)
+{
+   ROOT::TThreadExecutor pool(4);
+   auto squares = pool.Map([](unsigned i) { return i * i; }, ROOT::TSeqU(10, 5000, 3));
+   ASSERT_EQ(ROOT::TSeqU(10, 5000, 3).size(), squares.size());
+   for (unsigned k = 0; k < squares.size(); ++k)
+      EXPECT_EQ((10 + 3 * k) * (10 + 3 * k), squares[k]);
+}
+
+TEST(TThreadExecutor, NestedExecution)
+{
+   ROOT::TThreadExecutor pool(4);
+   std::vector<unsigned> sums(64, 0);
+   pool.Foreach(
+      [&](unsigned i) {
+         ROOT::TThreadExecutor inner(4);
+         auto values = inner.Map([](unsigned j) { return j; }, ROOT::TSeqU(1000));
+         sums[i] = std::accumulate(values.begin(), values.end(), 0U);
+      },
+      ROOT::TSeqU(sums.size()));
+   for (auto sum : sums)
+      EXPECT_EQ(499500U, sum);
+}
+
+TEST(TThreadExecutor, MapReduceCallsVectorReducerOnce)
+{
+   ROOT::TThreadExecutor pool(4);
+   unsigned nCalls = 0;
+   std::size_t nReduced = 0;
+   // As in mtbb201_parallelHistoFill.C, the reducer may have side effects
+   // and is not safe to run concurrently: it must see all the results at once.
+   auto redfunc = [&](const std::vector<unsigned> &v) {
+      ++nCalls;
+      nReduced = v.size();
+      return std::accumulate(v.begin(), v.end(), 0U);
+   };
+   for (unsigned nTimes : {1U, 2U, 3U, 7U, 100U, 10001U}) {
+      nCalls = 0;
+      auto sum = pool.MapReduce([](unsigned i) { return i; }, ROOT::TSeqU(nTimes), redfunc, 0);
+      EXPECT_EQ(nTimes * (nTimes - 1) / 2, sum);
+      EXPECT_EQ(1U, nCalls);
+      EXPECT_EQ(nTimes, nReduced);
+
+      nCalls = 0;
+      auto count = pool.MapReduce([] { return 1U; }, nTimes, redfunc);
+      EXPECT_EQ(nTimes, count);
+      EXPECT_EQ(1U, nCalls);
+      EXPECT_EQ(nTimes, nReduced);
+   }
+}
+
+#endif
@@ -66,6 +66,7 @@ In order to access the name of a class within the ROOT type system, the method T
 #include "TROOT.h"
 #include "TRealData.h"
 #include "TCheckHashRecursiveRemoveConsistency.h" // Private header
+#include "TClassLookupCache.h" // Private header
 #include "TStreamer.h"
 #include "TStreamerElement.h"
 #include "TVirtualStreamerInfo.h"
@@ -433,6 +434,25 @@ IdMap_t *TClass::GetIdMap() {
 #endif
 }
 
+namespace {
+
+/// The cache of the lookups of loaded classes by name.
+ROOT::Internal::TClassLookupCache &GetNameLookupCache()
+{
+   // Never deleted: the TClasses are removed from it until the very end of the process.
+   static auto cache = new ROOT::Internal::TClassLookupCache();
+   return *cache;
+}
+
+/// The cache of the lookups of loaded classes by std::type_info name.
+ROOT::Internal::TClassLookupCache &GetTypeInfoLookupCache()
+{
+   static auto cache = new ROOT::Internal::TClassLookupCache();
+   return *cache;
+}
+
+} // anonymous namespace
+
 DeclIdMap_t *TClass::GetDeclIdMap() {
 
 #ifdef R__COMPLETE_MEM_TERMINATION
@@ -479,6 +499,8 @@ void TClass::RemoveClass(TClass *oldcl)
 
    R__LOCKGUARD(gInterpreterMutex);
    gROOT->GetListOfClasses()->Remove(oldcl);
+   GetNameLookupCache().Remove(oldcl);
+   GetTypeInfoLookupCache().Remove(oldcl);
    if (oldcl->GetTypeInfo()) {
       GetIdMap()->Remove(oldcl->GetTypeInfo()->name());
    }
@@ -2898,6 +2920,22 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
 
    if (!gROOT->GetListOfClasses())  return 0;
 
+   // Classes with a dictionary which were already looked up under this name
+   // are found without taking any lock.
+   TClass *cl = GetNameLookupCache().Find(name);
+   if (cl && cl->IsLoaded()) return cl;
+
+   cl = GetClassImpl(name, load, silent);
+   if (cl && cl->IsLoaded()) GetNameLookupCache().Insert(name, cl);
+   return cl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of GetClass(const char*, Bool_t, Bool_t), not going through
+/// the lookup cache.
+
+TClass *TClass::GetClassImpl(const char *name, Bool_t load, Bool_t silent)
+{
    // FindObject will take the read lock before actually getting the
    // TClass pointer so we will need not get a partially initialized
    // object.
@@ -3107,11 +3145,26 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
 ////////////////////////////////////////////////////////////////////////////////
 /// Return pointer to class with name.
 
-TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /* silent */)
+TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t silent)
 {
    if (!gROOT->GetListOfClasses())
       return 0;
 
+   // The loaded classes which were already looked up are found without taking any lock.
+   TClass *cl = GetTypeInfoLookupCache().Find(typeinfo.name());
+   if (cl && cl->IsLoaded()) return cl;
+
+   cl = GetClassImpl(typeinfo, load, silent);
+   if (cl && cl->IsLoaded()) GetTypeInfoLookupCache().Insert(typeinfo.name(), cl);
+   return cl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of GetClass(const std::type_info&, Bool_t, Bool_t), not going
+/// through the lookup cache.
+
+TClass *TClass::GetClassImpl(const std::type_info& typeinfo, Bool_t load, Bool_t /* silent */)
+{
    //protect access to TROOT::GetIdMap
    R__READ_LOCKGUARD(ROOT::gCoreMutex);
 
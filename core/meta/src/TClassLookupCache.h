@@ -0,0 +1,160 @@
+// @(#)root/meta:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TClassLookupCache
+#define ROOT_TClassLookupCache
+
+#include "TString.h"
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class TClass;
+
+namespace ROOT {
+namespace Internal {
+
+/**
+ * \class TClassLookupCache
+ * \ingroup Base
+ *
+ * A concurrent map from a string (a class name as requested by the user or
+ * the name of a std::type_info) to the loaded TClass it resolves to.
+ *
+ * Lookups do not take any lock: they probe an open addressing table whose
+ * entries are only ever filled, never moved. Insertions and removals are
+ * serialized by a mutex. When the table gets half full, it is replaced by a
+ * table twice as large; the old tables and the key strings are kept alive,
+ * since a reader may still be probing them. A removal only resets the TClass
+ * of the entries pointing to it, so that the entry can be reused if the name
+ * resolves to a class again.
+ */
+
+class TClassLookupCache {
+private:
+   struct TEntry {
+      std::atomic<const char *> fKey{nullptr}; ///< Published last, once fHash and fClass are set
+      std::atomic<TClass *> fClass{nullptr};   ///< nullptr if the class was removed
+      UInt_t fHash = 0;                        ///< Hash of fKey
+   };
+
+   struct TTable {
+      const UInt_t fMask;                     ///< Number of entries minus one (a power of two)
+      std::unique_ptr<TEntry[]> fEntries;     ///< The entries, probed linearly
+      UInt_t fSize = 0;                       ///< Number of keys, accessed under the writer mutex
+
+      TTable(UInt_t capacity) : fMask(capacity - 1), fEntries(new TEntry[capacity]) {}
+   };
+
+   std::atomic<TTable *> fTable;                                 ///< The current table
+   std::mutex fWriteMutex;                                       ///< Serializes the modifications
+   std::vector<std::unique_ptr<TTable>> fTables;                 ///< All the tables, including the retired ones
+   std::vector<std::unique_ptr<char[]>> fKeys;                   ///< Storage of the key strings
+   std::unordered_multimap<const TClass *, TEntry *> fClassEntries; ///< Entries of the current table, by class
+
+   /// Return the entry of key in table, or the empty entry where it belongs.
+   static TEntry &Probe(TTable &table, const char *key, UInt_t hash)
+   {
+      for (UInt_t i = hash & table.fMask;; i = (i + 1) & table.fMask) {
+         TEntry &entry = table.fEntries[i];
+         const char *entryKey = entry.fKey.load(std::memory_order_acquire);
+         if (!entryKey || (entry.fHash == hash && strcmp(entryKey, key) == 0))
+            return entry;
+      }
+   }
+
+   /// Fill an empty entry; must be called with the writer mutex held.
+   void Publish(TEntry &entry, const char *key, UInt_t hash, TClass *cl)
+   {
+      entry.fHash = hash;
+      entry.fClass.store(cl, std::memory_order_relaxed);
+      entry.fKey.store(key, std::memory_order_release);
+      fClassEntries.emplace(cl, &entry);
+   }
+
+   /// Replace the table by one twice as large; must be called with the writer mutex held.
+   void Grow()
+   {
+      TTable &old = *fTable.load(std::memory_order_relaxed);
+      fTables.emplace_back(new TTable(2 * (old.fMask + 1)));
+      TTable &table = *fTables.back();
+      fClassEntries.clear();
+      for (UInt_t i = 0; i <= old.fMask; ++i) {
+         const char *key = old.fEntries[i].fKey.load(std::memory_order_relaxed);
+         TClass *cl = old.fEntries[i].fClass.load(std::memory_order_relaxed);
+         if (!key || !cl)
+            continue;
+         Publish(Probe(table, key, old.fEntries[i].fHash), key, old.fEntries[i].fHash, cl);
+         ++table.fSize;
+      }
+      fTable.store(&table, std::memory_order_release);
+   }
+
+public:
+   TClassLookupCache(UInt_t capacity = 1024)
+   {
+      fTables.emplace_back(new TTable(capacity));
+      fTable.store(fTables.back().get());
+   }
+
+   TClassLookupCache(const TClassLookupCache &) = delete;
+   TClassLookupCache &operator=(const TClassLookupCache &) = delete;
+
+   /// Return the TClass cached for key, or nullptr. Does not take any lock.
+   TClass *Find(const char *key) const
+   {
+      TTable &table = *fTable.load(std::memory_order_acquire);
+      return Probe(table, key, TString::Hash(key, strlen(key))).fClass.load(std::memory_order_acquire);
+   }
+
+   /// Cache cl as the result of the lookup of key.
+   void Insert(const char *key, TClass *cl)
+   {
+      if (!cl)
+         return;
+      const UInt_t hash = TString::Hash(key, strlen(key));
+      std::lock_guard<std::mutex> lock(fWriteMutex);
+      TTable *table = fTable.load(std::memory_order_relaxed);
+      TEntry &entry = Probe(*table, key, hash);
+      if (entry.fKey.load(std::memory_order_relaxed)) {
+         TClass *previous = entry.fClass.exchange(cl, std::memory_order_release);
+         if (previous != cl)
+            fClassEntries.emplace(cl, &entry);
+         return;
+      }
+      const size_t len = strlen(key) + 1;
+      fKeys.emplace_back(new char[len]);
+      memcpy(fKeys.back().get(), key, len);
+      Publish(entry, fKeys.back().get(), hash, cl);
+      if (2 * ++table->fSize > table->fMask)
+         Grow();
+   }
+
+   /// Forget all the lookups resolving to cl.
+   void Remove(const TClass *cl)
+   {
+      std::lock_guard<std::mutex> lock(fWriteMutex);
+      auto range = fClassEntries.equal_range(cl);
+      for (auto it = range.first; it != range.second; ++it) {
+         TClass *expected = const_cast<TClass *>(cl);
+         it->second->fClass.compare_exchange_strong(expected, nullptr, std::memory_order_release);
+      }
+      fClassEntries.erase(range.first, range.second);
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -1,9 +1,16 @@
 #include "TClass.h"
 #include "THashTable.h"
 #include "TInterpreter.h"
+#include "TNamed.h"
+#include "TROOT.h"
 
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
 TEST(TClass, DictCheck)
 {
    gInterpreter->ProcessLine(".L stlDictCheck.h+");
@@ -22,3 +29,32 @@ TEST(TClass, DictCheck)
 
    EXPECT_STREQ(errMsg.c_str(), "Missing dictionary for C, ") << errMsg;
 }
+
+TEST(TClass, ConcurrentGetClass)
+{
+   ROOT::EnableThreadSafety();
+   const std::vector<std::string> names{"TObject", "TNamed", "class TNamed", "TList", "TString"};
+   std::vector<TClass *> expected;
+   for (auto &name : names)
+      expected.push_back(TClass::GetClass(name.c_str()));
+   EXPECT_EQ(TNamed::Class(), expected[1]);
+   EXPECT_EQ(expected[1], expected[2]);
+
+   std::vector<std::thread> threads;
+   std::atomic<int> nErrors(0);
+   for (int t = 0; t < 8; ++t) {
+      threads.emplace_back([&]() {
+         for (int i = 0; i < 1000; ++i) {
+            for (unsigned n = 0; n < names.size(); ++n) {
+               if (TClass::GetClass(names[n].c_str()) != expected[n])
+                  ++nErrors;
+            }
+            if (TClass::GetClass(typeid(TNamed)) != TNamed::Class())
+               ++nErrors;
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   EXPECT_EQ(0, nErrors);
+}
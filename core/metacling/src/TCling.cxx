@@ -75,6 +75,7 @@ clang/LLVM technology.
 #include "TFile.h"
 #include "TKey.h"
 #include "ClingRAII.h"
+#include "ROOT/TStartupProfile.hxx"
 
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/Decl.h"
@@ -1227,6 +1228,8 @@ TCling::TCling(const char *name, const char *title, const char* const argv[])
    fClingCallbacks(0), fAutoLoadCallBack(0),
    fTransactionCount(0), fHeaderParsingOnDemand(true), fIsAutoParsingSuspended(kFALSE)
 {
+   ROOT::Internal::TStartupTimer startupTimer("TCling::TCling");
+
    const bool fromRootCling = IsFromRootCling();
 
    fCxxModulesEnabled = false;
@@ -1388,6 +1391,7 @@ TCling::TCling(const char *name, const char *title, const char* const argv[])
    fMore      = 0;
    fPrompt[0] = 0;
    fMapfile   = 0;
+   fLibraryMapDeferred = false;
 //    fMapNamespaces   = 0;
    fRootmapFiles = 0;
    fLockProcessLine = kTRUE;
@@ -1645,6 +1649,8 @@ bool TCling::LoadPCMImpl(TFile &pcmFile)
 
 bool TCling::LoadPCM(const std::string &pcmFileNameFullPath)
 {
+   ROOT::Internal::TStartupTimer startupTimer("TCling::LoadPCM");
+
    SuspendAutoloadingRAII autoloadOff(this);
    SuspendAutoParsing autoparseOff(this);
    assert(!pcmFileNameFullPath.empty());
@@ -1786,6 +1792,8 @@ void TCling::RegisterModule(const char* modulename,
    // I/O; see rootcling.cxx after the call to TCling__GetInterpreter().
    if (fromRootCling) return;
 
+   ROOT::Internal::TStartupTimer startupTimer("TCling::RegisterModule");
+
    // When we cannot provide a module for the library we should enable header
    // parsing. This 'mixed' mode ensures gradual migration to modules.
    llvm::SaveAndRestore<bool> SaveHeaderParsing(fHeaderParsingOnDemand);
@@ -2821,13 +2829,20 @@ bool TCling::Declare(const char* code)
 /// is used that is stored in a not yet loaded library. Uses the
 /// information stored in the class/library map (typically
 /// $ROOTSYS/etc/system.rootmap).
+///
+/// If Root.LazyLibraryMap is set, the rootmap files found along the dynamic
+/// path are not read now but the first time the library of a class is
+/// looked up, see LoadDeferredLibraryMap().
 
 void TCling::EnableAutoLoading()
 {
    if (IsFromRootCling())
       return;
 
-   LoadLibraryMap();
+   if (gEnv->GetValue("Root.LazyLibraryMap", 0))
+      fLibraryMapDeferred = true;
+   else
+      LoadLibraryMap();
    SetClassAutoloading(true);
 }
 
@@ -5268,6 +5283,14 @@ Int_t TCling::LoadLibraryMap(const char* rootmapfile)
 
    R__LOCKGUARD(gInterpreterMutex);
 
+   ROOT::Internal::TStartupTimer startupTimer("TCling::LoadLibraryMap");
+
+   // A request for a specific rootmap file does not trigger the deferred scan
+   // of the dynamic path; any other request does.
+   const bool scanPath = !(rootmapfile && *rootmapfile && fLibraryMapDeferred);
+   if (scanPath)
+      fLibraryMapDeferred = false;
+
    // open the [system].rootmap files
    if (!fMapfile) {
       fMapfile = new TEnv();
@@ -5287,7 +5310,7 @@ Int_t TCling::LoadLibraryMap(const char* rootmapfile)
    // Load all rootmap files in the dynamic load path ((DY)LD_LIBRARY_PATH, etc.).
    // A rootmap file must end with the string ".rootmap".
    TString ldpath = gSystem->GetDynamicPath();
-   if (ldpath != fRootmapLoadPath) {
+   if (scanPath && ldpath != fRootmapLoadPath) {
       fRootmapLoadPath = ldpath;
 #ifdef WIN32
       TObjArray* paths = ldpath.Tokenize(";");
@@ -5450,6 +5473,22 @@ Int_t TCling::LoadLibraryMap(const char* rootmapfile)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the rootmap files found along the dynamic path if EnableAutoLoading()
+/// deferred it (Root.LazyLibraryMap), i.e. the first time the library map is
+/// needed to find the library of a class.
+
+void TCling::LoadDeferredLibraryMap()
+{
+   if (!fLibraryMapDeferred)
+      return;
+   R__LOCKGUARD(gInterpreterMutex);
+   // The forward declarations of the rootmap files must not trigger autoloading.
+   SuspendAutoloadingRAII autoloadOff(this);
+   if (fLibraryMapDeferred)
+      LoadLibraryMap(nullptr);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Scan again along the dynamic path for library maps. Entries for the loaded
 /// shared libraries are unloaded first. This can be useful after reseting
@@ -5549,6 +5588,7 @@ Int_t TCling::UnloadAllSharedLibraryMaps()
 
 Int_t TCling::UnloadLibraryMap(const char* library)
 {
+   LoadDeferredLibraryMap();
    if (!fMapfile || !library || !*library) {
       return 0;
    }
@@ -5623,6 +5663,7 @@ Int_t TCling::SetClassSharedLibs(const char *cls, const char *libs)
    key.ReplaceAll(" ", "-");
 
    R__LOCKGUARD(gInterpreterMutex);
+   LoadDeferredLibraryMap();
    if (!fMapfile) {
       fMapfile = new TEnv();
       fMapfile->IgnoreDuplicates(kTRUE);
@@ -5731,6 +5772,10 @@ Int_t TCling::AutoLoad(const char *cls, Bool_t knowDictNotLoaded /* = kFALSE */)
       }
       return 0;
    }
+   if (fLibraryMapDeferred) {
+      ROOT::Internal::ParsingStateRAII parsingStateRAII(fInterpreter->getParser(), fInterpreter->getSema());
+      LoadDeferredLibraryMap();
+   }
    // Prevent the recursion when the library dictionary are loaded.
    SuspendAutoloadingRAII autoLoadOff(this);
    // Try using externally provided callback first.
@@ -5977,6 +6022,13 @@ Int_t TCling::AutoParse(const char *cls)
 {
    R__LOCKGUARD(gInterpreterMutex);
 
+   // The lookup of an unknown name is the first use of the library map when
+   // Root.LazyLibraryMap is set: declare what the rootmap files forward declare.
+   if (fLibraryMapDeferred) {
+      ROOT::Internal::ParsingStateRAII parsingStateRAII(fInterpreter->getParser(), fInterpreter->getSema());
+      LoadDeferredLibraryMap();
+   }
+
    if (!fHeaderParsingOnDemand || fIsAutoParsingSuspended) {
       if (fClingCallbacks->IsAutoloadingEnabled()) {
          return AutoLoad(cls);
@@ -6875,6 +6927,7 @@ const char* TCling::GetClassSharedLibs(const char* cls)
    if (!cls || !*cls) {
       return 0;
    }
+   LoadDeferredLibraryMap();
    // lookup class to find list of libraries
    if (fMapfile) {
       TEnvRec* libs_record = 0;
@@ -6914,6 +6967,7 @@ const char* TCling::GetClassSharedLibs(const char* cls)
 
 const char* TCling::GetSharedLibDeps(const char* lib)
 {
+   LoadDeferredLibraryMap();
    if (!fMapfile || !lib || !lib[0]) {
       return 0;
    }
@@ -26,6 +26,7 @@
 
 #include "TInterpreter.h"
 
+#include <atomic>
 #include <set>
 #include <unordered_set>
 #include <unordered_map>
@@ -104,6 +105,7 @@ private: // Data Members
    TString         fIncludePath;      // Interpreter include path.
    TString         fRootmapLoadPath;  // Dynamic load path for rootmap files.
    TEnv*           fMapfile;          // Association of classes to libraries.
+   std::atomic<bool> fLibraryMapDeferred; // True if the library maps are to be read on first use (Root.LazyLibraryMap).
    std::vector<std::string> fAutoLoadLibStorage; // A storage to return a const char* from GetClassSharedLibsForModule.
    std::map<size_t,std::vector<const char*>> fClassesHeadersMap; // Map of classes hashes and headers associated
    std::map<const cling::Transaction*,size_t> fTransactionHeadersMap; // Map which transaction contains which autoparse.
@@ -193,7 +195,8 @@ public: // Public Interface
    void    EndOfLineAction();
    TClass *GetClass(const std::type_info& typeinfo, Bool_t load) const;
    Int_t   GetExitCode() const { return fExitCode; }
-   TEnv*   GetMapfile() const { return fMapfile; }
+   // Reading the deferred library map does not change the logical state of the interpreter.
+   TEnv*   GetMapfile() const { const_cast<TCling*>(this)->LoadDeferredLibraryMap(); return fMapfile; }
    Int_t   GetMore() const { return fMore; }
    TClass *GenerateTClass(const char *classname, Bool_t emulation, Bool_t silent = kFALSE);
    TClass *GenerateTClass(ClassInfo_t *classinfo, Bool_t silent = kFALSE);
@@ -204,7 +207,7 @@ public: // Public Interface
    const char* GetSharedLibDeps(const char* lib);
    const char* GetIncludePath();
    virtual const char* GetSTLIncludePath() const;
-   TObjArray*  GetRootMapFiles() const { return fRootmapFiles; }
+   TObjArray*  GetRootMapFiles() const { const_cast<TCling*>(this)->LoadDeferredLibraryMap(); return fRootmapFiles; }
    unsigned long long GetInterpreterStateMarker() const { return fTransactionCount;}
    virtual void Initialize();
    virtual void ShutDown();
@@ -589,6 +592,7 @@ private: // Private Utility Functions and Classes
 
    void InitRootmapFile(const char *name);
    int  ReadRootmapFile(const char *rootmapfile, TUniqueString* uniqueString = nullptr);
+   void LoadDeferredLibraryMap();
    Bool_t HandleNewTransaction(const cling::Transaction &T);
    void UnloadClassMembers(TClass* cl, const clang::DeclContext* DC);
    bool IsClassAutoloadingEnabled() const;
@@ -1,5 +1,6 @@
 #include "TClass.h"
 #include "TInterpreter.h"
+#include "TROOT.h"
 #include "TSystem.h"
 
 #include "llvm/ADT/StringRef.h"
@@ -8,6 +9,8 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
+#include <fstream>
+
 // Copied from TFileMergerTests.cxx.
 // FIXME: Factor out in a new testing library in ROOT.
 namespace {
@@ -179,3 +182,33 @@ TEST_F(TClingTests, GetClassSharedLibs)
    //    != GetLibs("ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<float>>")
    // note the missing space.
 }
+
+// With Root.LazyLibraryMap the rootmap files are only read when an unknown
+// name is looked up: its forward declaration and the autoloading of its
+// library must work as without it. The setting is read when the interpreter
+// starts, so the check runs in a new process with its own .rootrc.
+TEST_F(TClingTests, LazyLibraryMap)
+{
+#if defined(R__USE_CXXMODULES) || defined(R__WIN32)
+   // Modules do not use the rootmap files.
+   return;
+#endif
+   const char *dir = "lazylibrarymap";
+   gSystem->mkdir(dir);
+   {
+      std::ofstream rootrc(TString::Format("%s/.rootrc", dir).Data());
+      rootrc << "Root.LazyLibraryMap: 1" << std::endl;
+   }
+   const TString cmd = TString::Format(
+      "cd %s && ROOT_STARTUP_PROFILE=1 %s/root.exe -l -b -q -e "
+      "'TH1F h(\"h\", \"\", 3, 0., 1.); "
+      "printf(\"nbins %%d rootmaps %%d\\n\", h.GetNbinsX(), gInterpreter->GetRootMapFiles()->GetEntries() > 0);' 2>&1",
+      dir, TROOT::GetBinDir().Data());
+   const TString out = gSystem->GetFromPipe(cmd);
+   EXPECT_TRUE(out.Contains("nbins 3 rootmaps 1")) << out;
+   // The profile shows when the map was read.
+   EXPECT_TRUE(out.Contains("TCling::LoadLibraryMap")) << out;
+
+   gSystem->Unlink(TString::Format("%s/.rootrc", dir));
+   gSystem->Unlink(dir);
+}
@@ -38,6 +38,10 @@ using MPCodeBufPair = std::pair<unsigned, std::unique_ptr<TBufferFile>>;
 // to send a code and an object of any non-pointer type.
 int MPSend(TSocket *s, unsigned code);
 
+// Send a code and an object already streamed into objBuf; used by the
+// templated versions below for the objects that can be large.
+int MPSendObjBuf(TSocket *s, unsigned code, const TBufferFile &objBuf);
+
 template<class T, typename std::enable_if<std::is_class<T>::value>::type * = nullptr>
 int MPSend(TSocket *s, unsigned code, T obj);
 
@@ -97,11 +101,7 @@ int MPSend(TSocket *s, unsigned code, T obj)
    }
    TBufferFile objBuf(TBuffer::kWrite);
    objBuf.WriteObjectAny(&obj, c);
-   TBufferFile wBuf(TBuffer::kWrite);
-   wBuf.WriteUInt(code);
-   wBuf.WriteULong(objBuf.Length());
-   wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
-   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   return MPSendObjBuf(s, code, objBuf);
 }
 
 /// \cond
@@ -136,14 +136,7 @@ int MPSend(TSocket *s, unsigned code, T obj)
    TBufferFile objBuf(TBuffer::kWrite);
    if(obj != nullptr)
       objBuf.WriteObjectAny(obj, obj->IsA());
-
-   //write everything together in a buffer
-   TBufferFile wBuf(TBuffer::kWrite);
-   wBuf.WriteUInt(code);
-   wBuf.WriteULong(objBuf.Length());
-   if(objBuf.Length())
-      wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
-   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   return MPSendObjBuf(s, code, objBuf);
 }
 
 /// \endcond
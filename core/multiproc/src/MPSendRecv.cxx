@@ -11,8 +11,190 @@
  
 #include "MPSendRecv.h"
 #include "TBufferFile.h"
+#include "TEnv.h"
+#include "TSystem.h"
 #include "MPCode.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
 #include <memory> //unique_ptr
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+
+//////////////////////////////////////////////////////////////////////////
+/// Flag or-ed to the code of a message whose object was written to a
+/// shared memory file: the message then only carries the size of the
+/// object and the name of the file.
+constexpr unsigned kSharedMemFlag = 1u << 31;
+
+//////////////////////////////////////////////////////////////////////////
+/// A TBufferFile reading an object from a shared memory file mapped in
+/// memory; the mapping is released with the buffer.
+class TMPSharedBuffer : public TBufferFile {
+private:
+   void *fAddr;
+   size_t fLen;
+
+public:
+   TMPSharedBuffer(void *addr, size_t len) : TBufferFile(TBuffer::kRead, len, addr, false), fAddr(addr), fLen(len) {}
+   ~TMPSharedBuffer() { munmap(fAddr, fLen); }
+};
+
+//////////////////////////////////////////////////////////////////////////
+/// Size (in bytes) from which objects are passed through a shared memory
+/// file rather than through the socket; negative if disabled.
+/// Set by `MultiProc.SharedMemThreshold` in `.rootrc`.
+Long64_t GetSharedMemThreshold()
+{
+   return gEnv->GetValue("MultiProc.SharedMemThreshold", 1048576.);
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Write len bytes of buf to a new, unnamed file in shared memory (/dev/shm
+/// if available, the temporary directory otherwise): the file is removed as
+/// soon as it is created and lives as long as a descriptor refers to it.
+/// Return a descriptor of the file, or -1 if it could not be written.
+int WriteSharedFile(const char *buf, size_t len)
+{
+   static std::atomic<unsigned> counter{0};
+   const char *dir = gSystem->AccessPathName("/dev/shm", kWritePermission) ? gSystem->TempDirectory() : "/dev/shm";
+   std::string name =
+      TString::Format("%s/rootmp_%d_%u", dir, gSystem->GetPid(), counter++).Data();
+
+   int fd = open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+   if (fd < 0)
+      return -1;
+   unlink(name.c_str());
+   size_t written = 0;
+   while (written < len) {
+      ssize_t n = write(fd, buf + written, len - written);
+      if (n < 0 && errno == EINTR)
+         continue;
+      if (n <= 0)
+         break;
+      written += n;
+   }
+   if (written < len) {
+      close(fd);
+      return -1;
+   }
+   return fd;
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Return true if sock is a unix socket, which can pass descriptors.
+bool IsUnixSocket(int sock)
+{
+   sockaddr_storage addr;
+   socklen_t len = sizeof(addr);
+   return getsockname(sock, (sockaddr *)&addr, &len) == 0 && addr.ss_family == AF_UNIX;
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Send len bytes of buf on the unix socket sock, together with a copy of
+/// the descriptor fd. Return the number of bytes sent, -1 on failure.
+int SendWithDescriptor(int sock, const char *buf, size_t len, int fd)
+{
+   char control[CMSG_SPACE(sizeof(int))];
+   memset(control, 0, sizeof(control));
+   iovec iov;
+   iov.iov_base = const_cast<char *>(buf);
+   iov.iov_len = len;
+   msghdr msg;
+   memset(&msg, 0, sizeof(msg));
+   msg.msg_iov = &iov;
+   msg.msg_iovlen = 1;
+   msg.msg_control = control;
+   msg.msg_controllen = sizeof(control);
+   cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+   cmsg->cmsg_level = SOL_SOCKET;
+   cmsg->cmsg_type = SCM_RIGHTS;
+   cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+   memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+
+   // The descriptor goes with the first byte; the rest, if any, is sent as usual.
+   ssize_t n;
+   while ((n = sendmsg(sock, &msg, 0)) < 0 && errno == EINTR)
+      ;
+   if (n <= 0)
+      return -1;
+   size_t sent = n;
+   while (sent < len) {
+      n = send(sock, buf + sent, len - sent, 0);
+      if (n < 0 && errno == EINTR)
+         continue;
+      if (n <= 0)
+         return -1;
+      sent += n;
+   }
+   return sent;
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Receive len bytes in buf from the unix socket sock, and the descriptor
+/// sent with them by SendWithDescriptor(). Return the descriptor, -1 on
+/// failure.
+int RecvWithDescriptor(int sock, char *buf, size_t len)
+{
+   char control[CMSG_SPACE(sizeof(int))];
+   iovec iov;
+   iov.iov_base = buf;
+   iov.iov_len = len;
+   msghdr msg;
+   memset(&msg, 0, sizeof(msg));
+   msg.msg_iov = &iov;
+   msg.msg_iovlen = 1;
+   msg.msg_control = control;
+   msg.msg_controllen = sizeof(control);
+
+   ssize_t n;
+   while ((n = recvmsg(sock, &msg, 0)) < 0 && errno == EINTR)
+      ;
+   if (n <= 0)
+      return -1;
+   int fd = -1;
+   for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+         memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+   }
+   size_t received = n;
+   while (received < len) {
+      n = recv(sock, buf + received, len - received, 0);
+      if (n < 0 && errno == EINTR)
+         continue;
+      if (n <= 0) {
+         if (fd >= 0)
+            close(fd);
+         return -1;
+      }
+      received += n;
+   }
+   return fd;
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Map the shared memory file fd, of size len, in memory and close fd.
+/// Return a buffer reading from the mapping, or nullptr on failure.
+std::unique_ptr<TBufferFile> MapSharedFile(int fd, size_t len)
+{
+   // A private mapping, so that the buffer can be modified like one read from the socket.
+   void *addr = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (addr == MAP_FAILED) {
+      Error("MPRecv", "[E] Could not map shared memory file: %s", strerror(errno));
+      return nullptr;
+   }
+   return std::unique_ptr<TBufferFile>(new TMPSharedBuffer(addr, len));
+}
+
+} // anonymous namespace
 
 //////////////////////////////////////////////////////////////////////////
 /// Send a message with the specified code on the specified socket.
@@ -38,6 +220,46 @@ int MPSend(TSocket *s, unsigned code)
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+/// Send a message with the specified code and the object streamed into
+/// objBuf on the specified socket.
+/// Objects larger than `MultiProc.SharedMemThreshold` bytes (1 MB by
+/// default, negative to disable) are not copied through the socket:
+/// they are written to an unnamed file in shared memory, whose descriptor
+/// is passed with the message. MPRecv() maps the file in memory, so that
+/// large results (histograms, output lists) are read in place. The file
+/// has no name: it is gone once both processes closed it, even if the
+/// message is never read.
+/// \param s a pointer to a valid TSocket. No validity checks are performed\n
+/// \param code the code to be sent
+/// \param objBuf the buffer the object was written to
+/// \return the number of bytes sent, as per TSocket::SendRaw
+int MPSendObjBuf(TSocket *s, unsigned code, const TBufferFile &objBuf)
+{
+   TBufferFile wBuf(TBuffer::kWrite);
+   const Long64_t threshold = GetSharedMemThreshold();
+   if (objBuf.Length() && threshold >= 0 && objBuf.Length() >= threshold && IsUnixSocket(s->GetDescriptor())) {
+      int fd = WriteSharedFile(objBuf.Buffer(), objBuf.Length());
+      if (fd >= 0) {
+         wBuf.WriteUInt(code | kSharedMemFlag);
+         wBuf.WriteULong(sizeof(ULong64_t));
+         const int nHeader = s->SendRaw(wBuf.Buffer(), wBuf.Length());
+         TBufferFile sizeBuf(TBuffer::kWrite);
+         sizeBuf.WriteULong64(objBuf.Length());
+         const int nSize = nHeader > 0 ? SendWithDescriptor(s->GetDescriptor(), sizeBuf.Buffer(), sizeBuf.Length(), fd) : -1;
+         close(fd);
+         return nSize > 0 ? nHeader + nSize : -1;
+      }
+      // Could not write the file: fall back to the socket.
+   }
+   wBuf.WriteUInt(code);
+   wBuf.WriteULong(objBuf.Length());
+   if (objBuf.Length())
+      wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
+   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 /// Receive message from a socket.
 /// This standalone function can be used to read a message that
@@ -49,6 +271,8 @@ int MPSend(TSocket *s, unsigned code)
 /// * non-pointer built-in types: TBufferFile::operator>> must be used\n
 /// * c-strings: TBufferFile::ReadString must be used\n
 /// * class types: TBufferFile::ReadObjectAny must be used\n
+/// Objects sent through shared memory (see MPSendObjBuf()) are read from
+/// the mapped file directly.\n
 /// \param s a pointer to a valid TSocket. No validity checks are performed\n
 /// \return ::MPCodeBufPair, i.e. an std::pair containing message code and (possibly) object
 MPCodeBufPair MPRecv(TSocket *s)
@@ -74,6 +298,36 @@ MPCodeBufPair MPRecv(TSocket *s)
    bufReader.ReadULong(classBufSize);
    delete [] rawbuf;
 
+   //the object is in a shared memory file: the message holds its size and descriptor
+   if (code & kSharedMemFlag) {
+      code &= ~kSharedMemFlag;
+      char sizeBuf[sizeof(ULong64_t)];
+      if (classBufSize != sizeof(sizeBuf)) {
+         // Malformed message: consume its payload, not to desynchronize the stream.
+         Error("MPRecv", "[E] Unexpected size %lu of the shared memory header of a message", classBufSize);
+         char discard[4096];
+         for (ULong_t left = classBufSize; left > 0;) {
+            const Int_t n = left < sizeof(discard) ? (Int_t)left : (Int_t)sizeof(discard);
+            if (s->RecvRaw(discard, n) <= 0)
+               break;
+            left -= n;
+         }
+         return std::make_pair(MPCode::kRecvError, nullptr);
+      }
+      int fd = RecvWithDescriptor(s->GetDescriptor(), sizeBuf, sizeof(sizeBuf));
+      if (fd < 0) {
+         Error("MPRecv", "[E] Could not receive the shared memory file of a message");
+         return std::make_pair(MPCode::kRecvError, nullptr);
+      }
+      TBufferFile sizeReader(TBuffer::kRead, sizeof(sizeBuf), sizeBuf, false);
+      ULong64_t objSize;
+      sizeReader.ReadULong64(objSize);
+      std::unique_ptr<TBufferFile> objBuf = MapSharedFile(fd, objSize);
+      if (!objBuf)
+         return std::make_pair(MPCode::kRecvError, nullptr);
+      return std::make_pair(code, std::move(objBuf));
+   }
+
    //receive object if needed
    std::unique_ptr<TBufferFile> objBuf; //defaults to nullptr
    if (classBufSize != 0) {
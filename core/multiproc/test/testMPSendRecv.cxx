@@ -0,0 +1,98 @@
+#include "MPCode.h"
+#include "MPSendRecv.h"
+#include "TBufferFile.h"
+#include "TEnv.h"
+#include "TNamed.h"
+#include "TSocket.h"
+#include "TString.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+
+#include <sys/socket.h>
+
+// Number of shared memory files of this process left in the directories
+// where MPSendObjBuf creates them.
+static int CountSharedFiles()
+{
+   const TString prefix = TString::Format("rootmp_%d_", gSystem->GetPid());
+   int count = 0;
+   for (const char *dir : {"/dev/shm", gSystem->TempDirectory()}) {
+      void *dirp = gSystem->OpenDirectory(dir);
+      if (!dirp)
+         continue;
+      while (const char *name = gSystem->GetDirEntry(dirp)) {
+         if (TString(name).BeginsWith(prefix))
+            ++count;
+      }
+      gSystem->FreeDirectory(dirp);
+   }
+   return count;
+}
+
+TEST(MPSendRecv, SharedMemoryRoundTrip)
+{
+   const Int_t threshold = gEnv->GetValue("MultiProc.SharedMemThreshold", 1048576);
+   gEnv->SetValue("MultiProc.SharedMemThreshold", 0);
+
+   int fds[2];
+   ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+   {
+      TSocket sender(fds[0], "sender");
+      TSocket receiver(fds[1], "receiver");
+      const std::string title(100000, 't');
+      TNamed named("named", title.c_str());
+
+      // Two objects in flight, then a message without object.
+      ASSERT_LT(0, MPSend(&sender, MPCode::kFuncResult, &named));
+      named.SetName("second");
+      ASSERT_LT(0, MPSend(&sender, MPCode::kFuncResult, &named));
+      ASSERT_LT(0, MPSend(&sender, MPCode::kIdling));
+
+      for (const char *name : {"named", "second"}) {
+         MPCodeBufPair msg = MPRecv(&receiver);
+         EXPECT_EQ(MPCode::kFuncResult, msg.first);
+         ASSERT_NE(nullptr, msg.second);
+         std::unique_ptr<TNamed> received(ReadBuffer<TNamed *>(msg.second.get()));
+         ASSERT_NE(nullptr, received);
+         EXPECT_STREQ(name, received->GetName());
+         EXPECT_EQ(title, received->GetTitle());
+      }
+      MPCodeBufPair msg = MPRecv(&receiver);
+      EXPECT_EQ(MPCode::kIdling, msg.first);
+      EXPECT_EQ(nullptr, msg.second);
+
+      // A message that is never received leaves nothing behind either.
+      ASSERT_LT(0, MPSend(&sender, MPCode::kFuncResult, &named));
+      EXPECT_EQ(0, CountSharedFiles());
+   }
+   EXPECT_EQ(0, CountSharedFiles());
+
+   gEnv->SetValue("MultiProc.SharedMemThreshold", threshold);
+}
+
+// A shared memory header with an unexpected payload is rejected and consumed,
+// the next message is read correctly.
+TEST(MPSendRecv, MalformedSharedMemoryHeader)
+{
+   int fds[2];
+   ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+   TSocket sender(fds[0], "sender");
+   TSocket receiver(fds[1], "receiver");
+
+   TBufferFile wBuf(TBuffer::kWrite);
+   wBuf.WriteUInt(MPCode::kFuncResult | (1u << 31));
+   wBuf.WriteULong(3);
+   wBuf.WriteBuf("abc", 3);
+   ASSERT_LT(0, sender.SendRaw(wBuf.Buffer(), wBuf.Length()));
+   ASSERT_LT(0, MPSend(&sender, MPCode::kIdling));
+
+   MPCodeBufPair msg = MPRecv(&receiver);
+   EXPECT_EQ(MPCode::kRecvError, msg.first);
+   msg = MPRecv(&receiver);
+   EXPECT_EQ(MPCode::kIdling, msg.first);
+   EXPECT_EQ(nullptr, msg.second);
+}
@@ -19,6 +19,9 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <unordered_map>
 
@@ -147,6 +150,81 @@ struct RecurseCounts {
 
 
 };
+
+/// Same bookkeeping as RecurseCounts, but the readers counts are spread over
+/// shards selected by the thread id, each protected by its own spin lock
+/// instead of the RW lock's mutex. Threads taking the lock in read mode thus
+/// no longer serialize on a single mutex; like RecurseCounts, it does not rely
+/// on thread local storage.
+struct ShardedRecurseCounts {
+   using Hint_t = TVirtualRWMutex::Hint_t;
+   using ReaderColl_t = std::unordered_map<std::thread::id, size_t>;
+
+   static constexpr size_t kNShards = 64;
+
+   struct Shard {
+      ROOT::TSpinMutex fMutex;    ///<! Protects the structure of fReadersCount
+      ReaderColl_t fReadersCount; ///<! Readers counts of the thread ids of this shard
+      char fPadding[64];          ///<! Keep the shards in different cache lines
+   };
+
+   size_t fWriteRecurse = 0; ///<! Number of re-entry in the lock by the same thread.
+
+   std::thread::id fWriterThread;     ///<! Holder of the write lock
+   std::unique_ptr<Shard[]> fShards{new Shard[kNShards]}; ///<! Shards of the readers counts
+
+   using local_t = std::thread::id;
+
+   local_t GetLocal() const { return std::this_thread::get_id(); }
+
+   /// The count of a thread is only modified by that thread: the shard lock only
+   /// protects the map, whose elements do not move on insertion.
+   size_t &GetLocalReadersCount(local_t &local)
+   {
+      auto &shard = fShards[std::hash<std::thread::id>()(local) % kNShards];
+      std::lock_guard<ROOT::TSpinMutex> lock(shard.fMutex);
+      return shard.fReadersCount[local];
+   }
+
+   Hint_t *IncrementReadCount(local_t &local) {
+      auto &count = GetLocalReadersCount(local);
+      ++(count);
+      return reinterpret_cast<TVirtualRWMutex::Hint_t *>(&count);
+   }
+
+   template <typename MutexT>
+   Hint_t *IncrementReadCount(local_t &local, MutexT &) {
+      return IncrementReadCount(local);
+   }
+
+   Hint_t *DecrementReadCount(local_t &local) {
+      auto &count = GetLocalReadersCount(local);
+      --count;
+      return reinterpret_cast<TVirtualRWMutex::Hint_t *>(&count);
+   }
+
+   template <typename MutexT>
+   Hint_t *DecrementReadCount(local_t &local, MutexT &) {
+      return DecrementReadCount(local);
+   }
+
+   void ResetReadCount(local_t &local, int newvalue) {
+      GetLocalReadersCount(local) = newvalue;
+   }
+
+   bool IsCurrentWriter(local_t &local) const { return fWriterThread == local; }
+   bool IsNotCurrentWriter(local_t &local) const { return fWriterThread != local; }
+
+   void SetIsWriter(local_t &local)
+   {
+      ++fWriteRecurse;
+      fWriterThread = local;
+   }
+
+   void DecrementWriteCount() { --fWriteRecurse; }
+
+   void ResetIsWriter(local_t & /* local */) { fWriterThread = std::thread::id(); }
+};
 } // Internal
 
 template <typename MutexT = ROOT::TSpinMutex, typename RecurseCountsT = Internal::RecurseCounts>
@@ -12,19 +12,21 @@
 #ifndef ROOT_TThreadedObject
 #define ROOT_TThreadedObject
 
+#include "RConfigure.h"
 #include "TList.h"
 #include "TError.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <functional>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
-#include <thread>
 #include <vector>
 
-#include "ROOT/TSpinMutex.hxx"
 #include "TROOT.h"
+#include "TVirtualMutex.h"
 
 class TH1;
 
@@ -36,10 +38,24 @@ namespace ROOT {
 
          /// Get the unique index identifying a TThreadedObject.
          inline unsigned GetTThreadedObjectIndex() {
-            static unsigned fgTThreadedObjectIndex = 0;
+            static std::atomic<unsigned> fgTThreadedObjectIndex(0);
             return fgTThreadedObjectIndex++;
          }
 
+         /// Get the slot index of the calling thread. The index is the same for all
+         /// the TThreadedObjects, it is looked up without locks after the first call
+         /// and it is recycled once the thread terminates.
+         unsigned GetThisThreadSlot();
+
+         /// Runs the merges of TThreadedObject::TreeMerge() one after the other.
+         struct TSequentialExecutor {
+            template<class F>
+            void Foreach(F func, std::vector<unsigned> &args) {
+               for (auto arg : args)
+                  func(arg);
+            }
+         };
+
          template<typename T, bool ISHISTO = std::is_base_of<TH1,T>::value>
          struct Detacher{
             static T* Detach(T* obj) {
@@ -87,12 +103,15 @@ namespace ROOT {
 
          template<class T, bool ISHISTO = std::is_base_of<TH1,T>::value>
          struct DirCreator{
-            static std::vector<TDirectory*> Create(unsigned maxSlots) {
+            /// Create the directories of the slots [first, first + n) of the
+            /// TThreadedObject identified by objIndex.
+            static std::vector<TDirectory*> Create(unsigned objIndex, unsigned first, unsigned n) {
                std::string dirName = "__TThreaded_dir_";
-               dirName += std::to_string(ROOT::Internal::TThreadedObjectUtils::GetTThreadedObjectIndex()) + "_";
+               dirName += std::to_string(objIndex) + "_";
                std::vector<TDirectory*> dirs;
-               dirs.reserve(maxSlots);
-               for (unsigned i=0; i< maxSlots;++i) {
+               dirs.reserve(n);
+               R__LOCKGUARD(gROOTMutex);
+               for (unsigned i = first; i < first + n; ++i) {
                   auto dir = gROOT->mkdir((dirName+std::to_string(i)).c_str());
                   dirs.emplace_back(dir);
                }
@@ -102,8 +121,8 @@ namespace ROOT {
 
          template<class T>
          struct DirCreator<T, true>{
-            static std::vector<TDirectory*> Create(unsigned maxSlots) {
-               std::vector<TDirectory*> dirs(maxSlots, nullptr);
+            static std::vector<TDirectory*> Create(unsigned, unsigned, unsigned n) {
+               std::vector<TDirectory*> dirs(n, nullptr);
                return dirs;
             }
          };
@@ -143,53 +162,59 @@ namespace ROOT {
     * In case an elaborate thread management is in place, e.g. in presence of
     * stream of operations or "processing slots", it is also possible to
     * manually select the correct object pointer explicitly.
-    * The default size of the threaded objects is 64. This size can be extended
-    * manually via the fgMaxSlots parameter. The size of individual instances
-    * is automatically extended if the size of the implicit MT pool is bigger
-    * than 64.
+    * The slots are allocated in chunks, the first of which holds 64 slots (or
+    * as many as the threads of the implicit MT pool, if more). This size can
+    * be changed via the fgMaxSlots parameter. Further chunks, each twice as
+    * large as the previous one, are allocated when a slot beyond the current
+    * size is accessed: the number of slots is not bounded.
+    * The slot of a thread is cached in thread local storage: Get does not
+    * take any lock once the thread has accessed its first TThreadedObject.
     *
     */
    template<class T>
    class TThreadedObject {
    public:
-      static unsigned fgMaxSlots; ///< The maximum number of processing slots (distinct threads) which the instances can manage
+      static unsigned fgMaxSlots; ///< The number of processing slots (distinct threads) of the first chunk of slots
       TThreadedObject(const TThreadedObject&) = delete;
       /// Construct the TThreaded object and the "model" of the thread private
       /// objects.
       /// \tparam ARGS Arguments of the constructor of T
       template<class ...ARGS>
-      TThreadedObject(ARGS&&... args)
+      TThreadedObject(ARGS&&... args) : fIndex(Internal::TThreadedObjectUtils::GetTThreadedObjectIndex())
       {
          const auto imtPoolSize = ROOT::GetImplicitMTPoolSize();
-         fMaxSlots = (64 > imtPoolSize) ? fgMaxSlots : imtPoolSize;
-         fObjPointers = std::vector<std::shared_ptr<T>>(fMaxSlots, nullptr);
-         fDirectories = Internal::TThreadedObjectUtils::DirCreator<T>::Create(fMaxSlots);
-
-         TDirectory::TContext ctxt(fDirectories[0]);
+         fMaxSlots = (fgMaxSlots > imtPoolSize) ? fgMaxSlots : imtPoolSize;
+         if (fMaxSlots == 0)
+            fMaxSlots = 1;
+         for (auto &chunk : fChunks)
+            chunk = nullptr;
+         auto &slot0 = GetSlot(0);
+
+         TDirectory::TContext ctxt(slot0.fDirectory);
          fModel.reset(Internal::TThreadedObjectUtils::Detacher<T>::Detach(new T(std::forward<ARGS>(args)...)));
       }
 
+      ~TThreadedObject()
+      {
+         for (auto &chunk : fChunks)
+            delete [] chunk.load();
+      }
+
       /// Access a particular processing slot. This
       /// method is *thread-unsafe*: it cannot be invoked from two different
       /// threads with the same argument.
       std::shared_ptr<T> GetAtSlot(unsigned i)
       {
-         if ( i >= fObjPointers.size()) {
-            Warning("TThreadedObject::GetAtSlot", "Maximum number of slots reached.");
-            return nullptr;
-         }
-         auto objPointer = fObjPointers[i];
-         if (!objPointer) {
-            objPointer.reset(Internal::TThreadedObjectUtils::Cloner<T>::Clone(fModel.get(), fDirectories[i]));
-            fObjPointers[i] = objPointer;
-         }
-         return objPointer;
+         auto &slot = GetSlot(i);
+         if (!slot.fObject)
+            slot.fObject.reset(Internal::TThreadedObjectUtils::Cloner<T>::Clone(fModel.get(), slot.fDirectory));
+         return slot.fObject;
       }
 
       /// Set the value of a particular slot.
       void SetAtSlot(unsigned i, std::shared_ptr<T> v)
       {
-         fObjPointers[i] = v;
+         GetSlot(i).fObject = v;
       }
 
       /// Access a particular slot which corresponds to a single thread.
@@ -198,7 +223,8 @@ namespace ROOT {
       /// initialised for the particular slot.
       std::shared_ptr<T> GetAtSlotUnchecked(unsigned i) const
       {
-         return fObjPointers[i];
+         auto slot = FindSlot(i);
+         return slot ? slot->fObject : nullptr;
       }
 
       /// Access a particular slot which corresponds to a single thread.
@@ -208,15 +234,16 @@ namespace ROOT {
       /// will not outlive the TThreadedObject that returned it.
       T* GetAtSlotRaw(unsigned i) const
       {
-         return fObjPointers[i].get();
+         auto slot = FindSlot(i);
+         return slot ? slot->fObject.get() : nullptr;
       }
 
-      /// Access the pointer corresponding to the current slot. This method is
-      /// not adequate for being called inside tight loops as it implies a
-      /// lookup in a mapping between the threadIDs and the slot indices.
-      /// A good practice consists in copying the pointer onto the stack and
-      /// proceed with the loop as shown in this work item (psudo-code) which
-      /// will be sent to different threads:
+      /// Access the pointer corresponding to the current slot. The slot of the
+      /// thread is cached in thread local storage, but the returned shared
+      /// pointer still costs an atomic reference count. A good practice
+      /// consists in copying the pointer onto the stack and proceed with the
+      /// loop as shown in this work item (psudo-code) which will be sent to
+      /// different threads:
       /// ~~~{.cpp}
       /// auto workItem = [](){
       ///    auto objPtr = tthreadedObject.Get();
@@ -245,11 +272,48 @@ namespace ROOT {
          // We do not return if we already merged.
          if (fIsMerged) {
             Warning("TThreadedObject::Merge", "This object was already merged. Returning the previous result.");
-            return fObjPointers[0];
+            return GetAtSlotUnchecked(0);
+         }
+         auto objs = GetObjects();
+         if (!objs.empty()) {
+            mergeFunction(objs[0], objs);
+            // The first thread which accessed the object may not have had slot 0.
+            SetAtSlot(0, objs[0]);
          }
-         mergeFunction(fObjPointers[0], fObjPointers);
          fIsMerged = true;
-         return fObjPointers[0];
+         return GetAtSlotUnchecked(0);
+      }
+
+      /// As Merge(), but the objects are merged pairwise with
+      /// TThreadedObjectUtils::MergeTObjects in log2(N) rounds. The merges of
+      /// each round are independent and are run by the Foreach method of
+      /// executor, e.g. a ROOT::TThreadExecutor, which gets them as a
+      /// std::vector<unsigned>:
+      /// ~~~{.cpp}
+      /// ROOT::TThreadExecutor pool;
+      /// auto sum = tthreadedObject.TreeMerge(pool);
+      /// ~~~
+      template<class EXECUTOR>
+      std::shared_ptr<T> TreeMerge(EXECUTOR &executor)
+      {
+         if (fIsMerged) {
+            Warning("TThreadedObject::TreeMerge", "This object was already merged. Returning the previous result.");
+            return GetAtSlotUnchecked(0);
+         }
+         auto objs = GetObjects();
+         if (!objs.empty()) {
+            MergePairwise(objs, executor);
+            SetAtSlot(0, objs[0]);
+         }
+         fIsMerged = true;
+         return GetAtSlotUnchecked(0);
+      }
+
+      /// As TreeMerge(EXECUTOR &), running the merges one after the other.
+      std::shared_ptr<T> TreeMerge()
+      {
+         Internal::TThreadedObjectUtils::TSequentialExecutor executor;
+         return TreeMerge(executor);
       }
 
       /// Merge all the thread private objects. Can be called many times. It
@@ -260,39 +324,129 @@ namespace ROOT {
       {
          if (fIsMerged) {
             Warning("TThreadedObject::SnapshotMerge", "This object was already merged. Returning the previous result.");
-            return std::unique_ptr<T>(Internal::TThreadedObjectUtils::Cloner<T>::Clone(fObjPointers[0].get()));
+            return std::unique_ptr<T>(Internal::TThreadedObjectUtils::Cloner<T>::Clone(GetAtSlotRaw(0)));
          }
          auto targetPtr = Internal::TThreadedObjectUtils::Cloner<T>::Clone(fModel.get());
          std::shared_ptr<T> targetPtrShared(targetPtr, [](T *) {});
-         mergeFunction(targetPtrShared, fObjPointers);
+         auto objs = GetObjects();
+         mergeFunction(targetPtrShared, objs);
          return std::unique_ptr<T>(targetPtr);
       }
 
    private:
-      unsigned fMaxSlots;                                ///< The size of the instance
-      std::unique_ptr<T> fModel;                         ///< Use to store a "model" of the object
-      std::vector<std::shared_ptr<T>> fObjPointers;      ///< A pointer per thread is kept.
-      std::vector<TDirectory*> fDirectories;             ///< A TDirectory per thread is kept.
-      std::map<std::thread::id, unsigned> fThrIDSlotMap; ///< A mapping between the thread IDs and the slots
-      unsigned fCurrMaxSlotIndex = 0;                    ///< The maximum slot index
-      bool fIsMerged = false;                            ///< Remember if the objects have been merged already
-      ROOT::TSpinMutex fThrIDSlotMutex;                  ///< Mutex to protect the ID-slot map access
-
-      /// Get the slot number for this threadID.
+      /// A processing slot: the thread private object and its directory.
+      struct TSlot {
+         std::shared_ptr<T> fObject;
+         TDirectory *fDirectory = nullptr;
+      };
+
+      /// Chunk c holds fMaxSlots << c slots: as fMaxSlots >= 1, 33 chunks cover
+      /// all the 2^32 slot indices.
+      static constexpr unsigned kMaxChunks = 33;
+
+      std::unique_ptr<T> fModel;                           ///< Use to store a "model" of the object
+      unsigned fMaxSlots;                                  ///< The size of the first chunk of slots
+      const unsigned fIndex;                               ///< Unique index of the instance, names its directories
+      std::array<std::atomic<TSlot*>, kMaxChunks> fChunks; ///< The chunks of slots, allocated on demand
+      std::mutex fChunksMutex;                             ///< Serialises the allocation of the chunks
+      bool fIsMerged = false;                              ///< Remember if the objects have been merged already
+
+      /// Get the slot number for this thread.
       unsigned GetThisSlotNumber()
       {
-         const auto thisThreadID = std::this_thread::get_id();
-         unsigned thisIndex;
-         {
-            std::lock_guard<ROOT::TSpinMutex> lg(fThrIDSlotMutex);
-            auto thisSlotNumIt = fThrIDSlotMap.find(thisThreadID);
-            if (thisSlotNumIt != fThrIDSlotMap.end()) return thisSlotNumIt->second;
-            thisIndex = fCurrMaxSlotIndex++;
-            fThrIDSlotMap[thisThreadID] = thisIndex;
+         return Internal::TThreadedObjectUtils::GetThisThreadSlot();
+      }
+
+      /// Index of the first slot of chunk c.
+      unsigned long long ChunkBegin(unsigned c) const
+      {
+         return (unsigned long long)fMaxSlots * ((1ull << c) - 1);
+      }
+
+      /// Number of slots of chunk c, the last one being cut at the largest
+      /// slot index.
+      unsigned ChunkSize(unsigned c) const
+      {
+         const unsigned long long kNIndices = 1ull << 32;
+         const auto begin = ChunkBegin(c);
+         if (begin >= kNIndices)
+            return 0;
+         return (unsigned)std::min((unsigned long long)fMaxSlots << c, kNIndices - begin);
+      }
+
+      /// Find the chunk holding slot i and the position of the slot in it.
+      void LocateSlot(unsigned i, unsigned &chunk, unsigned &offset) const
+      {
+         chunk = 0;
+         while (i >= ChunkBegin(chunk + 1))
+            ++chunk;
+         offset = i - ChunkBegin(chunk);
+      }
+
+      /// Return slot i, or nullptr if its chunk was not allocated yet.
+      TSlot *FindSlot(unsigned i) const
+      {
+         unsigned chunk, offset;
+         LocateSlot(i, chunk, offset);
+         auto slots = fChunks[chunk].load(std::memory_order_acquire);
+         return slots ? slots + offset : nullptr;
+      }
+
+      /// Return slot i, allocating its chunk if needed.
+      TSlot &GetSlot(unsigned i)
+      {
+         unsigned chunk, offset;
+         LocateSlot(i, chunk, offset);
+         auto slots = fChunks[chunk].load(std::memory_order_acquire);
+         if (!slots) {
+            std::lock_guard<std::mutex> lg(fChunksMutex);
+            slots = fChunks[chunk].load(std::memory_order_relaxed);
+            if (!slots) {
+               const unsigned size = ChunkSize(chunk);
+               const unsigned first = ChunkBegin(chunk);
+               slots = new TSlot[size];
+               auto dirs = Internal::TThreadedObjectUtils::DirCreator<T>::Create(fIndex, first, size);
+               for (unsigned j = 0; j < size; ++j)
+                  slots[j].fDirectory = dirs[j];
+               fChunks[chunk].store(slots, std::memory_order_release);
+            }
          }
-         return thisIndex;
+         return slots[offset];
       }
 
+      /// Return the objects of all the slots which have one, in slot order.
+      std::vector<std::shared_ptr<T>> GetObjects() const
+      {
+         std::vector<std::shared_ptr<T>> objs;
+         for (unsigned chunk = 0; chunk < kMaxChunks; ++chunk) {
+            auto slots = fChunks[chunk].load(std::memory_order_acquire);
+            if (!slots)
+               break;
+            for (unsigned j = 0, size = ChunkSize(chunk); j < size; ++j) {
+               if (slots[j].fObject)
+                  objs.emplace_back(slots[j].fObject);
+            }
+         }
+         return objs;
+      }
+
+      /// Merge the objects pairwise into objs[0]: in each round the object at
+      /// position i + stride is merged into the one at position i.
+      template<class EXECUTOR>
+      static void MergePairwise(std::vector<std::shared_ptr<T>> &objs, EXECUTOR &executor)
+      {
+         const unsigned nObjs = objs.size();
+         for (unsigned stride = 1; stride < nObjs; stride *= 2) {
+            std::vector<unsigned> targets;
+            for (unsigned i = 0; i + stride < nObjs; i += 2 * stride)
+               targets.emplace_back(i);
+            auto mergePair = [&objs, stride](unsigned i) {
+               std::vector<std::shared_ptr<T>> source{objs[i + stride]};
+               TThreadedObjectUtils::MergeTObjects<T>(objs[i], source);
+            };
+            executor.Foreach(mergePair, targets);
+         }
+      }
    };
 
    template<class T> unsigned TThreadedObject<T>::fgMaxSlots = 64;
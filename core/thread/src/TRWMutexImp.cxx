@@ -111,6 +111,7 @@ TRWMutexImp<MutexT, RecurseCountsT>::GetStateBefore()
 template class TRWMutexImp<TMutex>;
 template class TRWMutexImp<ROOT::TSpinMutex>;
 template class TRWMutexImp<std::mutex>;
+template class TRWMutexImp<std::mutex, ROOT::Internal::ShardedRecurseCounts>;
 template class TRWMutexImp<TMutex, ROOT::Internal::UniqueLockRecurseCount>;
 template class TRWMutexImp<ROOT::TSpinMutex, ROOT::Internal::UniqueLockRecurseCount>;
 
@@ -389,6 +389,7 @@ namespace ROOT {
 template class TReentrantRWLock<ROOT::TSpinMutex, ROOT::Internal::RecurseCounts>;
 template class TReentrantRWLock<TMutex, ROOT::Internal::RecurseCounts>;
 template class TReentrantRWLock<std::mutex, ROOT::Internal::RecurseCounts>;
+template class TReentrantRWLock<std::mutex, ROOT::Internal::ShardedRecurseCounts>;
 
 template class TReentrantRWLock<ROOT::TSpinMutex, ROOT::Internal::UniqueLockRecurseCount>;
 template class TReentrantRWLock<TMutex, ROOT::Internal::UniqueLockRecurseCount>;
@@ -0,0 +1,70 @@
+// @(#)root/thread:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TThreadedObject.hxx"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+/// The pool of the slot indices handed out to the threads. It is never
+/// destroyed, as threads can return their index at any time, also during
+/// the teardown of the process.
+struct TThreadSlotPool {
+   std::mutex fMutex;                ///< Protects the members below
+   std::vector<unsigned> fFreeSlots; ///< Indices returned by threads which terminated
+   unsigned fNextSlot = 0;           ///< Lowest index never handed out
+
+   static TThreadSlotPool &Get()
+   {
+      static auto pool = new TThreadSlotPool();
+      return *pool;
+   }
+
+   unsigned Acquire()
+   {
+      std::lock_guard<std::mutex> lg(fMutex);
+      if (fFreeSlots.empty())
+         return fNextSlot++;
+      // Hand out the lowest index, to keep the slots of the objects dense.
+      auto lowest = std::min_element(fFreeSlots.begin(), fFreeSlots.end());
+      const auto slot = *lowest;
+      fFreeSlots.erase(lowest);
+      return slot;
+   }
+
+   void Release(unsigned slot)
+   {
+      std::lock_guard<std::mutex> lg(fMutex);
+      fFreeSlots.emplace_back(slot);
+   }
+};
+
+/// Holds the slot index of a thread for its whole lifetime.
+struct TThreadSlot {
+   const unsigned fSlot;
+   TThreadSlot() : fSlot(TThreadSlotPool::Get().Acquire()) {}
+   ~TThreadSlot() { TThreadSlotPool::Get().Release(fSlot); }
+};
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the slot index of the calling thread, see TThreadedObject.
+/// The thread local object lives in the library, not in the header, as cling
+/// cannot jit thread local objects with a destructor.
+
+unsigned ROOT::Internal::TThreadedObjectUtils::GetThisThreadSlot()
+{
+   thread_local TThreadSlot threadSlot;
+   return threadSlot.fSlot;
+}
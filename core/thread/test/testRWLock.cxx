@@ -14,6 +14,8 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
+#include <atomic>
+
 using namespace ROOT;
 
 void testWriteLockV(TVirtualMutex *m, size_t repetition)
@@ -159,6 +161,56 @@ void concurrentReadsAndWrites(TVirtualRWMutex *m, size_t nwriters, size_t nreade
    }
 }
 
+// Readers take the lock twice (recursively); writers upgrade a read lock they
+// already hold. Once all the threads are done, no read lock may be left over.
+template <typename M>
+void concurrentReadersAndUpgradingWriters(M &m, size_t nwriters, size_t nreaders, size_t repetition)
+{
+   std::vector<std::thread> threads;
+   std::atomic<size_t> nreads(0);
+
+   Globals global;
+
+   for (size_t i = 0; i < nwriters; ++i) {
+      threads.push_back(std::thread([&]() {
+         for (size_t r = 0; r < repetition; ++r) {
+            auto rhint = m.ReadLock();
+            auto whint = m.WriteLock();
+            global.fFirst++;
+            global.fSecond += global.fFirst;
+            global.fThird++;
+            m.WriteUnLock(whint);
+            m.ReadUnLock(rhint);
+         }
+      }));
+   }
+   for (size_t i = 0; i < nreaders; ++i) {
+      threads.push_back(std::thread([&]() {
+         for (size_t r = 0; r < repetition; ++r) {
+            auto outer = m.ReadLock();
+            auto inner = m.ReadLock();
+            EXPECT_EQ(outer, inner);
+            EXPECT_EQ(global.fFirst, global.fThird);
+            m.ReadUnLock(inner);
+            m.ReadUnLock(outer);
+            ++nreads;
+         }
+      }));
+   }
+
+   for (auto &&th : threads) {
+      th.join();
+   }
+
+   EXPECT_EQ(nwriters * repetition, global.fFirst);
+   EXPECT_EQ(nwriters * repetition, global.fThird);
+   EXPECT_EQ(nreaders * repetition, nreads);
+
+   // Would dead lock if a reader was still accounted for.
+   auto whint = m.WriteLock();
+   m.WriteUnLock(whint);
+}
+
 template <typename T>
 void Reentrant(T &m)
 {
@@ -254,6 +306,8 @@ auto gRWMutexStd = new TRWMutexImp<std::mutex>();
 auto gReentrantRWMutex = new ROOT::TReentrantRWLock<TMutex>();
 auto gReentrantRWMutexSM = new ROOT::TReentrantRWLock<ROOT::TSpinMutex>();
 auto gReentrantRWMutexStd = new ROOT::TReentrantRWLock<std::mutex>();
+auto gReentrantRWMutexSharded = new ROOT::TReentrantRWLock<std::mutex, ROOT::Internal::ShardedRecurseCounts>();
+auto gRWMutexSharded = new TRWMutexImp<std::mutex, ROOT::Internal::ShardedRecurseCounts>();
 auto gSpinMutex = new ROOT::TSpinMutex();
 
 // Intentionally ignore the Fatal error due to the shread thread-local storage.
@@ -358,6 +412,16 @@ TEST(RWLock, ReadUnLockStdDirect)
    testReadUnLock(gReentrantRWMutexStd, gRepetition, gReadHint);
 }
 
+TEST(RWLock, ReadLockShardedDirect)
+{
+   gReadHint = testReadLock(gReentrantRWMutexSharded, gRepetition);
+}
+
+TEST(RWLock, ReadUnLockShardedDirect)
+{
+   testReadUnLock(gReentrantRWMutexSharded, gRepetition, gReadHint);
+}
+
 TEST(RWLock, ReadLockSpinDirect)
 {
    gReadHint = testReadLock(gReentrantRWMutexSM, gRepetition);
@@ -443,6 +507,11 @@ TEST(RWLock, ReentrantStd)
    Reentrant(*gReentrantRWMutexStd);
 }
 
+TEST(RWLock, ReentrantSharded)
+{
+   Reentrant(*gReentrantRWMutexSharded);
+}
+
 TEST(RWLock, ReentrantSpin)
 {
    Reentrant(*gReentrantRWMutexSM);
@@ -468,6 +537,11 @@ TEST(RWLock, ResetRestoreStd)
    ResetRestore(*gReentrantRWMutexStd);
 }
 
+TEST(RWLock, ResetRestoreSharded)
+{
+   ResetRestore(*gReentrantRWMutexSharded);
+}
+
 TEST(RWLock, ResetRestoreSpin)
 {
    ResetRestore(*gReentrantRWMutexSM);
@@ -552,6 +626,27 @@ TEST(RWLock, LargeconcurrentReadsAndWritesStd)
    concurrentReadsAndWrites(gRWMutex, 10, 20, gRepetition / 10000);
 }
 
+TEST(RWLock, concurrentReadsAndWritesSharded)
+{
+   concurrentReadsAndWrites(gRWMutexSharded, 1, 2, gRepetition / 10000);
+}
+
+TEST(RWLock, LargeconcurrentReadsAndWritesSharded)
+{
+   concurrentReadsAndWrites(gRWMutexSharded, 10, 20, gRepetition / 10000);
+}
+
+TEST(RWLock, concurrentReadersAndUpgradingWritersSharded)
+{
+   concurrentReadersAndUpgradingWriters(*gReentrantRWMutexSharded, 2, 8, gRepetition / 10000);
+   concurrentReadersAndUpgradingWriters(*gRWMutexSharded, 2, 8, gRepetition / 10000);
+}
+
+TEST(RWLock, concurrentResetRestoreSharded)
+{
+   concurrentResetRestore(gRWMutexSharded, 2, gRepetition / 10000);
+}
+
 TEST(RWLock, LargeconcurrentReadsAndWritesSpin)
 {
    concurrentReadsAndWrites(gRWMutexSpin,10,20,gRepetition / 100000);
@@ -4,6 +4,12 @@
 
 #include "gtest/gtest.h"
 
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 using namespace ROOT;
 
 void IsSameHist(const TH1F &a, const TH1F &b)
@@ -126,3 +132,90 @@ TEST(TThreadedObject, SnapshotMerge)
    IsSameHist(*hsum1, *hsum0);
    EXPECT_TRUE(hsum1 != hsum0);
 }
+
+TEST(TThreadedObject, ManySlots)
+{
+   TH1::AddDirectory(false);
+
+   ROOT::TThreadedObject<TH1F> tto("h", "h", 64, -4, 4);
+   const unsigned nSlots = 4 * ROOT::TThreadedObject<TH1F>::fgMaxSlots + 3;
+   for (unsigned i = 0; i < nSlots; ++i) {
+      auto h = tto.GetAtSlot(i);
+      ASSERT_TRUE(h != nullptr);
+      h->Fill(0.);
+   }
+   EXPECT_TRUE(tto.GetAtSlotRaw(nSlots) == nullptr);
+   EXPECT_DOUBLE_EQ(nSlots, tto.Merge()->GetEntries());
+}
+
+TEST(TThreadedObject, ManyThreads)
+{
+   TH1::AddDirectory(false);
+
+   ROOT::TThreadedObject<TH1F> tto("h", "h", 64, -4, 4);
+   const unsigned nThreads = ROOT::TThreadedObject<TH1F>::fgMaxSlots + 36;
+   // All the threads are alive at the same time, so they all have different slots.
+   std::mutex m;
+   std::condition_variable cv;
+   unsigned nWaiting = 0;
+   std::vector<std::thread> threads;
+   for (unsigned i = 0; i < nThreads; ++i) {
+      threads.emplace_back([&]() {
+         tto->Fill(0.);
+         std::unique_lock<std::mutex> lock(m);
+         if (++nWaiting == nThreads)
+            cv.notify_all();
+         cv.wait(lock, [&]() { return nWaiting == nThreads; });
+      });
+   }
+   for (auto &t : threads)
+      t.join();
+   EXPECT_DOUBLE_EQ(nThreads, tto.Merge()->GetEntries());
+}
+
+TEST(TThreadedObject, TreeMerge)
+{
+   TH1::AddDirectory(false);
+
+   const unsigned nSlots = 13;
+   TH1F model("h", "h", 64, -4, 4);
+   ROOT::TThreadedObject<TH1F> tto("h", "h", 64, -4, 4);
+   gRandom->SetSeed(1);
+   for (unsigned i = 0; i < nSlots; ++i) {
+      // Leave some slots empty.
+      if (i % 4 == 1)
+         continue;
+      TH1F h("h", "h", 64, -4, 4);
+      h.FillRandom("gaus", 100);
+      model.Add(&h);
+      tto.GetAtSlot(i)->Add(&h);
+   }
+   auto snapshot = tto.SnapshotMerge();
+   // Any class with a Foreach method, e.g. ROOT::TThreadExecutor, can run the merges.
+   struct TCountingExecutor {
+      unsigned fNMerges = 0;
+      void Foreach(std::function<void(unsigned)> func, std::vector<unsigned> &args)
+      {
+         for (auto arg : args)
+            func(arg);
+         fNMerges += args.size();
+      }
+   } executor;
+   auto hsum = tto.TreeMerge(executor);
+   EXPECT_EQ(9u, executor.fNMerges);
+   IsSameHist(*hsum, model);
+   IsSameHist(*snapshot, model);
+}
+
+TEST(TThreadedObject, NoSlots)
+{
+   TH1::AddDirectory(false);
+
+   const auto maxSlots = ROOT::TThreadedObject<TH1F>::fgMaxSlots;
+   ROOT::TThreadedObject<TH1F>::fgMaxSlots = 0;
+   ROOT::TThreadedObject<TH1F> tto("h", "h", 64, -4, 4);
+   ROOT::TThreadedObject<TH1F>::fgMaxSlots = maxSlots;
+   for (unsigned i = 0; i < 10; ++i)
+      tto.GetAtSlot(i)->Fill(0.);
+   EXPECT_DOUBLE_EQ(10, tto.Merge()->GetEntries());
+}
@@ -0,0 +1,43 @@
+#include "TFormula.h"
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+namespace {
+
+const char *kExpressions[] = {"x*x+2*x+1", "sin(x)*exp(-x)", "[0]+[1]*x+[2]*x*x", "gaus"};
+
+} // anonymous namespace
+
+/// Evaluate the formula kExpressions[range(0)]; its compilation, at
+/// construction, is not part of the measurement.
+static void BM_TFormula_Eval(benchmark::State &state)
+{
+   TFormula formula("f", kExpressions[state.range(0)]);
+   std::vector<double> params(formula.GetNpar(), 0.5);
+   if (!params.empty())
+      formula.SetParameters(params.data());
+   state.SetLabel(kExpressions[state.range(0)]);
+   double x = 0.;
+   for (auto _ : state) {
+      benchmark::DoNotOptimize(formula.Eval(x));
+      x += 1e-6;
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TFormula_Eval)->DenseRange(0, 3);
+
+static void BM_TFormula_EvalPar(benchmark::State &state)
+{
+   TFormula formula("f", kExpressions[state.range(0)]);
+   std::vector<double> params(formula.GetNpar(), 0.5);
+   state.SetLabel(kExpressions[state.range(0)]);
+   double x = 0.;
+   for (auto _ : state) {
+      benchmark::DoNotOptimize(formula.EvalPar(&x, params.data()));
+      x += 1e-6;
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TFormula_EvalPar)->DenseRange(0, 3);
@@ -0,0 +1,87 @@
+#include "TH1.h"
+#include "TH2.h"
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+namespace {
+
+/// Values spread over the range [-1, 2) of the histograms, some of them
+/// in the underflow and overflow bins.
+std::vector<double> MakeValues(std::size_t n)
+{
+   std::vector<double> values(n);
+   unsigned seed = 12345;
+   for (auto &v : values) {
+      seed = 1103515245 * seed + 12345;
+      v = (seed >> 8) * (3. / (1 << 24)) - 1.;
+   }
+   return values;
+}
+
+const std::vector<double> &GetValues()
+{
+   static const std::vector<double> values = MakeValues(1 << 16);
+   return values;
+}
+
+} // anonymous namespace
+
+/// Fill a histogram with range(0) bins.
+template <typename HIST>
+static void BM_TH1_Fill(benchmark::State &state)
+{
+   TH1::AddDirectory(false);
+   HIST h("h", "h", state.range(0), 0., 1.);
+   const auto &values = GetValues();
+   std::size_t i = 0;
+   for (auto _ : state) {
+      h.Fill(values[i]);
+      i = (i + 1) % values.size();
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_TH1_Fill, TH1D)->Range(16, 16384);
+BENCHMARK_TEMPLATE(BM_TH1_Fill, TH1F)->Range(16, 16384);
+BENCHMARK_TEMPLATE(BM_TH1_Fill, TH1I)->Range(16, 16384);
+
+static void BM_TH1_FillWeighted(benchmark::State &state)
+{
+   TH1::AddDirectory(false);
+   TH1D h("h", "h", state.range(0), 0., 1.);
+   const auto &values = GetValues();
+   std::size_t i = 0;
+   for (auto _ : state) {
+      h.Fill(values[i], 0.5);
+      i = (i + 1) % values.size();
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TH1_FillWeighted)->Range(16, 16384);
+
+/// Fill a histogram with range(0) bins at once, from an array of values.
+static void BM_TH1_FillN(benchmark::State &state)
+{
+   TH1::AddDirectory(false);
+   TH1D h("h", "h", 100, 0., 1.);
+   const auto &values = GetValues();
+   for (auto _ : state)
+      h.FillN(state.range(0), values.data(), nullptr);
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TH1_FillN)->Range(16, 1 << 16);
+
+static void BM_TH2_Fill(benchmark::State &state)
+{
+   TH1::AddDirectory(false);
+   TH2D h("h", "h", state.range(0), 0., 1., state.range(0), 0., 1.);
+   const auto &values = GetValues();
+   std::size_t i = 0;
+   for (auto _ : state) {
+      h.Fill(values[i], values[i + 1]);
+      i = (i + 2) % values.size();
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TH2_Fill)->Range(16, 1024);
@@ -0,0 +1,93 @@
+#include "Compression.h"
+#include "RZip.h"
+
+#include "benchmark/benchmark.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+/// 1 MB of floats in the range [0, 100), with the mix of regularity and
+/// noise of typical physics data.
+std::vector<char> MakeInput()
+{
+   std::vector<float> values(256 * 1024);
+   unsigned seed = 12345;
+   for (std::size_t i = 0; i < values.size(); ++i) {
+      seed = 1103515245 * seed + 12345;
+      values[i] = std::round(100 * std::abs(std::sin(i * 0.01f)) + (seed >> 28)) * 0.5f;
+   }
+   std::vector<char> input(values.size() * sizeof(float));
+   std::memcpy(input.data(), values.data(), input.size());
+   return input;
+}
+
+/// Header of a compressed block, see R__zipMultipleAlgorithm.
+constexpr int kHeaderSize = 9;
+
+} // anonymous namespace
+
+/// Compress with the algorithm range(0), at the level range(1).
+static void BM_Compression_Zip(benchmark::State &state)
+{
+   const auto algorithm = static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(state.range(0));
+   std::vector<char> input = MakeInput();
+   std::vector<char> output(input.size() + kHeaderSize);
+   int compressedSize = 0;
+   for (auto _ : state) {
+      int srcSize = input.size();
+      int tgtSize = output.size();
+      R__zipMultipleAlgorithm(state.range(1), &srcSize, input.data(), &tgtSize, output.data(), &compressedSize,
+                              algorithm);
+   }
+   state.SetBytesProcessed(state.iterations() * input.size());
+   state.counters["ratio"] = compressedSize ? double(input.size()) / compressedSize : 1.;
+}
+
+/// Uncompress what was compressed with the algorithm range(0), at the level range(1).
+static void BM_Compression_Unzip(benchmark::State &state)
+{
+   const auto algorithm = static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(state.range(0));
+   std::vector<char> input = MakeInput();
+   std::vector<char> compressed(input.size() + kHeaderSize);
+   int srcSize = input.size();
+   int tgtSize = compressed.size();
+   int compressedSize = 0;
+   R__zipMultipleAlgorithm(state.range(1), &srcSize, input.data(), &tgtSize, compressed.data(), &compressedSize,
+                           algorithm);
+   if (!compressedSize) {
+      state.SkipWithError("The input could not be compressed");
+      return;
+   }
+
+   std::vector<char> output(input.size());
+   for (auto _ : state) {
+      int zipSize = compressedSize;
+      int unzipSize = output.size();
+      int unzipped = 0;
+      R__unzip(&zipSize, reinterpret_cast<unsigned char *>(compressed.data()), &unzipSize,
+               reinterpret_cast<unsigned char *>(output.data()), &unzipped);
+      if (unzipped != srcSize) {
+         state.SkipWithError("The output has not the size of the input");
+         break;
+      }
+   }
+   state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+static void CompressionArguments(benchmark::internal::Benchmark *benchmark)
+{
+   using EAlgorithm = ROOT::RCompressionSetting::EAlgorithm;
+   for (int level : {1, 4, 6, 9}) {
+      benchmark->Args({EAlgorithm::kZLIB, level});
+      benchmark->Args({EAlgorithm::kLZ4, level});
+   }
+   for (int level : {1, 6})
+      benchmark->Args({EAlgorithm::kLZMA, level});
+   benchmark->ArgNames({"algorithm", "level"});
+}
+
+BENCHMARK(BM_Compression_Zip)->Apply(CompressionArguments);
+BENCHMARK(BM_Compression_Unzip)->Apply(CompressionArguments);
@@ -0,0 +1,106 @@
+#include "TBufferFile.h"
+#include "TNamed.h"
+#include "TObjArray.h"
+#include "TObjString.h"
+
+#include "benchmark/benchmark.h"
+
+#include <string>
+#include <vector>
+
+template <typename T>
+static void BM_TBufferFile_WriteFastArray(benchmark::State &state)
+{
+   const std::vector<T> values(state.range(0), 42);
+   TBufferFile buffer(TBuffer::kWrite, 2 * sizeof(T) * values.size());
+   for (auto _ : state) {
+      buffer.SetBufferOffset(0);
+      buffer.WriteFastArray(values.data(), values.size());
+   }
+   state.SetBytesProcessed(state.iterations() * sizeof(T) * values.size());
+}
+BENCHMARK_TEMPLATE(BM_TBufferFile_WriteFastArray, Int_t)->Range(8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_TBufferFile_WriteFastArray, Float_t)->Range(8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_TBufferFile_WriteFastArray, Double_t)->Range(8, 1 << 16);
+
+template <typename T>
+static void BM_TBufferFile_ReadFastArray(benchmark::State &state)
+{
+   std::vector<T> values(state.range(0), 42);
+   TBufferFile writer(TBuffer::kWrite, 2 * sizeof(T) * values.size());
+   writer.WriteFastArray(values.data(), values.size());
+   TBufferFile reader(TBuffer::kRead, writer.Length(), writer.Buffer(), kFALSE);
+   for (auto _ : state) {
+      reader.SetBufferOffset(0);
+      reader.ReadFastArray(values.data(), values.size());
+      benchmark::DoNotOptimize(values.data());
+   }
+   state.SetBytesProcessed(state.iterations() * sizeof(T) * values.size());
+}
+BENCHMARK_TEMPLATE(BM_TBufferFile_ReadFastArray, Int_t)->Range(8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_TBufferFile_ReadFastArray, Float_t)->Range(8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_TBufferFile_ReadFastArray, Double_t)->Range(8, 1 << 16);
+
+static void BM_TBufferFile_WriteTNamed(benchmark::State &state)
+{
+   TNamed named("name", "a title which is not too short");
+   TBufferFile buffer(TBuffer::kWrite);
+   for (auto _ : state) {
+      buffer.SetBufferOffset(0);
+      named.Streamer(buffer);
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TBufferFile_WriteTNamed);
+
+static void BM_TBufferFile_ReadTNamed(benchmark::State &state)
+{
+   TNamed named("name", "a title which is not too short");
+   TBufferFile writer(TBuffer::kWrite);
+   named.Streamer(writer);
+   TBufferFile reader(TBuffer::kRead, writer.Length(), writer.Buffer(), kFALSE);
+   for (auto _ : state) {
+      reader.SetBufferOffset(0);
+      named.Streamer(reader);
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TBufferFile_ReadTNamed);
+
+/// Stream a collection of range(0) objects, with the bookkeeping of the
+/// objects already written that goes with it.
+static void BM_TBufferFile_WriteObjArray(benchmark::State &state)
+{
+   TObjArray array;
+   array.SetOwner();
+   for (Int_t i = 0; i < state.range(0); ++i)
+      array.Add(new TObjString(std::to_string(i).c_str()));
+   TBufferFile buffer(TBuffer::kWrite);
+   for (auto _ : state) {
+      buffer.SetBufferOffset(0);
+      buffer.ResetMap();
+      buffer.WriteObject(&array);
+   }
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TBufferFile_WriteObjArray)->Range(8, 4096);
+
+static void BM_TBufferFile_ReadObjArray(benchmark::State &state)
+{
+   TObjArray array;
+   array.SetOwner();
+   for (Int_t i = 0; i < state.range(0); ++i)
+      array.Add(new TObjString(std::to_string(i).c_str()));
+   TBufferFile writer(TBuffer::kWrite);
+   writer.WriteObject(&array);
+   TBufferFile reader(TBuffer::kRead, writer.Length(), writer.Buffer(), kFALSE);
+   for (auto _ : state) {
+      reader.SetBufferOffset(0);
+      reader.ResetMap();
+      auto copy = static_cast<TObjArray *>(reader.ReadObject(TObjArray::Class()));
+      copy->Delete();
+      delete copy;
+   }
+   state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TBufferFile_ReadObjArray)->Range(8, 4096);
@@ -0,0 +1,89 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RReadEngine
+#define ROOT_RReadEngine
+
+#include "RtypesCore.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/// A single request of a vectored read: fLen bytes at file position fOffset into fBuffer.
+struct RReadRequest {
+   Long64_t fOffset = 0;     ///< Position of the first byte in the file
+   Int_t fLen = 0;           ///< Number of bytes to read
+   char *fBuffer = nullptr;  ///< Destination of the bytes
+};
+
+/**
+ * \class RReadEngine RReadEngine.hxx
+ * \ingroup IO
+ *
+ * RReadEngine serves a vector of (position, length) requests on a local file
+ * descriptor with a pool of threads issuing positional reads concurrently.
+ * Requests that are adjacent in the file, or separated by less than the
+ * configured maximum gap, are merged into a single vectored read (preadv)
+ * scattering the data straight into the destination buffers. This lets the
+ * operating system and the underlying (possibly parallel) file system work on
+ * many ranges at once, which is what high-latency storage needs to reach its
+ * throughput.
+ *
+ * The engine does not touch the file offset, so that it can be shared by any
+ * number of files and threads. It is used by TFile::ReadBuffers, and thus by
+ * TTreeCache and TFilePrefetch, when TFile::SetParallelReadThreads is set.
+ */
+
+class RReadEngine {
+public:
+   /// Called on a worker thread once a request is completed; the flag tells whether it succeeded.
+   using Callback_t = std::function<void(const RReadRequest &, bool)>;
+
+   RReadEngine(UInt_t nThreads, Long64_t maxGap = 4096);
+   ~RReadEngine();
+
+   RReadEngine(const RReadEngine &) = delete;
+   RReadEngine &operator=(const RReadEngine &) = delete;
+
+   UInt_t GetNThreads() const { return fWorkers.size(); }
+   Long64_t GetMaxGap() const { return fMaxGap; }
+
+   Int_t ReadV(Int_t fd, const RReadRequest *requests, Int_t nreq, const Callback_t &callback = Callback_t());
+
+private:
+   struct RSegment {
+      std::vector<const RReadRequest *> fRequests; ///< Requests served by the segment, sorted by position
+      Long64_t fBegin = 0;                         ///< Position of the first byte of the segment
+      Long64_t fEnd = 0;                           ///< Position after the last byte of the segment
+   };
+
+   std::vector<std::thread> fWorkers;        ///< Threads executing the queued segment reads
+   std::deque<std::function<void()>> fQueue; ///< Pending segment reads
+   std::mutex fQueueMutex;                   ///< Protects fQueue and fStop
+   std::condition_variable fQueueCond;       ///< Signals new work or the shutdown of the engine
+   bool fStop = false;                       ///< Set when the engine is destroyed
+   Long64_t fMaxGap;                         ///< Largest hole between two requests still read by a single call
+
+   void WorkerLoop();
+   std::vector<RSegment> MakeSegments(const RReadRequest *requests, Int_t nreq) const;
+   Bool_t ReadSegment(Int_t fd, const RSegment &segment) const;
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
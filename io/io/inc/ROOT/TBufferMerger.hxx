@@ -15,10 +15,11 @@
 #include "TFileMerger.h"
 #include "TMemFile.h"
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
@@ -73,6 +74,9 @@ public:
    /** Returns the current value of the auto save setting in bytes (default = 0). */
    size_t GetAutoSave() const;
 
+   /** Returns the maximum number of bytes waiting in the queue before writers block (0 = unlimited). */
+   size_t GetMaxBuffered() const;
+
    /** Returns the current merge options. */
    const char* GetMergeOptions();
 
@@ -86,6 +90,16 @@ public:
     */
    void SetAutoSave(size_t size);
 
+   /** Limits the memory used by the buffers waiting to be merged. When more
+    *  than size bytes are queued, a writer pushing a new buffer waits for the
+    *  merge in progress (if any) and then merges the queue itself, instead of
+    *  leaving it to the merging thread. This keeps the memory bounded when
+    *  many threads produce data faster than a single thread can merge it,
+    *  and applies whatever the auto save setting is.
+    *  The default (0) never blocks the writers.
+    */
+   void SetMaxBuffered(size_t size);
+
    /** Sets the merge options. SetMergeOptions("fast") will disable
     * recompression of input data into the output if they have different
     * compression settings.
@@ -107,15 +121,22 @@ private:
 
    void Init(std::unique_ptr<TFile>);
 
+   /** Element of the queue of buffers waiting to be merged */
+   struct QueueNode {
+      TBufferFile *fBuffer; //< Buffer to merge
+      QueueNode *fNext;     //< Buffer pushed before this one
+   };
+
    void Merge();
    void Push(TBufferFile *buffer);
 
    size_t fAutoSave{0};                                          //< AutoSave only every fAutoSave bytes
-   size_t fBuffered{0};                                          //< Number of bytes currently buffered
+   size_t fMaxBuffered{0};                                       //< Writers block when more bytes are buffered
+   std::atomic<size_t> fBuffered{0};                             //< Number of bytes currently buffered
+   std::atomic<size_t> fQueueSize{0};                            //< Number of buffers currently in the queue
    TFileMerger fMerger{false, false};                            //< TFileMerger used to merge all buffers
    std::mutex fMergeMutex;                                       //< Mutex used to lock fMerger
-   std::mutex fQueueMutex;                                       //< Mutex used to lock fQueue
-   std::queue<TBufferFile *> fQueue;                             //< Queue to which data is pushed and merged
+   std::atomic<QueueNode *> fQueue{nullptr};                     //< Lock-free stack of the buffers to merge, last pushed first
    std::vector<std::weak_ptr<TBufferMergerFile>> fAttachedFiles; //< Attached files
 };
 
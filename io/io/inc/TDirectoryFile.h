@@ -29,6 +29,12 @@ class TBrowser;
 class TKey;
 class TFile;
 
+namespace ROOT {
+namespace Internal {
+struct RKeyIndex;
+}
+}
+
 class TDirectoryFile : public TDirectory {
 
 protected:
@@ -44,9 +50,14 @@ protected:
    Long64_t    fSeekKeys;        ///< Location of Keys record on file
    TFile      *fFile;            ///< Pointer to current file in memory
    TList      *fKeys;            ///< Pointer to keys list in memory
+   ROOT::Internal::RKeyIndex *fKeyIndex; ///<!Index of the keys not yet read (lazy keys mode only)
 
    virtual void         CleanTargets();
    void Init(TClass *cl = 0);
+   Int_t                CountKeysOfClass(const char *classname) const;
+   TKey                *GetLazyKey(const char *name, Short_t cycle, Bool_t exactCycle);
+   void                 MaterializeKeys();
+   void                 ResetKeyIndex();
 
 private:
    TDirectoryFile(const TDirectoryFile &directory);  //Directories cannot be copied
@@ -88,10 +99,10 @@ public:
    const TDatime      &GetCreationDate() const { return fDatimeC; }
    virtual TFile      *GetFile() const { return fFile; }
    virtual TKey       *GetKey(const char *name, Short_t cycle=9999) const;
-   virtual TList      *GetListOfKeys() const { return fKeys; }
+   virtual TList      *GetListOfKeys() const;
    const TDatime      &GetModificationDate() const { return fDatimeM; }
    virtual Int_t       GetNbytesKeys() const { return fNbytesKeys; }
-   virtual Int_t       GetNkeys() const { return fKeys->GetSize(); }
+   virtual Int_t       GetNkeys() const;
    virtual Long64_t    GetSeekDir() const { return fSeekDir; }
    virtual Long64_t    GetSeekParent() const { return fSeekParent; }
    virtual Long64_t    GetSeekKeys() const { return fSeekKeys; }
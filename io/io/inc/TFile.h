@@ -100,9 +100,12 @@ protected:
    Bool_t           fInitDone : 1;   ///<!True if the file has been initialized
    Bool_t           fMustFlush : 1;  ///<!True if the file buffers must be flushed
    Bool_t           fIsPcmFile : 1;  ///<!True if the file is a ROOT pcm file.
+   Bool_t           fLazyKeys : 1;   ///<!True if the keys of the directories are only created when looked up
    TFileOpenHandle *fAsyncHandle;    ///<!For proper automatic cleanup
    EAsyncOpenStatus fAsyncOpenStatus; ///<!Status of an asynchronous open request
    TUrl             fUrl;            ///<!URL of file
+   char            *fMMapBuffer;     ///<!Start of the read-only memory mapping of the file (if any)
+   Long64_t         fMMapSize;       ///<!Number of bytes covered by fMMapBuffer
 
    TList           *fInfoCache;      ///<!Cached list of the streamer infos in this file
    TList           *fOpenPhases;     ///<!Time info about open phases
@@ -126,11 +129,14 @@ protected:
    static std::atomic<Long64_t>  fgFileCounter;           ///<Counter for all opened files
    static std::atomic<Int_t>     fgReadCalls;             ///<Number of bytes read from all TFile objects
    static Int_t     fgReadaheadSize;         ///<Readahead buffer size
+   static std::atomic<Int_t> fgParallelReadThreads; ///<Number of threads serving ReadBuffers for local files (-1: not yet taken from gEnv)
    static Bool_t    fgReadInfo;              ///<if true (default) ReadStreamerInfo is called when opening a file
    virtual EAsyncOpenStatus GetAsyncOpenStatus() { return fAsyncOpenStatus; }
    virtual void  Init(Bool_t create);
    Bool_t                    FlushWriteCache();
    Int_t                     ReadBufferViaCache(char *buf, Int_t len);
+   Bool_t                    ReadBufferViaMap(char *buf, Long64_t pos, Int_t len);
+   Int_t                     ReadBuffersParallel(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf);
    Int_t                     WriteBufferViaCache(const char *buf, Int_t len);
 
    ////////////////////////////////////////////////////////////////////////////////
@@ -166,6 +172,8 @@ private:
    TFile(const TFile &);            //Files cannot be copied
    void operator=(const TFile &);
 
+   void          MapFile();
+   void          UnmapFile();
    static void   CpProgress(Long64_t bytesread, Long64_t size, TStopwatch &watch);
    static TFile *OpenFromCache(const char *name, Option_t * = "",
                                const char *ftitle = "", Int_t compress = ROOT::RCompressionSetting::EDefaults::kUseGeneralPurpose,
@@ -216,6 +224,7 @@ public:
    virtual Int_t       GetErrno() const;
    virtual void        ResetErrno() const;
    Int_t               GetFd() const { return fD; }
+   const char         *GetMappedBuffer(Long64_t pos, Int_t len);
    virtual const TUrl *GetEndpointUrl() const { return &fUrl; }
    TObjArray          *GetListOfProcessIDs() const {return fProcessIDs;}
    TList              *GetListOfFree() const { return fFree; }
@@ -241,6 +250,8 @@ public:
    virtual void        IncrementProcessIDs() { fNProcessIDs++; }
    virtual Bool_t      IsArchive() const { return fIsArchive; }
            Bool_t      IsBinary() const { return TestBit(kBinaryFile); }
+           Bool_t      IsLazyKeys() const { return fLazyKeys; }
+           Bool_t      IsMapped() const { return fMMapBuffer != nullptr; }
            Bool_t      IsRaw() const { return !fIsRootFile; }
    virtual Bool_t      IsOpen() const;
    virtual void        ls(Option_t *option="") const;
@@ -302,11 +313,13 @@ public:
    static Long64_t     GetFileBytesWritten();
    static Int_t        GetFileReadCalls();
    static Int_t        GetReadaheadSize();
+   static Int_t        GetParallelReadThreads();
 
    static void         SetFileBytesRead(Long64_t bytes = 0);
    static void         SetFileBytesWritten(Long64_t bytes = 0);
    static void         SetFileReadCalls(Int_t readcalls = 0);
    static void         SetReadaheadSize(Int_t bufsize = 256000);
+   static void         SetParallelReadThreads(Int_t nthreads = 0);
    static void         SetReadStreamerInfo(Bool_t readinfo=kTRUE);
    static Bool_t       GetReadStreamerInfo();
 
@@ -25,6 +25,9 @@ class TDirectory;
 
 namespace ROOT {
 class TIOFeatures;
+namespace Internal {
+class RMergeQueue;
+}  // namespace Internal
 }  // namespace ROOT
 
 class TFileMerger : public TObject {
@@ -54,6 +57,9 @@ protected:
    TString        fObjectNames;               ///< List of object names to be either merged exclusively or skipped
    TList          fMergeList;                 ///< list of TObjString containing the name of the files need to be merged
    TList          fExcessFiles;               ///<! List of TObjString containing the name of the files not yet added to fFileList due to user or system limitiation on the max number of files opened.
+   Int_t          fNThreads{0};               ///< Number of objects merged concurrently (0: sequential merge)
+   Long64_t       fMaxMergeBytes{256*1024*1024}; ///< Maximum size of the inputs of the objects merged concurrently
+   ROOT::Internal::RMergeQueue *fMergeQueue{nullptr}; ///<! Merges running concurrently during PartialMerge (if fNThreads > 0)
 
    Bool_t         OpenExcessFiles();
    virtual Bool_t AddFile(TFile *source, Bool_t own, Bool_t cpProgress);
@@ -86,6 +92,10 @@ public:
    TFile      *GetOutputFile() const { return fOutputFile; }
    Int_t       GetMaxOpenedFiles() const { return fMaxOpenedFiles; }
    void        SetMaxOpenedFiles(Int_t newmax);
+   Int_t       GetNThreads() const { return fNThreads; }
+   void        SetNThreads(Int_t nthreads);
+   Long64_t    GetMaxMergeBytes() const { return fMaxMergeBytes; }
+   void        SetMaxMergeBytes(Long64_t bytes) { fMaxMergeBytes = bytes; }
    const char *GetMsgPrefix() const { return fMsgPrefix; }
    void        SetMsgPrefix(const char *prefix);
    const char *GetMergeOptions() { return fMergeOptions; }
@@ -117,7 +127,7 @@ public:
    virtual void   SetNotrees(Bool_t notrees=kFALSE) {fNoTrees = notrees;}
    virtual void        RecursiveRemove(TObject *obj);
 
-   ClassDef(TFileMerger, 6)  // File copying and merging services
+   ClassDef(TFileMerger, 7)  // File copying and merging services
 };
 
 #endif
@@ -0,0 +1,240 @@
+// @(#)root/io:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RReadEngine.hxx"
+
+#include <ROOT/RConfig.hxx>
+
+#include <algorithm>
+#include <cerrno>
+#include <memory>
+
+#ifndef WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <climits>
+#endif
+
+namespace {
+
+/// Largest number of bytes read by a single vectored read.
+constexpr Long64_t kMaxSegmentSize = 16 * 1024 * 1024;
+
+#ifndef WIN32
+#ifdef IOV_MAX
+constexpr Int_t kMaxSegmentRequests = IOV_MAX / 2;
+#else
+constexpr Int_t kMaxSegmentRequests = 512;
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read into all iov entries starting at offset, resuming after short reads.
+
+bool R__PReadV(int fd, struct iovec *iov, int iovcnt, Long64_t offset)
+{
+   while (iovcnt > 0) {
+#if defined(R__LINUX) || defined(R__FBSD) || defined(R__OBSD)
+      ssize_t n = ::preadv(fd, iov, iovcnt, offset);
+#else
+      ssize_t n = ::pread(fd, iov->iov_base, iov->iov_len, offset);
+#endif
+      if (n < 0) {
+         if (errno == EINTR)
+            continue;
+         return false;
+      }
+      if (n == 0)
+         return false; // Unexpected end of file.
+      offset += n;
+      while (iovcnt > 0 && (size_t)n >= iov->iov_len) {
+         n -= iov->iov_len;
+         ++iov;
+         --iovcnt;
+      }
+      if (n > 0) {
+         iov->iov_base = (char *)iov->iov_base + n;
+         iov->iov_len -= n;
+      }
+   }
+   return true;
+}
+#endif
+
+} // anonymous namespace
+
+using namespace ROOT::Internal;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create an engine with nThreads worker threads; with nThreads == 0 the reads
+/// are issued sequentially by the calling thread. Requests separated by at most
+/// maxGap bytes are served by a single vectored read; the bytes in between are
+/// read and dropped.
+
+RReadEngine::RReadEngine(UInt_t nThreads, Long64_t maxGap) : fMaxGap(maxGap < 0 ? 0 : maxGap)
+{
+   fWorkers.reserve(nThreads);
+   for (UInt_t i = 0; i < nThreads; ++i)
+      fWorkers.emplace_back(&RReadEngine::WorkerLoop, this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Finish the queued reads and join the worker threads.
+
+RReadEngine::~RReadEngine()
+{
+   {
+      std::lock_guard<std::mutex> lock(fQueueMutex);
+      fStop = true;
+   }
+   fQueueCond.notify_all();
+   for (auto &worker : fWorkers)
+      worker.join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Execute queued segment reads until the engine is destroyed.
+
+void RReadEngine::WorkerLoop()
+{
+   while (true) {
+      std::function<void()> task;
+      {
+         std::unique_lock<std::mutex> lock(fQueueMutex);
+         fQueueCond.wait(lock, [this] { return fStop || !fQueue.empty(); });
+         if (fQueue.empty())
+            return;
+         task = std::move(fQueue.front());
+         fQueue.pop_front();
+      }
+      task();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sort the requests by position and merge the ones that are close enough in
+/// the file into segments, each served by one system call.
+
+std::vector<RReadEngine::RSegment> RReadEngine::MakeSegments(const RReadRequest *requests, Int_t nreq) const
+{
+   std::vector<const RReadRequest *> sorted;
+   sorted.reserve(nreq);
+   for (Int_t i = 0; i < nreq; ++i) {
+      if (requests[i].fLen > 0)
+         sorted.push_back(&requests[i]);
+   }
+   std::sort(sorted.begin(), sorted.end(),
+             [](const RReadRequest *a, const RReadRequest *b) { return a->fOffset < b->fOffset; });
+
+   std::vector<RSegment> segments;
+   for (auto req : sorted) {
+      Long64_t end = req->fOffset + req->fLen;
+      if (!segments.empty()) {
+         RSegment &last = segments.back();
+         // Overlapping requests cannot be scattered by a single call.
+         if (req->fOffset >= last.fEnd && req->fOffset - last.fEnd <= fMaxGap &&
+             end - last.fBegin <= kMaxSegmentSize
+#ifndef WIN32
+             && (Int_t)last.fRequests.size() < kMaxSegmentRequests
+#endif
+            ) {
+            last.fRequests.push_back(req);
+            last.fEnd = end;
+            continue;
+         }
+      }
+      segments.emplace_back();
+      segments.back().fRequests.push_back(req);
+      segments.back().fBegin = req->fOffset;
+      segments.back().fEnd = end;
+   }
+   return segments;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read one segment; the holes between its requests go to a scratch buffer.
+
+Bool_t RReadEngine::ReadSegment(Int_t fd, const RSegment &segment) const
+{
+#ifndef WIN32
+   std::unique_ptr<char[]> scratch;
+   std::vector<struct iovec> iov;
+   iov.reserve(2 * segment.fRequests.size());
+   Long64_t pos = segment.fBegin;
+   for (auto req : segment.fRequests) {
+      if (req->fOffset > pos) {
+         if (!scratch)
+            scratch.reset(new char[fMaxGap]);
+         iov.push_back({scratch.get(), (size_t)(req->fOffset - pos)});
+      }
+      iov.push_back({req->fBuffer, (size_t)req->fLen});
+      pos = req->fOffset + req->fLen;
+   }
+   return R__PReadV(fd, iov.data(), iov.size(), segment.fBegin);
+#else
+   (void)fd;
+   (void)segment;
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the nreq requests from the file descriptor fd and wait for their completion.
+///
+/// The segments are read concurrently by the worker threads; callback (if any)
+/// is invoked for every request as soon as its segment is read, from the thread
+/// that read it. Returns the number of segments the requests were merged into
+/// (see MakeSegments), or -1 if any of the reads failed.
+
+Int_t RReadEngine::ReadV(Int_t fd, const RReadRequest *requests, Int_t nreq, const Callback_t &callback)
+{
+   std::vector<RSegment> segments = MakeSegments(requests, nreq);
+   const Int_t nsegments = segments.size();
+
+   auto complete = [&callback](const RSegment &segment, bool ok) {
+      if (callback) {
+         for (auto req : segment.fRequests)
+            callback(*req, ok);
+      }
+   };
+
+   if (fWorkers.empty() || nsegments < 2) {
+      Bool_t ok = kTRUE;
+      for (auto &segment : segments) {
+         Bool_t segmentOk = ReadSegment(fd, segment);
+         complete(segment, segmentOk);
+         ok &= segmentOk;
+      }
+      return ok ? nsegments : -1;
+   }
+
+   std::mutex doneMutex;
+   std::condition_variable doneCond;
+   Int_t pending = nsegments;
+   Bool_t ok = kTRUE;
+   {
+      std::lock_guard<std::mutex> lock(fQueueMutex);
+      for (auto &segment : segments) {
+         fQueue.emplace_back([&, fd] {
+            Bool_t segmentOk = ReadSegment(fd, segment);
+            complete(segment, segmentOk);
+            std::lock_guard<std::mutex> doneLock(doneMutex);
+            ok &= segmentOk;
+            if (--pending == 0)
+               doneCond.notify_one();
+         });
+      }
+   }
+   fQueueCond.notify_all();
+
+   std::unique_lock<std::mutex> doneLock(doneMutex);
+   doneCond.wait(doneLock, [&pending] { return pending == 0; });
+   return ok ? nsegments : -1;
+}
@@ -47,7 +47,7 @@ TBufferMerger::~TBufferMerger()
    for (const auto &f : fAttachedFiles)
       if (!f.expired()) Fatal("TBufferMerger", " TBufferMergerFiles must be destroyed before the server");
 
-   if (!fQueue.empty())
+   if (fQueue.load())
       Merge();
 }
 
@@ -62,18 +62,23 @@ std::shared_ptr<TBufferMergerFile> TBufferMerger::GetFile()
 
 size_t TBufferMerger::GetQueueSize() const
 {
-   return fQueue.size();
+   return fQueueSize;
 }
 
 void TBufferMerger::Push(TBufferFile *buffer)
 {
-   {
-      std::lock_guard<std::mutex> lock(fQueueMutex);
-      fBuffered += buffer->BufferSize();
-      fQueue.push(buffer);
-   }
-
-   if (fBuffered > fAutoSave)
+   // Account for the buffer before publishing it, so that the merging thread
+   // never subtracts a size that has not been added yet.
+   fBuffered += buffer->BufferSize();
+   ++fQueueSize;
+
+   QueueNode *node = new QueueNode{buffer, fQueue.load(std::memory_order_relaxed)};
+   while (!fQueue.compare_exchange_weak(node->fNext, node, std::memory_order_release, std::memory_order_relaxed))
+      ;
+
+   // Merge once fAutoSave bytes are buffered; above fMaxBuffered, block until
+   // the buffers are merged whatever fAutoSave is.
+   if (fBuffered > fAutoSave || (fMaxBuffered > 0 && fBuffered > fMaxBuffered))
       Merge();
 }
 
@@ -82,6 +87,11 @@ size_t TBufferMerger::GetAutoSave() const
    return fAutoSave;
 }
 
+size_t TBufferMerger::GetMaxBuffered() const
+{
+   return fMaxBuffered;
+}
+
 const char *TBufferMerger::GetMergeOptions()
 {
    return fMerger.GetMergeOptions();
@@ -93,6 +103,11 @@ void TBufferMerger::SetAutoSave(size_t size)
    fAutoSave = size;
 }
 
+void TBufferMerger::SetMaxBuffered(size_t size)
+{
+   fMaxBuffered = size;
+}
+
 void TBufferMerger::SetMergeOptions(const TString& options)
 {
    fMerger.SetMergeOptions(options);
@@ -100,24 +115,40 @@ void TBufferMerger::SetMergeOptions(const TString& options)
 
 void TBufferMerger::Merge()
 {
-   if (fMergeMutex.try_lock()) {
-      std::queue<TBufferFile *> queue;
-      {
-         std::lock_guard<std::mutex> q(fQueueMutex);
-         std::swap(queue, fQueue);
-         fBuffered = 0;
-      }
-
-      while (!queue.empty()) {
-         std::unique_ptr<TBufferFile> buffer{queue.front()};
-         fMerger.AddAdoptFile(new TMemFile(fMerger.GetOutputFileName(), std::move(buffer)));
-         queue.pop();
-      }
-
-      fMerger.PartialMerge();
-      fMerger.Reset();
-      fMergeMutex.unlock();
+   std::unique_lock<std::mutex> lock(fMergeMutex, std::defer_lock);
+   if (fMaxBuffered > 0 && fBuffered > fMaxBuffered) {
+      // Back-pressure: wait for the merge in progress, then merge what is left.
+      lock.lock();
+   } else if (!lock.try_lock()) {
+      return;
+   }
+
+   // Take all the queued buffers at once and restore the order in which they were pushed.
+   QueueNode *node = fQueue.exchange(nullptr, std::memory_order_acquire);
+   if (!node)
+      return;
+   QueueNode *first = nullptr;
+   while (node) {
+      QueueNode *next = node->fNext;
+      node->fNext = first;
+      first = node;
+      node = next;
    }
+
+   while (first) {
+      std::unique_ptr<TBufferFile> buffer{first->fBuffer};
+      fBuffered -= buffer->BufferSize();
+      --fQueueSize;
+      // The TMemFiles have the compression settings of the output file, so the
+      // baskets of their trees are copied as they are (see TTreeCloner).
+      fMerger.AddAdoptFile(new TMemFile(fMerger.GetOutputFileName(), std::move(buffer)));
+      QueueNode *next = first->fNext;
+      delete first;
+      first = next;
+   }
+
+   fMerger.PartialMerge();
+   fMerger.Reset();
 }
 
 } // namespace Experimental
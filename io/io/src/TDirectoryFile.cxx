@@ -48,11 +48,105 @@ End_Macro
 #include "TVirtualMutex.h"
 #include "TEmulatedCollectionProxy.h"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
 const UInt_t kIsBigFile = BIT(16);
 const Int_t  kMaxLen = 2048;
 
+#if !defined(_MSC_VER) || (_MSC_VER>1300)
+const ULong64_t kPidOffsetMask = 0xffffffffffffULL;
+#else
+const ULong64_t kPidOffsetMask = 0xffffffffffffUL;
+#endif
+
 ClassImp(TDirectoryFile);
 
+namespace ROOT {
+namespace Internal {
+
+/// Index of the keys record of a directory read in lazy keys mode (see
+/// TFile::IsLazyKeys). The key headers are located and validated when the
+/// directory is read, but a TKey is only created once it is looked up.
+struct RKeyIndex {
+   struct RRecord {
+      char       *fHeader = nullptr;    ///< Start of the key header in the keys record
+      const char *fClassName = nullptr; ///< Class name of the key (not null terminated)
+      Int_t       fClassNameLen = 0;    ///< Length of fClassName
+      const char *fName = nullptr;      ///< Name of the key (not null terminated)
+      Int_t       fNameLen = 0;         ///< Length of fName
+      Short_t     fCycle = 0;           ///< Cycle number of the key
+      TKey       *fKey = nullptr;       ///< The key, once created (owned by fKeys)
+   };
+
+   std::unique_ptr<TKey> fHeaderKey;                  ///< Owns the buffer holding the keys record
+   std::vector<RRecord> fRecords;                     ///< One entry per key, in the order of the keys record
+   std::vector<std::pair<UInt_t, Int_t>> fNameHashes; ///< (hash of the key name, record index), sorted
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Locate a string written by TString::FillBuffer, without copying it.
+
+Bool_t R__LocateKeyString(char *&buffer, const char *end, const char *&str, Int_t &len)
+{
+   if (buffer >= end) return kFALSE;
+   UChar_t nwh;
+   frombuf(buffer, &nwh);
+   if (nwh == 255) {
+      if (end - buffer < (Long64_t)sizeof(Int_t)) return kFALSE;
+      frombuf(buffer, &len);
+   } else {
+      len = nwh;
+   }
+   if (len < 0 || end - buffer < len) return kFALSE;
+   str = buffer;
+   buffer += len;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Index the key header written by TKey::FillBuffer at buffer, without creating
+/// the TKey; see TKey::ReadKeyBuffer for the layout.
+
+Bool_t R__IndexKeyHeader(char *&buffer, const char *end, ROOT::Internal::RKeyIndex::RRecord &record,
+                         Long64_t &seekKey, Long64_t &seekPdir)
+{
+   record.fHeader = buffer;
+   // fNbytes, fVersion, fObjlen, fDatime, fKeylen and fCycle.
+   if (end - buffer < 18) return kFALSE;
+   buffer += sizeof(Int_t);
+   Version_t version;
+   frombuf(buffer, &version);
+   buffer += sizeof(Int_t) + sizeof(UInt_t) + sizeof(Short_t);
+   frombuf(buffer, &record.fCycle);
+   if (version > 1000) {
+      if (end - buffer < 16) return kFALSE;
+      Long64_t pdir;
+      frombuf(buffer, &seekKey);
+      frombuf(buffer, &pdir);
+      seekPdir = pdir & kPidOffsetMask;
+   } else {
+      if (end - buffer < 8) return kFALSE;
+      UInt_t seekkey, seekdir;
+      frombuf(buffer, &seekkey); seekKey  = (Long64_t)seekkey;
+      frombuf(buffer, &seekdir); seekPdir = (Long64_t)seekdir;
+   }
+   const char *title;
+   Int_t titleLen;
+   return R__LocateKeyString(buffer, end, record.fClassName, record.fClassNameLen)
+          && R__LocateKeyString(buffer, end, record.fName, record.fNameLen)
+          && R__LocateKeyString(buffer, end, title, titleLen);
+}
+
+} // anonymous namespace
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default Constructor
@@ -60,7 +154,7 @@ ClassImp(TDirectoryFile);
 TDirectoryFile::TDirectoryFile() : TDirectory()
    , fModified(kFALSE), fWritable(kFALSE), fNbytesKeys(0), fNbytesName(0)
    , fBufferSize(0), fSeekDir(0), fSeekParent(0), fSeekKeys(0)
-   , fFile(0), fKeys(0)
+   , fFile(0), fKeys(0), fKeyIndex(0)
 {
 }
 
@@ -80,7 +174,7 @@ TDirectoryFile::TDirectoryFile(const char *name, const char *title, Option_t *cl
            : TDirectory()
    , fModified(kFALSE), fWritable(kFALSE), fNbytesKeys(0), fNbytesName(0)
    , fBufferSize(0), fSeekDir(0), fSeekParent(0), fSeekKeys(0)
-   , fFile(0), fKeys(0)
+   , fFile(0), fKeys(0), fKeyIndex(0)
 {
    // We must not publish this objects to the list of RecursiveRemove (indirectly done
    // by 'Appending' this object to it's mother) before the object is completely
@@ -180,7 +274,7 @@ void TDirectoryFile::Init(TClass *cl)
 TDirectoryFile::TDirectoryFile(const TDirectoryFile & directory) : TDirectory(directory)
    , fModified(kFALSE), fWritable(kFALSE), fNbytesKeys(0), fNbytesName(0)
    , fBufferSize(0), fSeekDir(0), fSeekParent(0), fSeekKeys(0)
-   , fFile(0), fKeys(0)
+   , fFile(0), fKeys(0), fKeyIndex(0)
 {
    ((TDirectoryFile&)directory).Copy(*this);
 }
@@ -190,6 +284,7 @@ TDirectoryFile::TDirectoryFile(const TDirectoryFile & directory) : TDirectory(di
 
 TDirectoryFile::~TDirectoryFile()
 {
+   ResetKeyIndex();
    if (fKeys) {
       fKeys->Delete("slow");
       SafeDelete(fKeys);
@@ -243,6 +338,8 @@ Int_t TDirectoryFile::AppendKey(TKey *key)
       return 0;
    }
 
+   if (fKeyIndex) MaterializeKeys();
+
    fModified = kTRUE;
 
    key->SetMotherDir(this);
@@ -276,6 +373,8 @@ void TDirectoryFile::Browse(TBrowser *b)
    TString name;
 
    if (b) {
+      if (fKeyIndex) MaterializeKeys();
+
       TObject *obj = 0;
       TIter nextin(fList);
       TKey *key = 0, *keyo = 0;
@@ -587,6 +686,7 @@ void TDirectoryFile::Close(Option_t *option)
    }
 
    // Delete keys from key list (but don't delete the list header)
+   ResetKeyIndex();
    if (fKeys) {
       fKeys->Delete("slow");
    }
@@ -950,6 +1050,13 @@ TObject *TDirectoryFile::Get(const char *namecycle)
 //*-*---------------------Case of Key---------------------
 //                        ===========
    TKey *key;
+   if (fKeyIndex) {
+      if ((key = GetLazyKey(namobj, cycle, kTRUE))) {
+         TDirectory::TContext ctxt(this);
+         idcur = key->ReadObj();
+      }
+      return idcur;
+   }
    TIter nextkey(GetListOfKeys());
    while ((key = (TKey *) nextkey())) {
       if (strcmp(namobj,key->GetName()) == 0) {
@@ -1070,6 +1177,13 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
 //                        ===========
    void *idcur = 0;
    TKey *key;
+   if (fKeyIndex) {
+      if ((key = GetLazyKey(namobj, cycle, kTRUE))) {
+         TDirectory::TContext ctxt(this);
+         idcur = key->ReadObjectAny(expectedClass);
+      }
+      return idcur;
+   }
    TIter nextkey(GetListOfKeys());
    while ((key = (TKey *) nextkey())) {
       if (strcmp(namobj,key->GetName()) == 0) {
@@ -1106,6 +1220,9 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
 {
    if (!fKeys) return nullptr;
 
+   // Looking a key up in lazy keys mode creates it, as GetListOfKeys does.
+   if (fKeyIndex) return const_cast<TDirectoryFile *>(this)->GetLazyKey(name, cycle, kFALSE);
+
    // TIter::TIter() already checks for null pointers
    TIter next( ((THashList *)(GetListOfKeys()))->GetListForObject(name) );
 
@@ -1120,6 +1237,112 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the list of keys of this directory.
+///
+/// In lazy keys mode (see TFile::IsLazyKeys) this creates all the keys not
+/// looked up so far.
+
+TList *TDirectoryFile::GetListOfKeys() const
+{
+   if (fKeyIndex) const_cast<TDirectoryFile *>(this)->MaterializeKeys();
+   return fKeys;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of keys in this directory.
+
+Int_t TDirectoryFile::GetNkeys() const
+{
+   if (fKeyIndex) return fKeyIndex->fRecords.size();
+   return fKeys->GetSize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Look up a key by name in the index of the keys record and create it if
+/// needed; only used in lazy keys mode.
+///
+/// With cycle = 9999 the first key with the given name is returned, otherwise
+/// the first one with exactly this cycle (exactCycle, as in Get) or with a
+/// cycle not larger than it (as in GetKey). The keys are considered in the
+/// order of the keys record, i.e. the order of the list of keys.
+
+TKey *TDirectoryFile::GetLazyKey(const char *name, Short_t cycle, Bool_t exactCycle)
+{
+   if (!fKeyIndex) return nullptr;
+
+   const Int_t len = strlen(name);
+   const UInt_t hash = TString::Hash(name, len);
+   auto &hashes = fKeyIndex->fNameHashes;
+   auto iter = std::lower_bound(hashes.begin(), hashes.end(), std::make_pair(hash, 0));
+   for (; iter != hashes.end() && iter->first == hash; ++iter) {
+      auto &record = fKeyIndex->fRecords[iter->second];
+      if (record.fNameLen != len || memcmp(record.fName, name, len))
+         continue;
+      if (cycle != 9999 && (exactCycle ? cycle != record.fCycle : cycle < record.fCycle))
+         continue;
+      if (!record.fKey) {
+         char *buffer = record.fHeader;
+         record.fKey = new TKey(this);
+         record.fKey->ReadKeyBuffer(buffer);
+         fKeys->Add(record.fKey);
+      }
+      return record.fKey;
+   }
+   return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the keys that have not been looked up yet and leave the lazy keys
+/// mode: fKeys then holds all the keys, in the order of the keys record.
+
+void TDirectoryFile::MaterializeKeys()
+{
+   if (!fKeyIndex) return;
+
+   fKeys->Clear("nodelete");
+   for (auto &record : fKeyIndex->fRecords) {
+      if (!record.fKey) {
+         char *buffer = record.fHeader;
+         record.fKey = new TKey(this);
+         record.fKey->ReadKeyBuffer(buffer);
+      }
+      fKeys->Add(record.fKey);
+   }
+   ResetKeyIndex();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Drop the index of the keys record; the keys already created stay in fKeys.
+
+void TDirectoryFile::ResetKeyIndex()
+{
+   delete fKeyIndex;
+   fKeyIndex = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of keys of the given class, without creating the keys
+/// in lazy keys mode.
+
+Int_t TDirectoryFile::CountKeysOfClass(const char *classname) const
+{
+   Int_t count = 0;
+   if (fKeyIndex) {
+      const Int_t len = strlen(classname);
+      for (auto &record : fKeyIndex->fRecords) {
+         if (record.fClassNameLen == len && !memcmp(record.fClassName, classname, len)) count++;
+      }
+      return count;
+   }
+   TIter next(fKeys);
+   TKey *key;
+   while ((key = (TKey*)next())) {
+      if (!strcmp(key->GetClassName(), classname)) count++;
+   }
+   return count;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// List Directory contents
 ///
@@ -1337,6 +1560,7 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 
    char *buffer;
    if (forceRead) {
+      ResetKeyIndex();
       fKeys->Delete();
       //In case directory was updated by another process, read new
       //position for the keys
@@ -1375,8 +1599,33 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
       TKey *headerkey    = new TKey(fSeekKeys, fNbytesKeys, this);
       headerkey->ReadFile();
       buffer = headerkey->GetBuffer();
+      const char *end = buffer + fNbytesKeys - headerkey->GetKeylen();
       headerkey->ReadKeyBuffer(buffer);
 
+      if (fFile->IsLazyKeys() && !fWritable) {
+         // Only index the key headers, the TKeys are created by GetLazyKey.
+         ResetKeyIndex();
+         fKeyIndex = new ROOT::Internal::RKeyIndex;
+         fKeyIndex->fHeaderKey.reset(headerkey);
+         if (end - buffer < (Long64_t)sizeof(Int_t)) return 0;
+         frombuf(buffer, &nkeys);
+         fKeyIndex->fRecords.reserve(std::max(0, std::min<Int_t>(nkeys, (end - buffer) / 18)));
+         for (Int_t i = 0; i < nkeys; i++) {
+            ROOT::Internal::RKeyIndex::RRecord record;
+            Long64_t seekKey = 0, seekPdir = 0;
+            if (!R__IndexKeyHeader(buffer, end, record, seekKey, seekPdir)
+                || seekKey < 64 || seekKey > fsize || seekPdir < 64 || seekPdir > fsize) {
+               Error("ReadKeys","reading illegal key, exiting after %d keys",i);
+               nkeys = i;
+               break;
+            }
+            fKeyIndex->fRecords.push_back(record);
+            fKeyIndex->fNameHashes.emplace_back(TString::Hash(record.fName, record.fNameLen), i);
+         }
+         std::sort(fKeyIndex->fNameHashes.begin(), fKeyIndex->fNameHashes.end());
+         return nkeys;
+      }
+
       TKey *key;
       frombuf(buffer, &nkeys);
       for (Int_t i = 0; i < nkeys; i++) {
@@ -1449,6 +1698,7 @@ void TDirectoryFile::ResetAfterMerge(TFileMergeInfo *info)
    fSeekParent = 0; // updated by Init
    fSeekKeys = 0;   // updated by Init
    // Does not change: fFile
+   if (fKeyIndex) MaterializeKeys();
    TKey *key = fKeys ? (TKey*)fKeys->FindObject(fName) : nullptr;
    TClass *cl = IsA();
    if (key) {
@@ -1625,6 +1875,9 @@ void TDirectoryFile::SetWritable(Bool_t writable)
 {
    TDirectory::TContext ctxt(this);
 
+   // Keys are only created lazily for read-only directories.
+   if (writable && fKeyIndex) MaterializeKeys();
+
    fWritable = writable;
 
    // recursively set all sub-directories
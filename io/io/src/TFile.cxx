@@ -84,6 +84,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include <sys/stat.h>
 #ifndef WIN32
 #   include <unistd.h>
+#   include <sys/mman.h>
 #else
 #   define ssize_t int
 #   include <io.h>
@@ -127,6 +128,9 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TStopwatch.h"
 #include "compiledata.h"
 #include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <set>
 #include "TSchemaRule.h"
 #include "TSchemaRuleSet.h"
@@ -134,6 +138,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TGlobal.h"
 #include "ROOT/RMakeUnique.hxx"
 #include "ROOT/RConcurrentHashColl.hxx"
+#include "ROOT/RReadEngine.hxx"
 
 using std::sqrt;
 
@@ -142,6 +147,7 @@ std::atomic<Long64_t> TFile::fgBytesWrite{0};
 std::atomic<Long64_t> TFile::fgFileCounter{0};
 std::atomic<Int_t>    TFile::fgReadCalls{0};
 Int_t    TFile::fgReadaheadSize = 256000;
+std::atomic<Int_t> TFile::fgParallelReadThreads{-1};
 Bool_t   TFile::fgReadInfo = kTRUE;
 TList   *TFile::fgAsyncOpenRequests = 0;
 TString  TFile::fgCacheFileDir;
@@ -191,12 +197,15 @@ TFile::TFile() : TDirectoryFile(), fCompress(ROOT::RCompressionSetting::EAlgorit
    fReadCalls       = 0;
    fInfoCache       = 0;
    fOpenPhases      = 0;
+   fMMapBuffer      = 0;
+   fMMapSize        = 0;
    fNoAnchorInName  = kFALSE;
    fIsRootFile      = kTRUE;
    fIsArchive       = kFALSE;
    fInitDone        = kFALSE;
    fMustFlush       = kTRUE;
    fIsPcmFile       = kFALSE;
+   fLazyKeys        = kFALSE;
    fAsyncHandle     = 0;
    fAsyncOpenStatus = kAOSNotAsync;
    SetBit(kBinaryFile, kTRUE);
@@ -247,6 +256,20 @@ TFile::TFile() : TDirectoryFile(), fCompress(ROOT::RCompressionSetting::EAlgorit
 ///
 ///     file:///user/rdm/bla.root or file:/user/rdm/bla.root
 ///
+/// A file opened for reading can be memory-mapped by appending the option
+/// `?mmap=yes` to the file name (or globally by setting "TFile.MMap: yes"
+/// in the system.rootrc). Reads are then served from the mapping instead of
+/// read() system calls, uncompressed keys and baskets are streamed in place
+/// and compressed ones are inflated directly from the mapped pages; see
+/// TFile::GetMappedBuffer.
+///
+/// When opening a file with many keys only to read a few objects, appending
+/// the option `?lazykeys=yes` (or setting "TFile.LazyKeys: yes") makes the
+/// directories of a file opened for reading only index their keys record:
+/// a TKey is created when it is looked up by Get, GetObjectChecked or GetKey,
+/// and all of them when the list of keys is requested (see
+/// TDirectoryFile::GetListOfKeys).
+///
 /// The file can also be a member of an archive, in which case it is
 /// specified as:
 ///
@@ -350,6 +373,9 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
    if (strstr(fUrl.GetOptions(), "filetype=pcm"))
       fIsPcmFile = kTRUE;
 
+   // if option contains lazykeys=yes then only index the keys of the directories
+   fLazyKeys = strstr(fUrl.GetOptions(), "lazykeys=yes") || gEnv->GetValue("TFile.LazyKeys", 0);
+
    // Init initialization control flag
    fInitDone   = kFALSE;
    fMustFlush  = kTRUE;
@@ -381,6 +407,8 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
    fCacheReadMap = new TMap();
    fCacheWrite   = 0;
    fReadCalls    = 0;
+   fMMapBuffer   = 0;
+   fMMapSize     = 0;
    SetBit(kBinaryFile, kTRUE);
 
    fOption.ToUpper();
@@ -513,6 +541,8 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
          goto zombie;
       }
       fWritable = kFALSE;
+      if (!fArchive && (strstr(fUrl.GetOptions(), "mmap=yes") || gEnv->GetValue("TFile.MMap", 0)))
+         MapFile();
    }
 
    Init(create);
@@ -532,7 +562,7 @@ zombie:
 ////////////////////////////////////////////////////////////////////////////////
 /// TFile objects can not be copied.
 
-TFile::TFile(const TFile &) : TDirectoryFile(), fInfoCache(0)
+TFile::TFile(const TFile &) : TDirectoryFile(), fMMapBuffer(0), fMMapSize(0), fInfoCache(0)
 {
    MayNotUse("TFile::TFile(const TFile &)");
 }
@@ -869,7 +899,7 @@ void TFile::Init(Bool_t create)
             }
          } else if (fVersion != gROOT->GetVersionInt() && fVersion > 30000) {
             // Don't complain about missing streamer info for empty files.
-            if (fKeys->GetSize()) {
+            if (GetNkeys()) {
                Warning("Init","no StreamerInfo found in %s therefore preventing schema evolution when reading this file.",GetName());
             }
          }
@@ -878,11 +908,7 @@ void TFile::Init(Bool_t create)
 
    // Count number of TProcessIDs in this file
    {
-      TIter next(fKeys);
-      TKey *key;
-      while ((key = (TKey*)next())) {
-         if (!strcmp(key->GetClassName(),"TProcessID")) fNProcessIDs++;
-      }
+      fNProcessIDs += CountKeysOfClass("TProcessID");
       fProcessIDs = new TObjArray(fNProcessIDs+1);
    }
    return;
@@ -922,6 +948,7 @@ void TFile::Close(Option_t *option)
       FlushWriteCache();
       SysClose(fD);
       fD = -1;
+      UnmapFile();
 
       if (gMonitoringWriter)
          gMonitoringWriter->SendFileCloseEvent(this);
@@ -979,6 +1006,9 @@ void TFile::Close(Option_t *option)
       fD = -1;
    }
 
+   // The objects pointing into the mapping have been deleted with the directories.
+   UnmapFile();
+
    fWritable = kFALSE;
 
    // delete the TProcessIDs
@@ -1629,6 +1659,9 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
          return kFALSE;
       }
 
+      if (ReadBufferViaMap(buf, pos, len))
+         return kFALSE;
+
       Seek(pos);
       ssize_t siz;
 
@@ -1674,6 +1707,9 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
          return kFALSE;
       }
 
+      if (ReadBufferViaMap(buf, GetRelOffset(), len))
+         return kFALSE;
+
       ssize_t siz;
       Double_t start = 0;
 
@@ -1726,6 +1762,25 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
       return kFALSE;
    }
 
+   // With a memory-mapped file there is nothing to gain from coalescing the
+   // blocks into read-ahead buffers: copy each of them out of the mapping,
+   // falling back to the file descriptor if a block is not covered.
+   if (IsMapped()) {
+      Int_t j = 0;
+      for (Int_t k = 0; j < nbuf; k += len[j], j++) {
+         if (!ReadBufferViaMap(&buf[k], pos[j], len[j]))
+            break;
+      }
+      if (j == nbuf)
+         return kFALSE;
+   }
+
+   if (nbuf > 1 && GetParallelReadThreads() > 0 && IsA() == TFile::Class()) {
+      Int_t st = ReadBuffersParallel(buf, pos, len, nbuf);
+      if (st >= 0)
+         return st;
+   }
+
    Int_t k = 0;
    Bool_t result = kTRUE;
    TFileCacheRead *old = fCacheRead;
@@ -1776,6 +1831,71 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the engine serving ReadBuffers with nthreads threads, creating it if
+/// needed. Callers keep the engine alive while they use it, so that it can be
+/// replaced when the number of threads changes.
+
+static std::shared_ptr<ROOT::Internal::RReadEngine> R__GetReadEngine(Int_t nthreads)
+{
+   static std::mutex engineMutex;
+   static std::shared_ptr<ROOT::Internal::RReadEngine> engine;
+   std::lock_guard<std::mutex> lock(engineMutex);
+   if (!engine || (Int_t)engine->GetNThreads() != nthreads)
+      engine = std::make_shared<ROOT::Internal::RReadEngine>(nthreads);
+   return engine;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the nbuf blocks described in arrays pos and len concurrently.
+///
+/// The blocks are handed over in one go to the ROOT::Internal::RReadEngine,
+/// which merges adjacent blocks into vectored reads and issues them from its
+/// thread pool with positional reads. Returns 0 on success, 1 on failure and
+/// -1 if the blocks must be read sequentially instead.
+
+Int_t TFile::ReadBuffersParallel(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
+{
+#ifndef WIN32
+   if (!IsOpen())
+      return 1;
+
+   std::vector<ROOT::Internal::RReadRequest> requests(nbuf);
+   Long64_t k = 0;
+   for (Int_t i = 0; i < nbuf; ++i) {
+      requests[i].fOffset = pos[i] + fArchiveOffset;
+      requests[i].fLen = len[i];
+      requests[i].fBuffer = &buf[k];
+      k += len[i];
+   }
+
+   Double_t start = 0;
+   if (gPerfStats != 0) start = TTimeStamp();
+
+   auto engine = R__GetReadEngine(GetParallelReadThreads());
+   Int_t ncalls = engine->ReadV(fD, requests.data(), nbuf);
+   if (ncalls < 0) {
+      SysError("ReadBuffers", "error reading from file %s", GetName());
+      return 1;
+   }
+
+   fBytesRead  += k;
+   fgBytesRead += k;
+   fReadCalls  += ncalls;
+   fgReadCalls += ncalls;
+
+   if (gMonitoringWriter)
+      gMonitoringWriter->SendFileReadProgress(this);
+   if (gPerfStats != 0) {
+      gPerfStats->FileReadEvent(this, k, start);
+   }
+   return 0;
+#else
+   (void)buf; (void)pos; (void)len; (void)nbuf;
+   return -1;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read buffer via cache.
 ///
@@ -1811,6 +1931,96 @@ Int_t TFile::ReadBufferViaCache(char *buf, Int_t len)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read buffer via the memory mapping of the file (if any).
+///
+/// Returns kTRUE if the len bytes at position pos were copied into buf, kFALSE
+/// if the file is not mapped or the range is not covered by the mapping, in
+/// which case the caller must read from the file descriptor.
+
+Bool_t TFile::ReadBufferViaMap(char *buf, Long64_t pos, Int_t len)
+{
+   const char *mapped = GetMappedBuffer(pos, len);
+   if (!mapped)
+      return kFALSE;
+
+   memcpy(buf, mapped, len);
+   SetOffset(pos + len);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a pointer to the len bytes at position pos of a memory-mapped file.
+///
+/// Returns 0 if the file was not opened with the `mmap=yes` option, if it is
+/// currently writable or if the requested range is outside the mapping.
+/// Otherwise the bytes are accounted as read, as by ReadBuffer (see
+/// GetBytesRead and gPerfStats), so call this only for the records that are
+/// consumed. The returned memory is read-only and valid until the file is
+/// closed. TKey and TBasket use this to stream uncompressed records in place
+/// and to inflate compressed records from the mapped pages.
+
+const char *TFile::GetMappedBuffer(Long64_t pos, Int_t len)
+{
+   if (!fMMapBuffer || fWritable || pos < 0 || len < 0 || pos + len > fMMapSize)
+      return 0;
+
+   Double_t start = 0;
+   if (gPerfStats != 0) start = TTimeStamp();
+
+   fBytesRead  += len;
+   fgBytesRead += len;
+   fReadCalls++;
+   fgReadCalls++;
+
+   if (gMonitoringWriter)
+      gMonitoringWriter->SendFileReadProgress(this);
+   if (gPerfStats != 0) {
+      gPerfStats->FileReadEvent(this, len, start);
+   }
+   return fMMapBuffer + pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Map the file read-only into memory.
+///
+/// The pages are those of the page cache, so they are shared with all the
+/// processes reading the same file. The mapping is read-only: the records
+/// used in place must not be modified. On failure (or on platforms without
+/// mmap) the file is silently read through the file descriptor.
+
+void TFile::MapFile()
+{
+#ifndef WIN32
+   Long64_t size = SysSeek(fD, 0, SEEK_END);
+   SysSeek(fD, 0, SEEK_SET);
+   if (size <= 0 || (ULong64_t)size > (ULong64_t)std::numeric_limits<size_t>::max())
+      return;
+   void *addr = ::mmap(0, (size_t)size, PROT_READ, MAP_PRIVATE, fD, 0);
+   if (addr == MAP_FAILED) {
+      if (gDebug)
+         Info("MapFile", "cannot map %s into memory (errno: %d), reading through the file descriptor",
+              GetName(), gSystem->GetErrno());
+      return;
+   }
+   fMMapBuffer = (char *)addr;
+   fMMapSize   = size;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the memory mapping of the file (if any).
+
+void TFile::UnmapFile()
+{
+#ifndef WIN32
+   if (fMMapBuffer)
+      ::munmap(fMMapBuffer, (size_t)fMMapSize);
+#endif
+   fMMapBuffer = 0;
+   fMMapSize   = 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read the FREE linked list.
 ///
@@ -2113,6 +2323,13 @@ Int_t TFile::ReOpen(Option_t *mode)
    } else {
       // switch to UPDATE mode
 
+      // The baskets and keys read so far may point into the mapping, which
+      // would go stale once the file is modified.
+      if (IsMapped()) {
+         Error("ReOpen", "memory-mapped file %s cannot be reopened in update mode", GetName());
+         return 1;
+      }
+
       // close readonly file
       if (IsOpen()) {
          SysClose(fD);
@@ -4470,6 +4687,26 @@ Int_t TFile::GetReadaheadSize()
 //______________________________________________________________________________
 void TFile::SetReadaheadSize(Int_t bytes) { fgReadaheadSize = bytes; }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of threads reading the blocks requested by
+/// TFile::ReadBuffers (e.g. by TTreeCache) concurrently for local files.
+/// 0 (the default, unless set via TFile.ParallelReadThreads in the rootrc)
+/// means the blocks are read sequentially.
+
+Int_t TFile::GetParallelReadThreads()
+{
+   if (fgParallelReadThreads < 0)
+      fgParallelReadThreads = gEnv ? gEnv->GetValue("TFile.ParallelReadThreads", 0) : 0;
+   return fgParallelReadThreads;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of threads reading the blocks requested by TFile::ReadBuffers
+/// concurrently for local files. See ROOT::Internal::RReadEngine. This is
+/// mostly useful on high-latency (e.g. parallel) file systems.
+
+void TFile::SetParallelReadThreads(Int_t nthreads) { fgParallelReadThreads = nthreads < 0 ? 0 : nthreads; }
+
 //______________________________________________________________________________
 void TFile::SetFileBytesRead(Long64_t bytes) { fgBytesRead = bytes; }
 
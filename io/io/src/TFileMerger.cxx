@@ -39,6 +39,8 @@ to be merged, like the standalone hadd program.
 #include "TROOT.h"
 #include "TMemFile.h"
 #include "TVirtualMutex.h"
+#include "TError.h"
+#include "ROOT/TTaskGroup.hxx"
 
 #ifdef WIN32
 // For _getmaxstdio
@@ -50,6 +52,10 @@ to be merged, like the standalone hadd program.
 #endif
 
 #include <cstring>
+#include <deque>
+#include <future>
+#include <memory>
+#include <vector>
 
 ClassImp(TFileMerger);
 
@@ -58,6 +64,175 @@ TClassRef R__TTree_Class("TTree");
 
 static const Int_t kCpProgress = BIT(14);
 static const Int_t kCintFileNumber = 100;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the merged object obj of class cl in target under the given name and
+/// delete it. Objects that could not be merged do not overwrite existing keys.
+
+static Bool_t R__WriteMergedObject(TDirectory *target, TObject *obj, TClass *cl, const char *name, Bool_t canBeMerged)
+{
+   Bool_t status = kTRUE;
+   target->cd();
+   if (cl->InheritsFrom( TCollection::Class() )) {
+      // Don't overwrite, if the object were not merged.
+      if ( obj->Write( name, canBeMerged ? TObject::kSingleKey | TObject::kOverwrite : TObject::kSingleKey) <= 0 ) {
+         status = kFALSE;
+      }
+      ((TCollection*)obj)->SetOwner();
+      delete obj;
+   } else {
+      // Don't overwrite, if the object were not merged.
+      // NOTE: this is probably wrong for emulated objects.
+      if (cl->IsTObject()) {
+         if ( obj->Write( name, canBeMerged ? TObject::kOverwrite : 0) <= 0) {
+            status = kFALSE;
+         }
+      } else {
+         if ( target->WriteObjectAny( (void*)obj, cl, name, canBeMerged ? "OverWrite" : "" ) <= 0) {
+            status = kFALSE;
+         }
+      }
+      cl->Destructor(obj); // just in case the class is not loaded.
+   }
+   return status;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove an object read from a source file from the directory it was
+/// attached to, so that it can be merged and deleted by another thread.
+
+static void R__DetachFromDirectory(TObject *obj)
+{
+   if (ROOT::DirAutoAdd_t func = obj->IsA()->GetDirectoryAutoAdd())
+      func(obj, nullptr);
+}
+
+namespace ROOT {
+namespace Internal {
+
+/// Merges of independent objects running concurrently, in the tasks of the
+/// ROOT thread pool, with the rest of TFileMerger::MergeRecursive (in
+/// particular with the merging of the trees). The inputs are read by the
+/// merging thread, since the source files cannot be read concurrently; the
+/// merged objects are written by the merging thread as well, in the order in
+/// which their merges were queued. The number of merges and the size of the
+/// inputs in flight are bounded.
+class RMergeQueue {
+private:
+   struct RMerge {
+      TDirectory *fTarget;          ///< Directory receiving the merged object
+      TString fName;                ///< Name of the key of the merged object
+      TObject *fObject;             ///< The object all inputs are merged into
+      TClass *fClass;               ///< Class of fObject
+      Long64_t fBytes;              ///< Size of the inputs, as reserved by Reserve()
+      std::future<Bool_t> fResult;  ///< Result of the merge
+   };
+
+   ROOT::Experimental::TTaskGroup fTasks; ///< Tasks running the merges
+   std::deque<RMerge> fMerges; ///< Merges in flight, in the order in which they must be written
+   UInt_t fMaxMerges;          ///< Maximum number of merges in flight
+   Long64_t fMaxBytes;         ///< Maximum size of the inputs of the merges in flight
+   Long64_t fBytes = 0;        ///< Size of the inputs of the merges in flight
+   Long64_t fReserved = 0;     ///< Size reserved for the inputs of the next merge
+
+   Bool_t WriteOldest()
+   {
+      RMerge &merge = fMerges.front();
+      Bool_t canBeMerged = merge.fResult.get();
+      Bool_t status = R__WriteMergedObject(merge.fTarget, merge.fObject, merge.fClass, merge.fName, canBeMerged);
+      fBytes -= merge.fBytes;
+      fMerges.pop_front();
+      return status;
+   }
+
+public:
+   RMergeQueue(UInt_t maxMerges, Long64_t maxBytes) : fMaxMerges(maxMerges > 0 ? maxMerges : 1), fMaxBytes(maxBytes) {}
+
+   ~RMergeQueue()
+   {
+      // Only reached with merges in flight if the merge is aborted: drop the results.
+      fTasks.Wait();
+      for (auto &merge : fMerges)
+         merge.fClass->Destructor(merge.fObject);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Make room for a merge whose inputs take bytes in memory, writing the
+   /// results of the oldest merges if needed. Return kFALSE if the inputs are
+   /// too large to be held in memory at once: the object must then be merged
+   /// by reading one input at a time. Set status to kFALSE if writing one of
+   /// the previous results failed.
+
+   Bool_t Reserve(Long64_t bytes, Bool_t &status)
+   {
+      if (bytes > fMaxBytes)
+         return kFALSE;
+      while (!fMerges.empty() && (fMerges.size() >= fMaxMerges || fBytes + bytes > fMaxBytes))
+         status &= WriteOldest();
+      fReserved = bytes;
+      return kTRUE;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Merge inputs into obj (of class cl, which has a merge function) in the
+   /// background; the result is written in target under the given name.
+   /// Reserve() must have been called for the inputs.
+
+   void Push(TDirectory *target, const char *name, TObject *obj, TClass *cl, TList *inputs,
+             std::vector<TString> &&sources, Bool_t oneGo, const TFileMergeInfo &info)
+   {
+      TString options = info.fOptions;
+      ROOT::TIOFeatures *features = info.fIOFeatures;
+      auto merge = [=, sources = std::move(sources)]() {
+         std::unique_ptr<TList> owner(inputs);
+         // Objects cloned while merging must not end up in any directory.
+         TDirectory::TContext ctxt(nullptr);
+         TFileMergeInfo mergeInfo(target);
+         mergeInfo.fOptions = options;
+         mergeInfo.fIOFeatures = features;
+         ROOT::MergeFunc_t func = cl->GetMerge();
+         if (oneGo || inputs->IsEmpty()) {
+            func(obj, inputs, &mergeInfo);
+         } else {
+            // Same sequence of calls as the sequential merge.
+            TList single;
+            Int_t i = 0;
+            TIter next(inputs);
+            while (TObject *input = next()) {
+               single.Add(input);
+               if (func(obj, &single, &mergeInfo) < 0) {
+                  ::Error("TFileMerger::MergeRecursive", "calling Merge() on '%s' with the corresponding object in '%s'",
+                          obj->GetName(), sources[i].Data());
+               }
+               mergeInfo.fIsFirst = kFALSE;
+               single.Clear();
+               ++i;
+            }
+         }
+         inputs->Delete();
+         return kTRUE;
+      };
+      auto task = std::make_shared<std::packaged_task<Bool_t()>>(std::move(merge));
+      fMerges.push_back({target, name, obj, cl, fReserved, task->get_future()});
+      fBytes += fReserved;
+      fReserved = 0;
+      fTasks.Run([task]() { (*task)(); });
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Wait for all the merges in flight and write their results.
+
+   Bool_t Drain()
+   {
+      Bool_t status = kTRUE;
+      while (!fMerges.empty())
+         status &= WriteOldest();
+      return status;
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the maximum number of allowed opened files minus some wiggle room
 /// for CINT or at least of the standard library (stdio).
@@ -549,6 +724,55 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                TList inputs;
                Bool_t oneGo = fHistoOneGo && cl->InheritsFrom(R__TH1_Class);
 
+               Bool_t queued = fMergeQueue && !(type & kIncremental) && !cl->GetResetAfterMerge() &&
+                               !cl->InheritsFrom(R__TTree_Class);
+               std::vector<std::pair<TDirectory*, TKey*>> inputKeys;
+               if (queued) {
+                  // Find the inputs, to know how much memory they take once read.
+                  Long64_t inputBytes = 0;
+                  TFile *nextsource = (TFile*)sourcelist->After( current_file );
+                  for (; nextsource; nextsource = (TFile*)sourcelist->After( nextsource )) {
+                     TDirectory *ndir = nextsource->GetDirectory(path);
+                     if (!ndir) continue;
+                     TKey *key2 = (TKey*)ndir->GetListOfKeys()->FindObject(key->GetName());
+                     if (!key2) continue;
+                     inputKeys.emplace_back(ndir, key2);
+                     inputBytes += key2->GetObjlen();
+                  }
+                  // Too large inputs are merged below, reading one at a time.
+                  queued = fMergeQueue->Reserve(inputBytes, status);
+               }
+               if (queued) {
+                  // Read all the inputs now and merge them concurrently with the
+                  // next keys; the result is written by fMergeQueue.
+                  TList *allinputs = new TList;
+                  std::vector<TString> sources;
+                  R__DetachFromDirectory(obj);
+                  for (auto &input : inputKeys) {
+                     input.first->cd();
+                     TKey *key2 = input.second;
+                     TFile *nextsource = input.first->GetFile();
+                     TObject *hobj = key2->ReadObj();
+                     if (!hobj) {
+                        Info("MergeRecursive", "could not read object for key {%s, %s}; skipping file %s",
+                             key->GetName(), key->GetTitle(), nextsource->GetName());
+                        continue;
+                     }
+                     // Set ownership for collections
+                     if (hobj->InheritsFrom(TCollection::Class())) {
+                        ((TCollection*)hobj)->SetOwner();
+                     }
+                     hobj->ResetBit(kMustCleanup);
+                     R__DetachFromDirectory(hobj);
+                     allinputs->Add(hobj);
+                     sources.emplace_back(nextsource->GetName());
+                  }
+                  oldkeyname = key->GetName();
+                  fMergeQueue->Push(target, oldkeyname, obj, cl, allinputs, std::move(sources), oneGo, info);
+                  info.Reset();
+                  continue;
+               }
+
                // Loop over all source files and merge same-name object
                TFile *nextsource = current_file ? (TFile*)sourcelist->After( current_file ) : (TFile*)sourcelist->First();
                if (nextsource == 0) {
@@ -746,26 +970,8 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                if (!(type&kIncremental) || dynamic_cast<TDirectory*>(obj)->GetFile() != target) {
                   delete obj;
                }
-            } else if (cl->InheritsFrom( TCollection::Class() )) {
-               // Don't overwrite, if the object were not merged.
-               if ( obj->Write( oldkeyname, canBeMerged ? TObject::kSingleKey | TObject::kOverwrite : TObject::kSingleKey) <= 0 ) {
-                  status = kFALSE;
-               }
-               ((TCollection*)obj)->SetOwner();
-               delete obj;
-            } else {
-               // Don't overwrite, if the object were not merged.
-               // NOTE: this is probably wrong for emulated objects.
-               if (cl->IsTObject()) {
-                  if ( obj->Write( oldkeyname, canBeMerged ? TObject::kOverwrite : 0) <= 0) {
-                     status = kFALSE;
-                  }
-               } else {
-                  if ( target->WriteObjectAny( (void*)obj, cl, oldkeyname, canBeMerged ? "OverWrite" : "" ) <= 0) {
-                     status = kFALSE;
-                  }
-               }
-               cl->Destructor(obj); // just in case the class is not loaded.
+            } else if (!R__WriteMergedObject(target, obj, cl, oldkeyname, canBeMerged)) {
+               status = kFALSE;
             }
             info.Reset();
          } // while ( ( TKey *key = (TKey*)nextkey() ) )
@@ -777,6 +983,10 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
          current_sourcedir = 0;
       }
    }
+   // write the objects still being merged before saving the directory.
+   if (fMergeQueue && !fMergeQueue->Drain()) {
+      status = kFALSE;
+   }
    // save modifications to the target directory.
    if (!(type&kIncremental)) {
       // In case of incremental build, we will call Write on the top directory/file, so we do not need
@@ -848,6 +1058,13 @@ Bool_t TFileMerger::PartialMerge(Int_t in_type)
 
    TDirectory::TContext ctxt;
 
+   std::unique_ptr<ROOT::Internal::RMergeQueue> mergeQueue;
+   // A single thread could not run the merges while the merging thread waits for them.
+   if (fNThreads > 0 && ROOT::IsImplicitMTEnabled() && ROOT::GetImplicitMTPoolSize() > 1) {
+      mergeQueue.reset(new ROOT::Internal::RMergeQueue(fNThreads, fMaxMergeBytes));
+      fMergeQueue = mergeQueue.get();
+   }
+
    Bool_t result = kTRUE;
    Int_t type = in_type;
    while (result && fFileList.GetEntries()>0) {
@@ -877,6 +1094,8 @@ Bool_t TFileMerger::PartialMerge(Int_t in_type)
          result = OpenExcessFiles();
       }
    }
+   fMergeQueue = nullptr;
+   mergeQueue.reset();
    if (!result) {
       Error("Merge", "error during merge of your ROOT files");
    } else {
@@ -975,6 +1194,29 @@ void TFileMerger::SetMaxOpenedFiles(Int_t newmax)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of objects merged concurrently.
+///
+/// With nthreads > 0, the objects of each directory that are merged in memory
+/// (e.g. histograms) are merged, up to nthreads at a time, by the tasks of the
+/// ROOT thread pool while the merging thread goes on reading the next objects
+/// and merging (e.g. fast cloning) the trees. The source files are read, and
+/// the output file is written, by the merging thread only; the merged objects
+/// are written in a fixed order, so the output does not depend on the
+/// scheduling. The inputs of the objects being merged take at most
+/// GetMaxMergeBytes() bytes of memory; objects with larger inputs are merged
+/// by the merging thread, reading one input at a time.
+/// This enables the implicit multi-threading with nthreads threads, if it is
+/// not enabled yet (see ROOT::EnableImplicitMT); without it, or if ROOT was
+/// built without it, the objects are merged sequentially.
+
+void TFileMerger::SetNThreads(Int_t nthreads)
+{
+   fNThreads = nthreads > 0 ? nthreads : 0;
+   if (fNThreads > 0 && !ROOT::IsImplicitMTEnabled())
+      ROOT::EnableImplicitMT(fNThreads);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the prefix to be used when printing informational message.
 
@@ -731,7 +731,13 @@ TObject *TKey::ReadObj()
       return (TObject*)ReadObjectAny(0);
    }
 
-   fBufferRef = new TBufferFile(TBuffer::kRead, fObjlen+fKeylen);
+   // With a memory-mapped file, uncompressed records are streamed in place and
+   // compressed ones are inflated straight from the mapped pages.
+   char *mapped = GetMappedRecord();
+   if (mapped && fObjlen <= fNbytes-fKeylen)
+      fBufferRef = new TBufferFile(TBuffer::kRead, fNbytes, mapped, kFALSE);
+   else
+      fBufferRef = new TBufferFile(TBuffer::kRead, fObjlen+fKeylen);
    if (!fBufferRef) {
       Error("ReadObj", "Cannot allocate buffer: fObjlen = %d", fObjlen);
       return 0;
@@ -741,16 +747,22 @@ TObject *TKey::ReadObj()
    fBufferRef->SetPidOffset(fPidOffset);
 
    if (fObjlen > fNbytes-fKeylen) {
-      fBuffer = new char[fNbytes];
-      if( !ReadFile() )                    //Read object structure from file
-      {
-        delete fBufferRef;
-        delete [] fBuffer;
-        fBufferRef = 0;
-        fBuffer = 0;
-        return 0;
+      if (mapped) {
+         fBuffer = mapped;
+      } else {
+         fBuffer = new char[fNbytes];
+         if( !ReadFile() )                    //Read object structure from file
+         {
+           delete fBufferRef;
+           delete [] fBuffer;
+           fBufferRef = 0;
+           fBuffer = 0;
+           return 0;
+         }
       }
       memcpy(fBufferRef->Buffer(),fBuffer,fKeylen);
+   } else if (mapped) {
+      fBuffer = mapped;
    } else {
       fBuffer = fBufferRef->Buffer();
       if( !ReadFile() ) {                   //Read object structure from file
@@ -803,9 +815,9 @@ TObject *TKey::ReadObj()
       }
       if (nout) {
          tobj->Streamer(*fBufferRef); //does not work with example 2 above
-         delete [] fBuffer;
+         if (!mapped) delete [] fBuffer;
       } else {
-         delete [] fBuffer;
+         if (!mapped) delete [] fBuffer;
          // Even-though we have a TObject, if the class is emulated the virtual
          // table may not be 'right', so let's go via the TClass.
          cl->Destructor(pobj);
@@ -999,7 +1011,12 @@ CLEAR:
 
 void *TKey::ReadObjectAny(const TClass* expectedClass)
 {
-   fBufferRef = new TBufferFile(TBuffer::kRead, fObjlen+fKeylen);
+   // See ReadObj for the handling of memory-mapped files.
+   char *mapped = GetMappedRecord();
+   if (mapped && fObjlen <= fNbytes-fKeylen)
+      fBufferRef = new TBufferFile(TBuffer::kRead, fNbytes, mapped, kFALSE);
+   else
+      fBufferRef = new TBufferFile(TBuffer::kRead, fObjlen+fKeylen);
    if (!fBufferRef) {
       Error("ReadObj", "Cannot allocate buffer: fObjlen = %d", fObjlen);
       return 0;
@@ -1009,9 +1026,15 @@ void *TKey::ReadObjectAny(const TClass* expectedClass)
    fBufferRef->SetPidOffset(fPidOffset);
 
    if (fObjlen > fNbytes-fKeylen) {
-      fBuffer = new char[fNbytes];
-      ReadFile();                    //Read object structure from file
+      if (mapped) {
+         fBuffer = mapped;
+      } else {
+         fBuffer = new char[fNbytes];
+         ReadFile();                    //Read object structure from file
+      }
       memcpy(fBufferRef->Buffer(),fBuffer,fKeylen);
+   } else if (mapped) {
+      fBuffer = mapped;
    } else {
       fBuffer = fBufferRef->Buffer();
       ReadFile();                    //Read object structure from file
@@ -1081,9 +1104,9 @@ void *TKey::ReadObjectAny(const TClass* expectedClass)
       }
       if (nout) {
          cl->Streamer((void*)pobj, *fBufferRef, clOnfile);    //read object
-         delete [] fBuffer;
+         if (!mapped) delete [] fBuffer;
       } else {
-         delete [] fBuffer;
+         if (!mapped) delete [] fBuffer;
          cl->Destructor(pobj);
          pobj = 0;
          goto CLEAR;
@@ -1247,6 +1270,18 @@ void TKey::ReadKeyBuffer(char *&buffer)
    fTitle.ReadBuffer(buffer);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the start of this key's record in the memory mapping of its file,
+/// or 0 if the file is not memory-mapped (see TFile::GetMappedBuffer).
+/// The record is accounted as read from the file. The returned memory is
+/// read-only: it is only used as the source of the streaming.
+
+char *TKey::GetMappedRecord()
+{
+   TFile *f = GetFile();
+   return f ? const_cast<char *>(f->GetMappedBuffer(fSeekKey, fNbytes)) : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read the key structure from the file
 
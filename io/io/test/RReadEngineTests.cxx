@@ -0,0 +1,109 @@
+#include "ROOT/RReadEngine.hxx"
+#include "TFile.h"
+#include "TNamed.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstdio>
+#include <fcntl.h>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+
+namespace {
+std::string MakeTestFile(const char *name, Int_t size)
+{
+   FILE *fp = fopen(name, "wb");
+   for (Int_t i = 0; i < size; ++i)
+      fputc(i % 251, fp);
+   fclose(fp);
+   return name;
+}
+} // anonymous namespace
+
+TEST(RReadEngine, ScatteredRequests)
+{
+   const Int_t size = 1 << 20;
+   auto filename = MakeTestFile("RReadEngineScattered.bin", size);
+   int fd = open(filename.c_str(), O_RDONLY);
+   ASSERT_GE(fd, 0);
+
+   // Adjacent, close, far apart and out of order requests.
+   std::vector<Long64_t> offsets{0, 100, 150, 5000, 700000, 10, 999000};
+   std::vector<Int_t> lens{100, 50, 1000, 20, 4096, 5, 1000};
+   std::vector<std::vector<char>> buffers;
+   std::vector<ROOT::Internal::RReadRequest> requests(offsets.size());
+   for (std::size_t i = 0; i < offsets.size(); ++i) {
+      buffers.emplace_back(lens[i]);
+      requests[i].fOffset = offsets[i];
+      requests[i].fLen = lens[i];
+      requests[i].fBuffer = buffers[i].data();
+   }
+
+   for (UInt_t nThreads : {0u, 1u, 4u}) {
+      ROOT::Internal::RReadEngine engine(nThreads, 64);
+      std::atomic<int> ncompleted{0};
+      Int_t ncalls = engine.ReadV(fd, requests.data(), requests.size(),
+                                  [&ncompleted](const ROOT::Internal::RReadRequest &, bool ok) {
+                                     if (ok)
+                                        ++ncompleted;
+                                  });
+      // [10,15) overlaps [0,100) and needs its own call, after which [100,150) and
+      // [150,1150) are merged; the other requests are too far apart.
+      EXPECT_EQ(ncalls, 6);
+      EXPECT_EQ(ncompleted, (int)requests.size());
+      for (std::size_t i = 0; i < offsets.size(); ++i) {
+         for (Int_t j = 0; j < lens[i]; ++j)
+            ASSERT_EQ((unsigned char)buffers[i][j], (offsets[i] + j) % 251);
+      }
+   }
+
+   // Reading past the end of the file fails.
+   ROOT::Internal::RReadRequest past;
+   std::vector<char> pastBuffer(10);
+   past.fOffset = size - 5;
+   past.fLen = 10;
+   past.fBuffer = pastBuffer.data();
+   ROOT::Internal::RReadEngine engine(2);
+   EXPECT_EQ(engine.ReadV(fd, &past, 1), -1);
+
+   close(fd);
+   gSystem->Unlink(filename.c_str());
+}
+
+TEST(RReadEngine, TFileReadBuffers)
+{
+   const auto filename = "RReadEngineTFile.root";
+   {
+      TFile f(filename, "RECREATE");
+      for (int i = 0; i < 100; ++i) {
+         TNamed named(TString::Format("n%d", i), TString::Format("title %d", i));
+         named.Write();
+      }
+   }
+
+   TFile f(filename);
+   ASSERT_FALSE(f.IsZombie());
+   const Long64_t fileSize = f.GetSize();
+   std::vector<Long64_t> pos{0, 64, 128, 1000, fileSize - 100};
+   std::vector<Int_t> len{64, 64, 200, 300, 100};
+   std::vector<char> sequential(728), parallel(728);
+
+   TFile::SetParallelReadThreads(0);
+   ASSERT_FALSE(f.ReadBuffers(sequential.data(), pos.data(), len.data(), pos.size()));
+   TFile::SetParallelReadThreads(3);
+   EXPECT_EQ(TFile::GetParallelReadThreads(), 3);
+   ASSERT_FALSE(f.ReadBuffers(parallel.data(), pos.data(), len.data(), pos.size()));
+   TFile::SetParallelReadThreads(0);
+   EXPECT_EQ(sequential, parallel);
+
+   gSystem->Unlink(filename);
+}
+
+#endif
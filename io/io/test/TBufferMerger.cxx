@@ -176,6 +176,107 @@ TEST(TBufferMerger, AutoSave)
    RemoveFile("tbuffermerger_autosave.root");
 }
 
+TEST(TBufferMerger, BackPressure)
+{
+   int nthreads = 8;
+   int nwrites = 4;
+   int events_per_write = 512;
+
+   ROOT::EnableThreadSafety();
+
+   {
+      TBufferMerger merger("tbuffermerger_backpressure.root");
+
+      // Any buffer pushed while another one is waiting makes the writer merge the queue.
+      merger.SetMaxBuffered(1);
+      EXPECT_EQ(1u, merger.GetMaxBuffered());
+
+      std::vector<std::thread> threads;
+      for (int i = 0; i < nthreads; ++i) {
+         threads.emplace_back([=, &merger]() {
+            auto myfile = merger.GetFile();
+            auto mytree = new TTree("mytree", "mytree");
+            mytree->ResetBit(kMustCleanup);
+
+            int n = 0;
+            mytree->Branch("n", &n, "n/I");
+            for (int w = 0; w < nwrites; ++w) {
+               for (int e = 0; e < events_per_write; ++e) {
+                  n = (i * nwrites + w) * events_per_write + e;
+                  mytree->Fill();
+               }
+               myfile->Write();
+            }
+            mytree->ResetBranchAddresses();
+         });
+      }
+
+      for (auto &&t : threads)
+         t.join();
+   }
+
+   {
+      TFile f("tbuffermerger_backpressure.root");
+      auto t = (TTree *)f.Get("mytree");
+      ASSERT_TRUE(t != nullptr);
+
+      int n;
+      long long sum = 0;
+      int nentries = (int)t->GetEntries();
+      t->SetBranchAddress("n", &n);
+      for (int i = 0; i < nentries; ++i) {
+         t->GetEntry(i);
+         sum += n;
+      }
+      t->ResetBranchAddresses();
+
+      long long nevents = nthreads * nwrites * events_per_write;
+      EXPECT_EQ(nevents, nentries);
+      EXPECT_EQ(nevents * (nevents - 1) / 2, sum);
+   }
+
+   RemoveFile("tbuffermerger_backpressure.root");
+}
+
+TEST(TBufferMerger, BackPressureAboveAutoSave)
+{
+   int nwrites = 4;
+   int events_per_write = 512;
+
+   {
+      TBufferMerger merger("tbuffermerger_backpressure_autosave.root");
+
+      // The writers block on fMaxBuffered even if the autosave is never reached.
+      merger.SetAutoSave(1 << 30);
+      merger.SetMaxBuffered(1);
+
+      auto myfile = merger.GetFile();
+      auto mytree = new TTree("mytree", "mytree");
+      mytree->ResetBit(kMustCleanup);
+
+      int n = 0;
+      mytree->Branch("n", &n, "n/I");
+      for (int w = 0; w < nwrites; ++w) {
+         for (int e = 0; e < events_per_write; ++e) {
+            n = w * events_per_write + e;
+            mytree->Fill();
+         }
+         myfile->Write();
+         EXPECT_EQ(0u, merger.GetQueueSize());
+      }
+      mytree->ResetBranchAddresses();
+   }
+
+   {
+      TFile f("tbuffermerger_backpressure_autosave.root");
+      auto t = (TTree *)f.Get("mytree");
+      ASSERT_TRUE(t != nullptr);
+      EXPECT_EQ(nwrites * events_per_write, t->GetEntries());
+   }
+
+   RemoveFile("tbuffermerger_backpressure_autosave.root");
+}
+
 TEST(TBufferMerger, CheckTreeFillResults)
 {
    int sum_s, sum_p;
@@ -1,8 +1,15 @@
 #include "TFileMerger.h"
 
+#include "TFile.h"
+#include "TH1F.h"
+#include "TKey.h"
 #include "TMemFile.h"
+#include "TSystem.h"
 #include "TTree.h"
 
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 namespace {
@@ -96,3 +103,62 @@ TEST(TFileMerger, CreateWithUnwritableTFilePointer)
    output->SetWritable(false);
    EXPECT_ROOT_ERROR(merger.OutputFile(std::move(output)), "Error in .* output file output.root is not writable\n");
 }
+
+TEST(TFileMerger, MergeInThreads)
+{
+   const int nfiles = 4;
+   const int nhistos = 20;
+   std::vector<std::string> inputs;
+   for (int i = 0; i < nfiles; ++i) {
+      inputs.emplace_back("MergeInThreads_" + std::to_string(i) + ".root");
+      TFile f(inputs.back().c_str(), "RECREATE");
+      for (int h = 0; h < nhistos; ++h) {
+         TH1F histo(("h" + std::to_string(h)).c_str(), "histo", 10, 0, 10);
+         histo.Fill(h % 10, i + 1);
+         histo.Write();
+      }
+      double value = i;
+      TTree tree("tree", "A tree");
+      tree.Branch("value", &value);
+      tree.Fill();
+      tree.Write();
+   }
+
+   auto merge = [&](const char *output, int nthreads, Long64_t maxMergeBytes = 256 * 1024 * 1024) {
+      TFileMerger merger(kFALSE, kFALSE);
+      merger.SetNThreads(nthreads);
+      merger.SetMaxMergeBytes(maxMergeBytes);
+      merger.OutputFile(output, "RECREATE");
+      for (auto &input : inputs)
+         merger.AddFile(input.c_str(), kFALSE);
+      return merger.Merge();
+   };
+   ASSERT_TRUE(merge("MergeInThreads_seq.root", 0));
+   ASSERT_TRUE(merge("MergeInThreads_mt.root", 3));
+   // Inputs too large to be held in memory at once are merged one at a time.
+   ASSERT_TRUE(merge("MergeInThreads_capped.root", 3, 1000));
+
+   TFile seq("MergeInThreads_seq.root");
+   for (auto output : {"MergeInThreads_mt.root", "MergeInThreads_capped.root"}) {
+      TFile mt(output);
+      ASSERT_EQ(seq.GetNkeys(), mt.GetNkeys());
+      for (int h = 0; h < nhistos; ++h) {
+         auto name = "h" + std::to_string(h);
+         auto hseq = seq.Get<TH1F>(name.c_str());
+         auto hmt = mt.Get<TH1F>(name.c_str());
+         ASSERT_NE(hmt, nullptr);
+         EXPECT_EQ(hmt->GetEntries(), hseq->GetEntries());
+         EXPECT_EQ(hmt->GetBinContent(h % 10 + 1), nfiles * (nfiles + 1) / 2);
+         EXPECT_EQ(hmt->GetBinContent(h % 10 + 1), hseq->GetBinContent(h % 10 + 1));
+      }
+      auto tree = mt.Get<TTree>("tree");
+      ASSERT_NE(tree, nullptr);
+      EXPECT_EQ(tree->GetEntries(), nfiles);
+   }
+
+   for (auto &input : inputs)
+      gSystem->Unlink(input.c_str());
+   gSystem->Unlink("MergeInThreads_seq.root");
+   gSystem->Unlink("MergeInThreads_mt.root");
+   gSystem->Unlink("MergeInThreads_capped.root");
+}
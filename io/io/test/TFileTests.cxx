@@ -1,8 +1,13 @@
+#include "TDirectoryFile.h"
 #include "TFile.h"
+#include "TKey.h"
+#include "TNamed.h"
 #include "TSystem.h"
 
 #include "gtest/gtest.h"
 
+#include <string>
+
 // Tests ROOT-9857
 TEST(TFile, ReadFromSameFile)
 {
@@ -22,4 +27,61 @@ TEST(TFile, ReadFromSameFile)
    auto o2 = f2.Get(objpath);
 
    EXPECT_TRUE(o1 != o2) << "Same objects read from two different files have the same pointer!";
-}
\ No newline at end of file
+}
+
+TEST(TFile, LazyKeys)
+{
+   const auto filename = "LazyKeys.root";
+   {
+      TFile f(filename, "RECREATE");
+      TNamed first("first", "cycle 1");
+      first.Write();
+      first.SetTitle("cycle 2");
+      first.Write();
+      TNamed second("second", "only cycle");
+      second.Write();
+      auto dir = f.mkdir("dir");
+      TNamed third("third", "in subdirectory");
+      dir->WriteTObject(&third);
+   }
+
+   TFile eager(filename);
+   TFile lazy((std::string(filename) + "?lazykeys=yes").c_str());
+   ASSERT_FALSE(eager.IsLazyKeys());
+   ASSERT_TRUE(lazy.IsLazyKeys());
+   EXPECT_EQ(eager.GetNkeys(), lazy.GetNkeys());
+
+   auto obj = lazy.Get<TNamed>("first");
+   ASSERT_NE(obj, nullptr);
+   EXPECT_STREQ(obj->GetTitle(), "cycle 2");
+   obj = lazy.Get<TNamed>("first;1");
+   ASSERT_NE(obj, nullptr);
+   EXPECT_STREQ(obj->GetTitle(), "cycle 1");
+   EXPECT_EQ(lazy.Get("first;3"), nullptr);
+   EXPECT_EQ(lazy.Get("missing"), nullptr);
+   obj = lazy.Get<TNamed>("dir/third");
+   ASSERT_NE(obj, nullptr);
+   EXPECT_STREQ(obj->GetTitle(), "in subdirectory");
+
+   auto key = lazy.GetKey("first", 1);
+   ASSERT_NE(key, nullptr);
+   EXPECT_EQ(key->GetCycle(), 1);
+   EXPECT_EQ(lazy.GetKey("first", 5)->GetCycle(), 2);
+   EXPECT_EQ(lazy.GetKey("first"), lazy.GetKey("first", 2));
+
+   // The full list of keys has the same content and order as without lazy keys.
+   TList *lazyKeys = lazy.GetListOfKeys();
+   TList *eagerKeys = eager.GetListOfKeys();
+   ASSERT_EQ(lazyKeys->GetSize(), eagerKeys->GetSize());
+   for (Int_t i = 0; i < eagerKeys->GetSize(); ++i) {
+      auto lazyKey = static_cast<TKey *>(lazyKeys->At(i));
+      auto eagerKey = static_cast<TKey *>(eagerKeys->At(i));
+      EXPECT_STREQ(lazyKey->GetName(), eagerKey->GetName());
+      EXPECT_EQ(lazyKey->GetCycle(), eagerKey->GetCycle());
+      EXPECT_EQ(lazyKey->GetSeekKey(), eagerKey->GetSeekKey());
+   }
+   // Keys created before are reused.
+   EXPECT_NE(lazyKeys->IndexOf(key), -1);
+
+   gSystem->Unlink(filename);
+}
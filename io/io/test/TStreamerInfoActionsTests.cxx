@@ -0,0 +1,47 @@
+#include "TAttLine.h"
+#include "TAttMarker.h"
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TStreamerInfo.h"
+#include "TTimeStamp.h"
+
+#include "gtest/gtest.h"
+
+// The data members of these classes are regrouped by TStreamerInfo::Compile into
+// runs of the same basic type, which are streamed by the array actions.
+TEST(TStreamerInfoActions, RegroupedMembers)
+{
+   for (auto cl : {TAttLine::Class(), TAttMarker::Class(), TTimeStamp::Class()}) {
+      auto info = static_cast<TStreamerInfo *>(cl->GetStreamerInfo());
+      ASSERT_NE(nullptr, info);
+      if (TVirtualStreamerInfo::CanOptimize())
+         EXPECT_TRUE(info->IsOptimized()) << cl->GetName();
+   }
+
+   TAttLine line(3, 2, 5);
+   TAttMarker marker(4, 21, 1.5);
+   TTimeStamp stamp(1234567890, 987654321);
+
+   TBufferFile wbuf(TBuffer::kWrite);
+   wbuf.WriteClassBuffer(TAttLine::Class(), &line);
+   wbuf.WriteClassBuffer(TAttMarker::Class(), &marker);
+   wbuf.WriteClassBuffer(TTimeStamp::Class(), &stamp);
+
+   TBufferFile rbuf(TBuffer::kRead, wbuf.Length(), wbuf.Buffer(), kFALSE);
+   TAttLine line2;
+   TAttMarker marker2;
+   TTimeStamp stamp2(0, 0);
+   rbuf.ReadClassBuffer(TAttLine::Class(), &line2, nullptr);
+   rbuf.ReadClassBuffer(TAttMarker::Class(), &marker2, nullptr);
+   rbuf.ReadClassBuffer(TTimeStamp::Class(), &stamp2, nullptr);
+   EXPECT_EQ(wbuf.Length(), rbuf.Length());
+
+   EXPECT_EQ(line.GetLineColor(), line2.GetLineColor());
+   EXPECT_EQ(line.GetLineStyle(), line2.GetLineStyle());
+   EXPECT_EQ(line.GetLineWidth(), line2.GetLineWidth());
+   EXPECT_EQ(marker.GetMarkerColor(), marker2.GetMarkerColor());
+   EXPECT_EQ(marker.GetMarkerStyle(), marker2.GetMarkerStyle());
+   EXPECT_EQ(marker.GetMarkerSize(), marker2.GetMarkerSize());
+   EXPECT_EQ(stamp.GetSec(), stamp2.GetSec());
+   EXPECT_EQ(stamp.GetNanoSec(), stamp2.GetNanoSec());
+}
@@ -48,6 +48,11 @@
   (i.e. direct copy of the raw byte on disk). The "fast" mode is typically
   5 times faster than the mode unzipping and unstreaming the baskets.
 
+  With the option -t N, up to N histograms (and other objects merged in
+  memory) of each directory are merged at a time by the ROOT thread pool,
+  concurrently with the merging of the trees; the input files are still
+  read, and the target written, by a single thread.
+
   If the option -cachesize is used, hadd will resize (or disable if 0) the
   prefetching cache use to speed up I/O operations.
 
@@ -112,6 +117,7 @@ int main( int argc, char **argv )
    Bool_t multiproc = kFALSE;
    Bool_t debug = kFALSE;
    Int_t maxopenedfiles = 0;
+   Int_t nThreads = 0;
    Int_t verbosity = 99;
    TString cacheSize;
    SysInfo_t s;
@@ -258,6 +264,20 @@ int main( int argc, char **argv )
             }
          }
          ++ffirst;
+      } else if ( strcmp(argv[a],"-t") == 0 ) {
+         if (a+1 >= argc) {
+            std::cerr << "Error: no number of threads was provided after -t.\n";
+         } else {
+            Long_t request = strtol(argv[a+1], 0, 10);
+            if (request < kMaxLong && request >= 0) {
+               nThreads = (Int_t)request;
+               ++a;
+               ++ffirst;
+            } else {
+               std::cerr << "Error: could not parse the number of threads passed after -t: " << argv[a+1] << ". Objects will be merged sequentially.\n";
+            }
+         }
+         ++ffirst;
       } else if ( strcmp(argv[a],"-v") == 0 ) {
          if (a+1 == argc || argv[a+1][0] == '-') {
             // Verbosity level was not specified use the default:
@@ -427,6 +447,7 @@ int main( int argc, char **argv )
          }
       }
       merger.SetNotrees(noTrees);
+      merger.SetNThreads(nThreads);
       merger.SetMergeOptions(cacheSize);
       merger.SetIOFeatures(features);
       Bool_t status;
@@ -0,0 +1,98 @@
+#include "ROOT/RVec.hxx"
+
+#include "benchmark/benchmark.h"
+
+using ROOT::VecOps::RVec;
+
+namespace {
+
+/// range(0) values in [-1, 1).
+RVec<double> MakeVector(benchmark::State &state)
+{
+   RVec<double> v(state.range(0));
+   for (std::size_t i = 0; i < v.size(); ++i)
+      v[i] = (i % 200) * 0.01 - 1.;
+   return v;
+}
+
+} // anonymous namespace
+
+static void BM_RVec_Sum(benchmark::State &state)
+{
+   const auto v = MakeVector(state);
+   for (auto _ : state)
+      benchmark::DoNotOptimize(ROOT::VecOps::Sum(v));
+   state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_RVec_Sum)->Range(8, 8192);
+
+static void BM_RVec_Add(benchmark::State &state)
+{
+   const auto a = MakeVector(state);
+   const auto b = MakeVector(state);
+   for (auto _ : state)
+      benchmark::DoNotOptimize(a + b);
+   state.SetItemsProcessed(state.iterations() * a.size());
+}
+BENCHMARK(BM_RVec_Add)->Range(8, 8192);
+
+static void BM_RVec_AddInPlace(benchmark::State &state)
+{
+   auto a = MakeVector(state);
+   const auto b = MakeVector(state);
+   for (auto _ : state) {
+      a += b;
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed(state.iterations() * a.size());
+}
+BENCHMARK(BM_RVec_AddInPlace)->Range(8, 8192);
+
+static void BM_RVec_Sqrt(benchmark::State &state)
+{
+   const auto v = MakeVector(state);
+   for (auto _ : state)
+      benchmark::DoNotOptimize(ROOT::VecOps::sqrt(v * v));
+   state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_RVec_Sqrt)->Range(8, 8192);
+
+static void BM_RVec_Mask(benchmark::State &state)
+{
+   const auto v = MakeVector(state);
+   for (auto _ : state)
+      benchmark::DoNotOptimize(v[v > 0.]);
+   state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_RVec_Mask)->Range(8, 8192);
+
+static void BM_RVec_Map(benchmark::State &state)
+{
+   const auto v = MakeVector(state);
+   for (auto _ : state)
+      benchmark::DoNotOptimize(ROOT::VecOps::Map(v, [](double x) { return 2. * x + 1.; }));
+   state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_RVec_Map)->Range(8, 8192);
+
+static void BM_RVec_Filter(benchmark::State &state)
+{
+   const auto v = MakeVector(state);
+   for (auto _ : state)
+      benchmark::DoNotOptimize(ROOT::VecOps::Filter(v, [](double x) { return x > 0.; }));
+   state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_RVec_Filter)->Range(8, 8192);
+
+/// Wrap the memory of an existing buffer, as RDataFrame does when reading
+/// arrays from a TTree.
+static void BM_RVec_Adopt(benchmark::State &state)
+{
+   auto v = MakeVector(state);
+   for (auto _ : state) {
+      RVec<double> view(v.data(), v.size());
+      benchmark::DoNotOptimize(view.data());
+   }
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RVec_Adopt)->Range(8, 8192);
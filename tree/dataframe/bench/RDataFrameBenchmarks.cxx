@@ -0,0 +1,63 @@
+#include "ROOT/RDataFrame.hxx"
+
+#include "benchmark/benchmark.h"
+
+#include <string>
+#include <vector>
+
+// Every iteration runs an event loop over kNEntries entries of an empty data
+// source, so that what is measured is the cost of the nodes of the
+// computation graph, compared to the one of the loop without any node.
+
+namespace {
+
+constexpr ULong64_t kNEntries = 100000;
+
+} // anonymous namespace
+
+/// An event loop with range(0) filters chained.
+static void BM_RDataFrame_Filters(benchmark::State &state)
+{
+   for (auto _ : state) {
+      ROOT::RDataFrame df(kNEntries);
+      ROOT::RDF::RNode node = df;
+      for (Int_t i = 0; i < state.range(0); ++i)
+         node = node.Filter([](ULong64_t entry) { return entry != kNEntries; }, {"rdfentry_"});
+      auto count = node.Count();
+      benchmark::DoNotOptimize(*count);
+   }
+   state.SetItemsProcessed(state.iterations() * kNEntries);
+}
+BENCHMARK(BM_RDataFrame_Filters)->Arg(0)->Arg(1)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond);
+
+/// An event loop with a chain of range(0) defined columns, each computed from
+/// the previous one.
+static void BM_RDataFrame_Defines(benchmark::State &state)
+{
+   for (auto _ : state) {
+      ROOT::RDataFrame df(kNEntries);
+      ROOT::RDF::RNode node = df.Define("x0", [](ULong64_t entry) { return double(entry); }, {"rdfentry_"});
+      for (Int_t i = 1; i <= state.range(0); ++i)
+         node = node.Define("x" + std::to_string(i), [](double x) { return x + 1.; }, {"x" + std::to_string(i - 1)});
+      auto sum = node.Sum<double>("x" + std::to_string(state.range(0)));
+      benchmark::DoNotOptimize(*sum);
+   }
+   state.SetItemsProcessed(state.iterations() * kNEntries);
+}
+BENCHMARK(BM_RDataFrame_Defines)->Arg(0)->Arg(1)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond);
+
+/// An event loop with range(0) actions booked.
+static void BM_RDataFrame_Actions(benchmark::State &state)
+{
+   for (auto _ : state) {
+      ROOT::RDataFrame df(kNEntries);
+      std::vector<ROOT::RDF::RResultPtr<ULong64_t>> counts;
+      for (Int_t i = 0; i < state.range(0); ++i)
+         counts.emplace_back(df.Count());
+      df.Foreach([]() {});
+      for (auto &count : counts)
+         benchmark::DoNotOptimize(*count);
+   }
+   state.SetItemsProcessed(state.iterations() * kNEntries);
+}
+BENCHMARK(BM_RDataFrame_Actions)->Arg(0)->Arg(1)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond);
@@ -178,11 +178,12 @@ public:
          auto &readerArray = *fTreeReader;
          // We only use TTreeReaderArrays to read columns that users flagged as type `RVec`, so we need to check
          // that the branch stores the array as contiguous memory that we can actually wrap in an `RVec`.
-         // Currently we need the first entry to have been loaded to perform the check
-         // TODO Move check to `MakeProxy` once Axel implements this kind of check in TTreeReaderArray using
-         // TBranchProxy
+         // The reader knows for leaf arrays and vectors of non-pointers; otherwise we need the first entry to have
+         // been loaded to perform the check.
 
-         if (EStorageType::kUnknown == fStorageType && readerArray.GetSize() > 1) {
+         if (EStorageType::kUnknown == fStorageType && readerArray.IsContiguous()) {
+            fStorageType = EStorageType::kContiguous;
+         } else if (EStorageType::kUnknown == fStorageType && readerArray.GetSize() > 1) {
             // We can decide since the array is long enough
             fStorageType =
                (1 == (&readerArray[1] - &readerArray[0])) ? EStorageType::kContiguous : EStorageType::kSparse;
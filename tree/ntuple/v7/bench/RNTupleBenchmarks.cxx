@@ -0,0 +1,88 @@
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RPageStorageRoot.hxx>
+
+#include "benchmark/benchmark.h"
+
+#include <cstdio>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using RNTupleModel = ROOT::Experimental::RNTupleModel;
+using RNTupleReader = ROOT::Experimental::RNTupleReader;
+using RNTupleWriter = ROOT::Experimental::RNTupleWriter;
+using RPageSinkRoot = ROOT::Experimental::Detail::RPageSinkRoot;
+using RPageSourceRoot = ROOT::Experimental::Detail::RPageSourceRoot;
+
+namespace {
+
+const char *kFileName = "benchRNTuple.root";
+constexpr std::size_t kNEntries = 1000000;
+
+/// Write kNEntries entries with a float "pt" and a collection of floats "jets".
+void WriteNTuple()
+{
+   auto model = RNTupleModel::Create();
+   auto pt = model->MakeField<float>("pt", 42.f);
+   auto jets = model->MakeField<std::vector<float>>("jets");
+   RNTupleWriter ntuple(std::move(model), std::make_unique<RPageSinkRoot>("f", kFileName));
+   for (std::size_t i = 0; i < kNEntries; ++i) {
+      jets->assign(i % 8, 1.f);
+      ntuple.Fill();
+   }
+}
+
+} // anonymous namespace
+
+static void BM_RNTuple_Fill(benchmark::State &state)
+{
+   {
+      auto model = RNTupleModel::Create();
+      auto pt = model->MakeField<float>("pt", 42.f);
+      auto jets = model->MakeField<std::vector<float>>("jets");
+      jets->assign(4, 1.f);
+      RNTupleWriter ntuple(std::move(model), std::make_unique<RPageSinkRoot>("f", kFileName));
+      for (auto _ : state)
+         ntuple.Fill();
+      state.SetItemsProcessed(state.iterations());
+   }
+   std::remove(kFileName);
+}
+BENCHMARK(BM_RNTuple_Fill);
+
+static void BM_RNTuple_LoadEntry(benchmark::State &state)
+{
+   WriteNTuple();
+   {
+      RNTupleReader ntuple(std::make_unique<RPageSourceRoot>("f", kFileName));
+      std::size_t entry = 0;
+      for (auto _ : state) {
+         ntuple.LoadEntry(entry);
+         if (++entry == kNEntries)
+            entry = 0;
+      }
+      state.SetItemsProcessed(state.iterations());
+   }
+   std::remove(kFileName);
+}
+BENCHMARK(BM_RNTuple_LoadEntry);
+
+/// Read a single field through a view, without the rest of the entry.
+static void BM_RNTuple_View(benchmark::State &state)
+{
+   WriteNTuple();
+   {
+      RNTupleReader ntuple(std::make_unique<RPageSourceRoot>("f", kFileName));
+      auto viewPt = ntuple.GetView<float>("pt");
+      std::size_t entry = 0;
+      for (auto _ : state) {
+         benchmark::DoNotOptimize(viewPt(entry));
+         if (++entry == kNEntries)
+            entry = 0;
+      }
+      state.SetItemsProcessed(state.iterations());
+   }
+   std::remove(kFileName);
+}
+BENCHMARK(BM_RNTuple_View);
@@ -0,0 +1,51 @@
+#include "TFile.h"
+#include "TH1F.h"
+#include "TROOT.h"
+#include "TTree.h"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdio>
+#include <string>
+
+// Creation and destruction, from many threads at once, of the objects registered
+// for cleanup (files, trees and histograms), whose destructors go through
+// TROOT::RecursiveRemove and thus take the read lock of gCoreMutex.
+
+namespace {
+
+constexpr Int_t kNEntries = 100;
+
+/// Write a small tree and a histogram to fileName, then read the tree back.
+Long64_t WriteAndRead(const std::string &fileName)
+{
+   {
+      TFile f(fileName.c_str(), "RECREATE");
+      TTree t("t", "t");
+      TH1F h("h", "h", 10, 0, 10);
+      Int_t x = 0;
+      t.Branch("x", &x);
+      for (x = 0; x < kNEntries; ++x) {
+         t.Fill();
+         h.Fill(x % 10);
+      }
+      f.Write();
+   }
+   TFile f(fileName.c_str());
+   auto t = f.Get<TTree>("t");
+   return t ? t->GetEntries() : 0;
+}
+
+} // anonymous namespace
+
+static void BM_FileChurn(benchmark::State &state)
+{
+   if (state.thread_index == 0)
+      ROOT::EnableThreadSafety();
+   const std::string fileName = "benchFileChurn_" + std::to_string(state.thread_index) + ".root";
+   for (auto _ : state)
+      benchmark::DoNotOptimize(WriteAndRead(fileName));
+   state.SetItemsProcessed(state.iterations());
+   std::remove(fileName.c_str());
+}
+BENCHMARK(BM_FileChurn)->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
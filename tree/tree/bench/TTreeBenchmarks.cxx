@@ -0,0 +1,99 @@
+#include "TFile.h"
+#include "TTree.h"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdio>
+#include <type_traits>
+#include <vector>
+
+// The files are not compressed: the cost of the compression algorithms is
+// measured by benchCompression.
+
+namespace {
+
+const char *kFileName = "benchTTree.root";
+constexpr Long64_t kNEntries = 1000000;
+
+template <typename T>
+void InitValue(T &value)
+{
+   value = 42;
+}
+
+void InitValue(std::vector<float> &value)
+{
+   value.assign(8, 42.f);
+}
+
+/// Write a tree "t" with nEntries in its only branch "x", of type T.
+template <typename T>
+void WriteTree(Long64_t nEntries)
+{
+   TFile file(kFileName, "RECREATE", "", 0);
+   TTree tree("t", "t");
+   T value;
+   InitValue(value);
+   tree.Branch("x", &value);
+   for (Long64_t i = 0; i < nEntries; ++i)
+      tree.Fill();
+   tree.Write();
+}
+
+} // anonymous namespace
+
+template <typename T>
+static void BM_TTree_Fill(benchmark::State &state)
+{
+   {
+      TFile file(kFileName, "RECREATE", "", 0);
+      TTree tree("t", "t");
+      T value;
+      InitValue(value);
+      tree.Branch("x", &value);
+      for (auto _ : state)
+         tree.Fill();
+      state.SetItemsProcessed(state.iterations());
+      state.SetBytesProcessed(tree.GetTotBytes());
+   }
+   std::remove(kFileName);
+}
+BENCHMARK_TEMPLATE(BM_TTree_Fill, Int_t);
+BENCHMARK_TEMPLATE(BM_TTree_Fill, Long64_t);
+BENCHMARK_TEMPLATE(BM_TTree_Fill, Float_t);
+BENCHMARK_TEMPLATE(BM_TTree_Fill, Double_t);
+BENCHMARK_TEMPLATE(BM_TTree_Fill, std::vector<float>);
+
+template <typename T>
+static void BM_TTree_GetEntry(benchmark::State &state)
+{
+   WriteTree<T>(kNEntries);
+   {
+      TFile file(kFileName);
+      auto tree = file.Get<TTree>("t");
+      T value;
+      T *address = &value;
+      // The objects are read through a pointer to their address.
+      if (std::is_arithmetic<T>::value)
+         tree->SetBranchAddress("x", &value);
+      else
+         tree->SetBranchAddress("x", &address);
+
+      Long64_t entry = 0;
+      Long64_t bytes = 0;
+      for (auto _ : state) {
+         bytes += tree->GetEntry(entry);
+         if (++entry == kNEntries)
+            entry = 0;
+      }
+      state.SetItemsProcessed(state.iterations());
+      state.SetBytesProcessed(bytes);
+      tree->ResetBranchAddresses();
+   }
+   std::remove(kFileName);
+}
+BENCHMARK_TEMPLATE(BM_TTree_GetEntry, Int_t);
+BENCHMARK_TEMPLATE(BM_TTree_GetEntry, Long64_t);
+BENCHMARK_TEMPLATE(BM_TTree_GetEntry, Float_t);
+BENCHMARK_TEMPLATE(BM_TTree_GetEntry, Double_t);
+BENCHMARK_TEMPLATE(BM_TTree_GetEntry, std::vector<float>);
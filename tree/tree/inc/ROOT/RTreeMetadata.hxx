@@ -0,0 +1,42 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RTreeMetadata
+#define ROOT_RTreeMetadata
+
+#include "RtypesCore.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/// Number of entries and cluster boundaries of the tree stored in one file.
+struct RTreeMetadata {
+   enum EStatus { kOk, kNoFile, kNoTree };
+
+   EStatus fStatus = kNoFile;
+   Long64_t fEntries = 0;           ///< Number of entries of the tree
+   std::vector<Long64_t> fClusters; ///< First entry of every cluster, followed by fEntries
+};
+
+/// A (file name, tree name) pair.
+using RTreeLocation_t = std::pair<std::string, std::string>;
+
+std::vector<RTreeMetadata> GetTreeMetadata(const std::vector<RTreeLocation_t> &trees, UInt_t nThreads);
+UInt_t GetTreeMetadataThreads();
+bool IsTreeMetadataCacheEnabled();
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -57,6 +57,7 @@ private:
    // Manage buffer ownership.
    void   DisownBuffer();
    void   AdoptBuffer(TBuffer *user_buffer);
+   void   CopyMappedBuffer();
 
 protected:
    Int_t       fBufferSize{0};                    ///< fBuffer length in bytes
@@ -75,6 +76,8 @@ protected:
    Int_t       fLastWriteBufferSize[3] = {0,0,0}; ///<! Size of the buffer last three buffers we wrote it to disk
    Bool_t      fResetAllocation{false};           ///<! True if last reset re-allocated the memory
    UChar_t     fNextBufferSizeRecord{0};          ///<! Index into fLastWriteBufferSize of the last buffer written to disk
+   Bool_t      fUserBuffer{kFALSE};               ///<! True if fBufferRef was provided by the user (bulk IO)
+   Bool_t      fMappedBuffer{kFALSE};             ///<! True if fBufferRef points into the read-only memory mapping of the file
 #ifdef R__TRACK_BASKET_ALLOC_TIME
    ULong64_t   fResetAllocationTime{0};           ///<! Time spent reallocating baskets in microseconds during last Reset operation.
 #endif
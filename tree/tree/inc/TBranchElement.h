@@ -105,6 +105,9 @@ protected:
    TVirtualCollectionIterators           *fIterators;      ///<! holds the iterators when the branch is of fType==4.
    TVirtualCollectionIterators           *fWriteIterators; ///<! holds the read (non-staging) iterators when the branch is of fType==4 and associative containers.
    TVirtualCollectionPtrIterators        *fPtrIterators;   ///<! holds the iterators when the branch is of fType==4 and it is a split collection of pointers.
+   TClassRef                fRecycledClass;      ///<! Class of the objects in fRecycledElements
+   std::vector<void*>       fCollectionElements; ///<! Elements created for the current entry of a split collection of pointers
+   std::vector<void*>       fRecycledElements;   ///<! Elements of previous entries of a split collection of pointers, kept for reuse
 
 // Not implemented
 private:
@@ -123,6 +126,9 @@ protected:
    TClass                  *GetParentClass(); // Class referenced by fParentName
    TStreamerInfo           *GetInfoImp() const;
    void                     ReleaseObject();
+   void                     ReleaseRecycledElements();
+   void                     RecycleCollectionElements(TVirtualCollectionProxy *proxy);
+   void                    *NewCollectionElement(TClass *cl);
    void                     SetupInfo();
    void                     SetBranchCount(TBranchElement* bre);
    void                     SetBranchCount2(TBranchElement* bre) { fBranchCount2 = bre; }
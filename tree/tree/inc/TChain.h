@@ -52,6 +52,7 @@ private:
 
 protected:
    void InvalidateCurrentTree();
+   Bool_t LoadTreeOffsets();
    void ReleaseChainProof();
 
 public:
@@ -162,6 +163,7 @@ public:
    virtual void      SetMakeClass(Int_t make) { TTree::SetMakeClass(make); if (fTree) fTree->SetMakeClass(make);}
    virtual void      SetName(const char *name);
    virtual void      SetPacketSize(Int_t size = 100);
+   virtual void      SetPerfStats(TVirtualPerfStats *perf) { TTree::SetPerfStats(perf); if (fTree) fTree->SetPerfStats(perf); }
    virtual void      SetProof(Bool_t on = kTRUE, Bool_t refresh = kFALSE, Bool_t gettreeheader = kFALSE);
    virtual void      SetWeight(Double_t w=1, Option_t *option="");
    virtual void      UseCache(Int_t maxCacheSize = 10, Int_t pageSize = 0);
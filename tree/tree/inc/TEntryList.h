@@ -65,6 +65,7 @@ class TEntryList: public TNamed
    virtual Int_t       Contains(Long64_t entry, TTree *tree = 0);
    virtual void        DirectoryAutoAdd(TDirectory *);
    virtual Bool_t      Enter(Long64_t entry, TTree *tree = 0);
+   virtual void        Intersect(const TEntryList *elist);
    virtual TEntryList *GetCurrentList() const { return fCurrent; };
    virtual TEntryList *GetEntryList(const char *treename, const char *filename, Option_t *opt="");
    virtual Long64_t    GetEntry(Int_t index);
@@ -98,6 +99,7 @@ class TEntryList: public TNamed
    virtual void        SetEntriesToProcess(Long64_t nen) { fEntriesToProcess = nen; }
    virtual void        SetShift(Bool_t shift) { fShift = shift; };
    virtual void        SetTree(const TTree *tree);
+   virtual TEntryList *Slice(Long64_t start, Long64_t end) const;
    virtual void        SetTree(const char *treename, const char *filename);
    virtual void        SetTreeName(const char *treename){ fTreeName = treename; };
    virtual void        SetFileName(const char *filename){ fFileName = filename; };
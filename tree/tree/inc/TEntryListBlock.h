@@ -32,6 +32,8 @@
 // - GetEntry(n) - returns n-th non-zero entry.
 // - Next()      - return next non-zero entry. In case of representation 1), Next()
 //                 is faster than GetEntry()
+// - Intersect(), Subtract() - keep the entries that are (are not) in the other block
+// - Slice()     - keep the entries of a range
 //
 //////////////////////////////////////////////////////////////////////////
 
@@ -56,6 +58,12 @@ class TEntryListBlock:public TObject
 
    void Transform(Bool_t dir, UShort_t *indexnew);
 
+   enum EOperation { kUnion, kIntersection, kDifference };
+   Int_t Combine(const TEntryListBlock *block, EOperation op);
+   void  FillBits(UShort_t *bits) const;
+   void  SetBits(UShort_t *bits);
+   void  SetList(UShort_t *list, Int_t n);
+
  public:
 
    enum { kBlockSize = 4000 }; //size of the block, 4000 UShort_ts
@@ -69,11 +77,14 @@ class TEntryListBlock:public TObject
    Int_t   Contains(Int_t entry);
    void    OptimizeStorage();
    Int_t   Merge(TEntryListBlock *block);
+   Int_t   Intersect(const TEntryListBlock *block);
+   Int_t   Subtract(const TEntryListBlock *block);
+   Int_t   Slice(Int_t first, Int_t last);
    Int_t   Next();
    Int_t   GetEntry(Int_t entry);
    void    ResetIndices() {fLastIndexQueried = -1, fLastIndexReturned = -1;}
    Int_t   GetType() { return fType; }
-   Int_t   GetNPassed();
+   Int_t   GetNPassed() const;
    virtual void Print(const Option_t *option = "") const;
    void    PrintWithShift(Int_t shift) const;
 
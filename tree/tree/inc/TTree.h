@@ -42,6 +42,8 @@
 #include "TVirtualTreePlayer.h"
 
 #include <atomic>
+#include <string>
+#include <vector>
 
 
 class TBranch;
@@ -131,6 +133,9 @@ protected:
    UInt_t         fNEntriesSinceSorting;  ///<! Number of entries processed since the last re-sorting of branches
    std::vector<std::pair<Long64_t,TBranch*>> fSortedBranches; ///<! Branches to be processed in parallel when IMT is on, sorted by average task time
    std::vector<TBranch*> fSeqBranches;    ///<! Branches to be processed sequentially when IMT is on
+   std::vector<std::string> fReadProfileBranches; ///<! Names of the branches read together, see SetReadProfile
+   Long64_t       fReadProfileRange{0};   ///<! Typical number of consecutive entries processed by a reader, see SetReadProfile
+   Int_t          fReadProfileBasketSize{0}; ///<! Largest basket size wanted by the readers, see SetReadProfile
    Float_t fTargetMemoryRatio{1.1f};      ///<! Ratio for memory usage in uncompressed buffers versus actual occupancy.  1.0
                                            /// indicates basket should be resized to exact memory usage, but causes significant
 /// memory churn.
@@ -151,6 +156,7 @@ private:
    void             InitializeBranchLists(bool checkLeafCount);
    void             SortBranchesByTime();
    Int_t            FlushBasketsImpl() const;
+   Bool_t           IsReadProfileBranch(const TBranch *branch) const;
    void             MarkEventCluster();
 
 protected:
@@ -576,6 +582,7 @@ public:
    virtual void            SetObject(const char* name, const char* title);
    virtual void            SetParallelUnzip(Bool_t opt=kTRUE, Float_t RelSize=-1);
    virtual void            SetPerfStats(TVirtualPerfStats* perf);
+   virtual Int_t           SetReadProfile(const char *branches, Long64_t entryRange = 0, Int_t basketSize = 0);
    virtual void            SetScanField(Int_t n = 50) { fScanField = n; } // *MENU*
    void SetTargetMemoryRatio(Float_t ratio) { fTargetMemoryRatio = ratio; }
    virtual void            SetTimerInterval(Int_t msec = 333) { fTimerInterval=msec; }
@@ -0,0 +1,278 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/**
+\file RTreeMetadata.cxx
+\ingroup tree
+
+Concurrent reading of the number of entries and cluster boundaries of the
+trees of many files, as needed by TChain::GetEntries and TTreeProcessorMT
+before processing a chain.
+
+Opening thousands of files one after the other is dominated by the latency
+of the storage, so the files are opened by a bounded number of threads. The
+metadata can also be kept in a sidecar cache file, set with the rootrc
+variable `TChain.MetadataCache` or the environment variable
+`ROOT_TCHAIN_METADATA_CACHE`, shared by all the jobs reading the same files.
+The records of the cache are keyed by the UUID of the file, the name of the
+tree, the end of the file and the position of the key of the tree: the UUID
+does not change when a file is updated, but the end of the file or the key
+of a tree written again do. A file still has to be opened to know these, but
+the tree header, which is the large part of the metadata of trees with many
+branches, is not read again.
+*/
+
+#include "ROOT/RTreeMetadata.hxx"
+
+#include "TDirectory.h"
+#include "TEnv.h"
+#include "TError.h"
+#include "TFile.h"
+#include "TKey.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TUUID.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+namespace {
+
+using ROOT::Internal::RTreeMetadata;
+
+/// Identifier of the first line of a metadata cache file.
+const char *kCacheHeader = "# ROOT tree metadata cache v2";
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the path of the metadata cache file, or an empty string if none.
+
+std::string R__GetCachePath()
+{
+   const char *path = gSystem->Getenv("ROOT_TCHAIN_METADATA_CACHE");
+   if (!path || !path[0])
+      path = gEnv->GetValue("TChain.MetadataCache", "");
+   return path ? path : "";
+}
+
+/// Identifies a tree in a given state of its file: UUID of the file, name of
+/// the tree, end of the file and seek of the key of the tree.
+using CacheKey_t = std::tuple<std::string, std::string, Long64_t, Long64_t>;
+
+/// The records of the metadata cache.
+using CacheMap_t = std::map<CacheKey_t, RTreeMetadata>;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the records of the metadata cache file; lines which cannot be parsed
+/// are ignored.
+
+void R__ReadCache(const std::string &path, CacheMap_t &cache)
+{
+   std::ifstream in(path);
+   std::string line;
+   if (!std::getline(in, line) || line != kCacheHeader)
+      return;
+   while (std::getline(in, line)) {
+      std::istringstream record(line);
+      std::string uuid, tree;
+      Long64_t end = 0, seekKey = 0;
+      RTreeMetadata metadata;
+      std::size_t nclusters = 0;
+      if (!(record >> uuid >> tree >> end >> seekKey >> metadata.fEntries >> nclusters))
+         continue;
+      metadata.fClusters.resize(nclusters);
+      for (auto &boundary : metadata.fClusters)
+         record >> boundary;
+      if (!record || nclusters == 0 || metadata.fClusters.back() != metadata.fEntries)
+         continue;
+      metadata.fStatus = RTreeMetadata::kOk;
+      cache[CacheKey_t(uuid, tree, end, seekKey)] = std::move(metadata);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the records to the metadata cache file. The file is replaced
+/// atomically so that concurrent jobs always see a complete cache.
+
+void R__WriteCache(const std::string &path, const CacheMap_t &cache)
+{
+   std::string tmp = path + "." + std::to_string(gSystem->GetPid()) + ".tmp";
+   {
+      std::ofstream out(tmp);
+      out << kCacheHeader << '\n';
+      for (const auto &record : cache) {
+         const auto &tree = std::get<1>(record.first);
+         if (tree.find_first_of(" \t\n") != std::string::npos)
+            continue;
+         out << std::get<0>(record.first) << ' ' << tree << ' ' << std::get<2>(record.first) << ' '
+             << std::get<3>(record.first) << ' ' << record.second.fEntries << ' ' << record.second.fClusters.size();
+         for (auto boundary : record.second.fClusters)
+            out << ' ' << boundary;
+         out << '\n';
+      }
+      if (!out) {
+         ::Warning("TChain", "Cannot write the metadata cache %s", path.c_str());
+         gSystem->Unlink(tmp.c_str());
+         return;
+      }
+   }
+   if (gSystem->Rename(tmp.c_str(), path.c_str())) {
+      ::Warning("TChain", "Cannot write the metadata cache %s", path.c_str());
+      gSystem->Unlink(tmp.c_str());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the seek of the key of the tree treename ("dir/name" or
+/// "name;cycle" are supported) in the file f, or 0 if not found.
+
+Long64_t R__GetTreeSeekKey(TFile &f, const std::string &treename)
+{
+   TDirectory *dir = &f;
+   std::string namecycle = treename;
+   const auto slash = namecycle.rfind('/');
+   if (slash != std::string::npos) {
+      dir = f.GetDirectory(namecycle.substr(0, slash).c_str());
+      namecycle.erase(0, slash + 1);
+   }
+   if (!dir)
+      return 0;
+   std::vector<char> name(namecycle.size() + 1);
+   Short_t cycle = 9999;
+   TDirectory::DecodeNameCycle(namecycle.c_str(), name.data(), cycle, name.size());
+   TKey *key = dir->GetKey(name.data(), cycle);
+   return key ? key->GetSeekKey() : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open a file and read the metadata of one of its trees, from the cache if
+/// it is known there; set cacheKey to the key of the tree in the cache.
+
+RTreeMetadata R__ReadTreeMetadata(const ROOT::Internal::RTreeLocation_t &location, const CacheMap_t &cache,
+                                  CacheKey_t &cacheKey)
+{
+   RTreeMetadata metadata;
+   TDirectory::TContext ctxt;
+   std::unique_ptr<TFile> f(TFile::Open(location.first.c_str())); // need TFile::Open to load plugins if need be
+   if (!f || f->IsZombie())
+      return metadata;
+
+   cacheKey = CacheKey_t(f->GetUUID().AsString(), location.second, f->GetEND(), R__GetTreeSeekKey(*f, location.second));
+   auto cached = cache.find(cacheKey);
+   if (cached != cache.end())
+      return cached->second;
+
+   metadata.fStatus = RTreeMetadata::kNoTree;
+   TTree *t = nullptr; // not a leak, t will be deleted by f
+   f->GetObject(location.second.c_str(), t);
+   if (!t)
+      return metadata;
+
+   metadata.fStatus = RTreeMetadata::kOk;
+   metadata.fEntries = t->GetEntries();
+   auto clusterIter = t->GetClusterIterator(0);
+   Long64_t start;
+   while ((start = clusterIter()) < metadata.fEntries)
+      metadata.fClusters.push_back(start);
+   metadata.fClusters.push_back(metadata.fEntries);
+   return metadata;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of threads used to open the files of a chain: the value
+/// of the rootrc variable `TChain.ParallelOpen` if set, otherwise the size of
+/// the implicit multi-threading pool if enabled, otherwise 1.
+
+UInt_t ROOT::Internal::GetTreeMetadataThreads()
+{
+   Int_t nThreads = gEnv->GetValue("TChain.ParallelOpen", 0);
+   if (nThreads > 0)
+      return nThreads;
+   return ROOT::IsImplicitMTEnabled() ? ROOT::GetImplicitMTPoolSize() : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the metadata are kept in a sidecar cache file.
+
+bool ROOT::Internal::IsTreeMetadataCacheEnabled()
+{
+   return !R__GetCachePath().empty();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the number of entries and the cluster boundaries of the given trees,
+/// opening up to nThreads files concurrently. The result is in the order of
+/// the input; no error is printed, see RTreeMetadata::fStatus.
+
+std::vector<RTreeMetadata> ROOT::Internal::GetTreeMetadata(const std::vector<RTreeLocation_t> &trees, UInt_t nThreads)
+{
+   const std::string cachePath = R__GetCachePath();
+   CacheMap_t cache;
+   if (!cachePath.empty())
+      R__ReadCache(cachePath, cache);
+
+   const std::size_t ntrees = trees.size();
+   std::vector<RTreeMetadata> result(ntrees);
+   std::vector<CacheKey_t> cacheKeys(ntrees);
+   std::atomic<std::size_t> next(0);
+   auto worker = [&]() {
+      for (std::size_t i; (i = next++) < ntrees;)
+         result[i] = R__ReadTreeMetadata(trees[i], cache, cacheKeys[i]);
+   };
+
+   nThreads = std::min<std::size_t>(std::max(nThreads, 1u), ntrees);
+   if (nThreads > 1) {
+      ROOT::EnableThreadSafety();
+      std::vector<std::thread> threads;
+      for (UInt_t i = 1; i < nThreads; ++i)
+         threads.emplace_back(worker);
+      worker();
+      for (auto &thread : threads)
+         thread.join();
+   } else {
+      worker();
+   }
+
+   if (!cachePath.empty()) {
+      Bool_t updated = kFALSE;
+      for (std::size_t i = 0; i < ntrees; ++i) {
+         if (result[i].fStatus != RTreeMetadata::kOk)
+            continue;
+         auto inserted = cache.emplace(cacheKeys[i], result[i]);
+         if (!inserted.second)
+            continue;
+         updated = kTRUE;
+         // Forget the records of the previous states of the same file, which
+         // are next to each other in the map.
+         const auto &uuid = std::get<0>(cacheKeys[i]);
+         const auto &tree = std::get<1>(cacheKeys[i]);
+         auto record = cache.lower_bound(CacheKey_t(uuid, tree, std::numeric_limits<Long64_t>::min(), 0));
+         while (record != cache.end() && std::get<0>(record->first) == uuid && std::get<1>(record->first) == tree) {
+            if (record == inserted.first)
+               ++record;
+            else
+               record = cache.erase(record);
+         }
+      }
+      if (updated)
+         R__WriteCache(cachePath, cache);
+   }
+   return result;
+}
@@ -408,6 +408,11 @@ static inline TBuffer* R__InitializeReadBasketBuffer(TBuffer* bufferRef, Int_t l
    TBuffer* result;
    if (R__likely(bufferRef)) {
       bufferRef->SetReadMode();
+      if (R__unlikely(!bufferRef->TestBit(TBuffer::kIsOwner))) {
+         // The previous basket was used in place (e.g. from a memory-mapped file);
+         // get back a buffer we can grow.
+         bufferRef->SetBuffer(new char[len], len);
+      }
       Int_t curBufferSize = bufferRef->BufferSize();
       if (curBufferSize < len) {
          // Experience shows that giving 5% "wiggle-room" decreases churn.
@@ -462,10 +467,21 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    if(!fBranch->GetDirectory()) {
       return -1;
    }
+   fMappedBuffer = kFALSE;
+
+   // Optional monitor for per-branch read and unzip profiling.
+   TVirtualPerfStats *perfStats = fBranch->GetTree()->GetPerfStats();
+   Double_t readStart = 0;
+   Double_t unzipStart = 0;
+   Bool_t fromUnzipCache = kFALSE;
+   if (R__unlikely(perfStats)) {
+      readStart = TTimeStamp();
+   }
 
    Bool_t oldCase;
    char *rawUncompressedBuffer, *rawCompressedBuffer;
    Int_t uncompressedBufferLen;
+   char *mapped = nullptr;
 
    // See if the cache has already unzipped the buffer for us.
    TFileCacheRead *pf = nullptr;
@@ -483,10 +499,60 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
          // Note that in the kNotDecompressed case, the above function will return 0;
          // In such a case, we should stop processing
          if (len <= 0) return -len;
+         fromUnzipCache = kTRUE;
          goto AfterBuffer;
       }
    }
 
+   // With a memory-mapped file the read cache is redundant: the header is
+   // streamed from the mapped pages, uncompressed baskets are used in place and
+   // compressed ones are inflated straight from the mapping.
+   if (file->IsMapped()) {
+      R__LOCKGUARD_IMT(gROOTMutex); // Lock for parallel TTree I/O
+      TVirtualPerfStats* temp = gPerfStats;
+      if (perfStats) gPerfStats = perfStats;
+      mapped = const_cast<char *>(file->GetMappedBuffer(pos, len));
+      gPerfStats = temp;
+   }
+   if (mapped) {
+      fBranch->GetTree()->IncrementTotalBuffers(-fBufferSize);
+      {
+         TBufferFile header(TBuffer::kRead, len, mapped, kFALSE);
+         header.SetParent(file);
+         Streamer(header);
+      }
+      if (IsZombie()) {
+         return 1;
+      }
+      rawCompressedBuffer = mapped;
+      oldCase = OLD_CASE_EXPRESSION;
+      Bool_t compressed = fObjlen > fNbytes-fKeylen || oldCase;
+      if (compressed && !(TestBit(TBufferFile::kNotDecompressed) && (fNevBuf==1))) {
+         goto InflateBuffer;
+      }
+      if (fUserBuffer) {
+         // The bulk IO modifies the user's buffer in place and keeps it beyond
+         // the life of the file: copy the basket out of the read-only mapping.
+         fBufferRef = R__InitializeReadBasketBuffer(fBufferRef, len, file);
+         memcpy(fBufferRef->Buffer(), mapped, len);
+      } else if (fBufferRef) {
+         fBufferRef->SetReadMode();
+         fBufferRef->SetBuffer(mapped, len, kFALSE);
+         fBufferRef->Reset();
+         fMappedBuffer = kTRUE;
+      } else {
+         fBufferRef = new TBufferFile(TBuffer::kRead, len, mapped, kFALSE);
+         fMappedBuffer = kTRUE;
+      }
+      fBufferRef->SetParent(file);
+      if (compressed) {
+         return ReadBasketBuffersUncompressedCase();
+      }
+      fBufferRef->SetBufferOffset(fKeylen);
+      fBuffer = fBufferRef->Buffer();
+      goto AfterBuffer;
+   }
+
    // Determine which buffer to use, so that we can avoid a memcpy in case of
    // the basket was not compressed.
    TBuffer* readBufferRef;
@@ -571,6 +637,7 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       }
    }
 
+InflateBuffer:
    // Initialize buffer to hold the uncompressed data
    // Note that in previous versions we didn't allocate buffers until we verified
    // the zip headers; this is no longer beforehand as the buffer lifetime is scoped
@@ -592,6 +659,9 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       if (R__unlikely(gPerfStats)) {
          start = TTimeStamp();
       }
+      if (R__unlikely(perfStats)) {
+         unzipStart = TTimeStamp();
+      }
 
       memcpy(rawUncompressedBuffer, rawCompressedBuffer, fKeylen);
       char *rawUncompressedObjectBuffer = rawUncompressedBuffer+fKeylen;
@@ -641,6 +711,11 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
 
 AfterBuffer:
 
+   if (R__unlikely(perfStats)) {
+      perfStats->BasketReadEvent(fBranch, fNbytes, (unzipStart || fromUnzipCache) ? fObjlen : 0, readStart, unzipStart,
+                                 fromUnzipCache);
+   }
+
    fBranch->GetTree()->IncrementTotalBuffers(fBufferSize);
 
    // Read offsets table if needed.
@@ -707,6 +782,8 @@ Int_t TBasket::ReadBasketBytes(Long64_t pos, TFile *file)
 void TBasket::DisownBuffer()
 {
    fBufferRef = NULL;
+   fUserBuffer = kFALSE;
+   fMappedBuffer = kFALSE;
 }
 
 
@@ -716,6 +793,26 @@ void TBasket::AdoptBuffer(TBuffer *user_buffer)
 {
    delete fBufferRef;
    fBufferRef = user_buffer;
+   fUserBuffer = user_buffer != nullptr;
+   fMappedBuffer = kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the basket's buffer out of the memory mapping of the file, if it is
+/// used in place, so that it can be modified (e.g. byte-swapped by the bulk IO).
+
+void TBasket::CopyMappedBuffer()
+{
+   if (!fMappedBuffer || !fBufferRef)
+      return;
+   const Int_t len = fBufferRef->BufferSize();
+   const Int_t offset = fBufferRef->Length();
+   char *copy = new char[len];
+   memcpy(copy, fBufferRef->Buffer(), len);
+   fBufferRef->SetBuffer(copy, len, kTRUE);
+   fBufferRef->SetBufferOffset(offset);
+   fBuffer = copy;
+   fMappedBuffer = kFALSE;
 }
 
 
@@ -1446,6 +1446,9 @@ Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf)
    }
 
    basket->PrepareBasket(entry);
+   // The buffer is handed to the caller: it must not point into the read-only
+   // memory mapping of the file.
+   basket->CopyMappedBuffer();
    TBuffer* buf = basket->GetBufferRef();
 
    // Test for very old ROOT files.
@@ -1506,6 +1509,9 @@ Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf, TBuffer *
    }
 
    basket->PrepareBasket(entry);
+   // The buffer is handed to the caller: it must not point into the read-only
+   // memory mapping of the file.
+   basket->CopyMappedBuffer();
    TBuffer* buf = basket->GetBufferRef();
 
    // Test for very old ROOT files.
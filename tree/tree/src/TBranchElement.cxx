@@ -986,6 +986,8 @@ TBranchElement::~TBranchElement()
    delete fIterators;
    delete fWriteIterators;
    delete fPtrIterators;
+
+   ReleaseRecycledElements();
 }
 
 //
@@ -4154,6 +4156,12 @@ void TBranchElement::ReadLeavesCollection(TBuffer& b)
    // TODO: Exception safety a la TPushPop
    TVirtualCollectionProxy* proxy = GetCollectionProxy();
    TVirtualCollectionProxy::TPushPop helper(proxy, fObject);
+   const Bool_t recycle = (fSTLtype == ROOT::kSTLvector || fSTLtype == ROOT::kSTLlist || fSTLtype == ROOT::kSTLdeque) &&
+                          proxy->HasPointers() && fSplitLevel > TTree::kSplitCollectionOfPointers;
+   if (recycle) {
+      // Take back the objects of the previous entry before Allocate deletes them.
+      RecycleCollectionElements(proxy);
+   }
    void* alternate = proxy->Allocate(fNdata, true);
    if(fSTLtype != ROOT::kSTLvector && proxy->HasPointers() && fSplitLevel > TTree::kSplitCollectionOfPointers ) {
       fPtrIterators->CreateIterators(alternate, proxy);
@@ -4206,7 +4214,7 @@ void TBranchElement::ReadLeavesCollection(TBuffer& b)
       {
          void **el = (void**)proxy->At( i );
          // coverity[dereference] since this is a member streaming action by definition the collection contains objects and elClass is not null.
-         *el = elClass->New();
+         *el = recycle ? NewCollectionElement(elClass) : elClass->New();
       }
    }
 
@@ -4629,6 +4637,79 @@ void TBranchElement::ResetAfterMerge(TFileMergeInfo *info)
    TBranch::ResetAfterMerge(info);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the objects kept for reuse by a split collection of pointers.
+
+void TBranchElement::ReleaseRecycledElements()
+{
+   TClass *cl = fRecycledClass;
+   for (void *obj : fRecycledElements) {
+      if (cl) {
+         cl->Destructor(obj);
+      }
+   }
+   fRecycledElements.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move the objects created by this branch for the previous entry of a split
+/// vector, list or deque of pointers out of the collection and into the
+/// recycling pool, so that the next entry can reuse them instead of
+/// allocating new ones. They are pooled in reverse order: the i-th element of
+/// the next entry gets the object of the i-th element of this one.
+///
+/// This is only done if the collection still holds exactly the objects we
+/// handed out: if the user modified it, the objects are left alone and
+/// Allocate deletes them as usual.
+
+void TBranchElement::RecycleCollectionElements(TVirtualCollectionProxy *proxy)
+{
+   const UInt_t n = proxy->Size();
+   if (n && n == fCollectionElements.size()) {
+      UInt_t i = 0;
+      while (i < n && *(void**)proxy->At(i) == fCollectionElements[i]) {
+         ++i;
+      }
+      if (i == n) {
+         for (i = 0; i < n; ++i) {
+            *(void**)proxy->At(i) = nullptr;
+         }
+         fRecycledElements.insert(fRecycledElements.end(), fCollectionElements.rbegin(), fCollectionElements.rend());
+      }
+   }
+   fCollectionElements.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return an object of class cl for an element of a split collection of
+/// pointers: an object of a previous entry if one is available, otherwise a
+/// new one.
+///
+/// A reused object is destructed and default constructed again in place, so
+/// that, as before the recycling, the members that are not read (transient
+/// ones, or the ones whose branch is disabled) have their default value;
+/// only the allocation of the object itself is saved.
+
+void *TBranchElement::NewCollectionElement(TClass *cl)
+{
+   if (cl != fRecycledClass) {
+      // The value class changed (e.g. after a schema change); start afresh.
+      ReleaseRecycledElements();
+      fRecycledClass = cl;
+   }
+   void *obj = nullptr;
+   if (!fRecycledElements.empty()) {
+      obj = fRecycledElements.back();
+      fRecycledElements.pop_back();
+      cl->Destructor(obj, kTRUE);
+      cl->New(obj);
+   } else {
+      obj = cl->New();
+   }
+   fCollectionElements.push_back(obj);
+   return obj;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set branch address to zero and free all allocated memory.
 
@@ -4654,6 +4735,7 @@ void TBranchElement::ResetAddress()
    //
 
    ReleaseObject();
+   fCollectionElements.clear();
 
    ResetBit(kAddressSet);
    fAddress = 0;
@@ -4824,6 +4906,9 @@ void TBranchElement::SetAddress(void* addr)
       return;
    }
 
+   // The collection elements of the previous address are not ours to reuse.
+   fCollectionElements.clear();
+
    //
    //  FIXME: When would this happen?
    //
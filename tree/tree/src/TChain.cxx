@@ -55,6 +55,7 @@ the trees in the chain.
 #include "TFileStager.h"
 #include "TFilePrefetch.h"
 #include "TVirtualMutex.h"
+#include "ROOT/RTreeMetadata.hxx"
 
 ClassImp(TChain);
 
@@ -946,12 +947,60 @@ Long64_t TChain::GetEntries() const
                                " run TChain::SetProof(kTRUE, kTRUE) first");
       return fProofChain->GetEntries();
    }
-   if (fEntries == TTree::kMaxEntries) {
+   if (fEntries == TTree::kMaxEntries && !const_cast<TChain*>(this)->LoadTreeOffsets()) {
       const_cast<TChain*>(this)->LoadTree(TTree::kMaxEntries-1);
    }
    return fEntries;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the offset table without loading the trees one after the other.
+///
+/// The files whose number of entries is not known yet are opened
+/// concurrently, by up to `TChain.ParallelOpen` threads (by default the size
+/// of the implicit multi-threading pool, if enabled), and their metadata may
+/// come from the cache set with `TChain.MetadataCache`, see
+/// ROOT::Internal::GetTreeMetadata. Return false if nothing was gained over
+/// loading the trees or if some of the trees could not be read; LoadTree then
+/// takes care of computing the table and of reporting the errors.
+
+Bool_t TChain::LoadTreeOffsets()
+{
+   if (ROOT::Internal::GetTreeMetadataThreads() <= 1 && !ROOT::Internal::IsTreeMetadataCacheEnabled()) {
+      return kFALSE;
+   }
+   std::vector<ROOT::Internal::RTreeLocation_t> locations;
+   std::vector<TChainElement*> elements;
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      TChainElement *element = (TChainElement*) fFiles->UncheckedAt(i);
+      if (element->GetEntries() == TTree::kMaxEntries) {
+         locations.emplace_back(element->GetTitle(), element->GetName());
+         elements.push_back(element);
+      }
+   }
+   if (locations.empty()) {
+      return kFALSE;
+   }
+   auto metadata = ROOT::Internal::GetTreeMetadata(locations, ROOT::Internal::GetTreeMetadataThreads());
+   Bool_t ok = kTRUE;
+   for (std::size_t i = 0; i < elements.size(); ++i) {
+      if (metadata[i].fStatus == ROOT::Internal::RTreeMetadata::kOk) {
+         elements[i]->SetNumberEntries(metadata[i].fEntries);
+      } else {
+         ok = kFALSE;
+      }
+   }
+   if (!ok) {
+      return kFALSE;
+   }
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      TChainElement *element = (TChainElement*) fFiles->UncheckedAt(i);
+      fTreeOffset[i+1] = fTreeOffset[i] + element->GetEntries();
+   }
+   fEntries = fTreeOffset[fNtrees];
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get entry from the file to memory.
 ///
@@ -1633,6 +1682,7 @@ Long64_t TChain::LoadTree(Long64_t entry)
 
    fTree->SetMakeClass(fMakeClass);
    fTree->SetMaxVirtualSize(fMaxVirtualSize);
+   if (fPerfStats) fTree->SetPerfStats(fPerfStats);
 
    SetChainOffset(fTreeOffset[fTreeNumber]);
 
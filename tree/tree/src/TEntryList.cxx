@@ -55,6 +55,9 @@ End_Macro
 - __Subtract__() - if the lists are for the same TTree, removes the entries of the second
                list from the first list. If the lists are for TChains, loops over all
                sub-lists
+- __Intersect__() - removes the entries of the first list which are not in the second
+               list, matching the sub-lists as Subtract() does
+- __Slice__(start, end) - returns a new list with the entries in the range [start, end)
 - __GetEntry(n)__ - returns the n-th entry number
 - __Next__()      - returns next entry number. Note, that this function is
                 much faster than GetEntry, and it's called when GetEntry() is called
@@ -1229,13 +1232,17 @@ void TEntryList::Subtract(const TEntryList *elist)
          //second list is also only for 1 tree
          if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
              !strcmp(elist->fFileName.Data(),fFileName.Data())){
-            //same tree
-            Long64_t n2 = elist->GetN();
-            Long64_t entry;
-            for (Int_t i=0; i<n2; i++){
-               entry = (const_cast<TEntryList*>(elist))->GetEntry(i);
-               Remove(entry);
+            //same tree, subtract block by block
+            if (!elist->fBlocks) return;
+            Int_t nmin = TMath::Min(fNBlocks, elist->fNBlocks);
+            for (Int_t i=0; i<nmin; i++){
+               TEntryListBlock *block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+               TEntryListBlock *block2 = (TEntryListBlock*)elist->fBlocks->UncheckedAt(i);
+               Long64_t nold = block1->GetNPassed();
+               fN = fN - nold + block1->Subtract(block2);
             }
+            fLastIndexQueried = -1;
+            fLastIndexReturned = 0;
          } else {
             //different trees
             return;
@@ -1270,6 +1277,107 @@ void TEntryList::Subtract(const TEntryList *elist)
    return;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Remove all the entries of this entry list, that are not contained in elist
+
+void TEntryList::Intersect(const TEntryList *elist)
+{
+   if (!fLists){
+      if (!fBlocks) return;
+      //find the list of elist for the same tree as this list, if any
+      const TEntryList *other = 0;
+      if (!elist->fLists){
+         if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
+             !strcmp(elist->fFileName.Data(),fFileName.Data()))
+            other = elist;
+      } else {
+         TIter next1(elist->GetLists());
+         TEntryList *templist = 0;
+         while ((templist = (TEntryList*)next1())){
+            if (!strcmp(templist->fTreeName.Data(),fTreeName.Data()) &&
+                !strcmp(templist->fFileName.Data(),fFileName.Data())){
+               other = templist;
+               break;
+            }
+         }
+      }
+      //intersect block by block; the blocks missing in elist are emptied
+      TEntryListBlock empty;
+      fN = 0;
+      for (Int_t i=0; i<fNBlocks; i++){
+         TEntryListBlock *block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+         const TEntryListBlock *block2 = &empty;
+         if (other && other->fBlocks && i<other->fNBlocks)
+            block2 = (TEntryListBlock*)other->fBlocks->UncheckedAt(i);
+         fN += block1->Intersect(block2);
+      }
+      fLastIndexQueried = -1;
+      fLastIndexReturned = 0;
+   } else {
+      //this list has sublists
+      TIter next2(fLists);
+      TEntryList *templist = 0;
+      Long64_t oldn=0;
+      while ((templist = (TEntryList*)next2())){
+         oldn = templist->GetN();
+         templist->Intersect(elist);
+         fN = fN - oldn + templist->GetN();
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new entry list (owned by the caller) with the entries of this list
+/// in the range [start, end).
+/// The blocks fully inside the range are copied as they are, only the two
+/// blocks at the edges of the range are filtered; the lists of a chain are
+/// sliced one by one. This list is left untouched, including its iteration
+/// state, so that several slices can be taken concurrently.
+
+TEntryList *TEntryList::Slice(Long64_t start, Long64_t end) const
+{
+   TEntryList *slice = new TEntryList();
+   slice->SetNameTitle(GetName(), GetTitle());
+   slice->fTreeName = fTreeName;
+   slice->fFileName = fFileName;
+   slice->fStringHash = fStringHash;
+   slice->fTreeNumber = fTreeNumber;
+   slice->fShift = fShift;
+   slice->fReapply = fReapply;
+   if (fLists){
+      slice->fLists = new TList();
+      TIter next(fLists);
+      TEntryList *templist = 0;
+      while ((templist = (TEntryList*)next())){
+         TEntryList *sublist = templist->Slice(start, end);
+         slice->fLists->Add(sublist);
+         slice->fN += sublist->GetN();
+      }
+      return slice;
+   }
+   slice->fCurrent = slice;
+   if (!fBlocks || start >= end) return slice;
+   if (start < 0) start = 0;
+   Long64_t first = start/kBlockSize;
+   Long64_t last = TMath::Min((Long64_t)fNBlocks, (end-1)/kBlockSize+1);
+   if (first >= last) return slice;
+   slice->fBlocks = new TObjArray();
+   for (Long64_t i=0; i<last; i++){
+      TEntryListBlock *block = 0;
+      if (i < first) {
+         block = new TEntryListBlock();
+      } else {
+         block = new TEntryListBlock(*(TEntryListBlock*)fBlocks->UncheckedAt(i));
+         if (i == first || i == last-1)
+            block->Slice(TMath::Max(start - i*kBlockSize, 0LL), TMath::Min(end - i*kBlockSize, (Long64_t)kBlockSize));
+         slice->fN += block->GetNPassed();
+      }
+      slice->fBlocks->Add(block);
+   }
+   slice->fNBlocks = last;
+   return slice;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 TEntryList operator||(TEntryList &elist1, TEntryList &elist2)
@@ -41,13 +41,64 @@ End_Macro
  - __GetEntry(n)__ - returns n-th non-zero entry.
  - __Next__()      - return next non-zero entry. In case of representation 1), Next()
                  is faster than GetEntry()
+ - __Intersect__(), __Subtract__() - keep only the entries that are (are not) in the other block
+ - __Slice__(first, last) - keep only the entries in the range [first, last)
+
+The set operations work on whole 16-bit words of the bits representation, or
+merge the sorted arrays when both blocks store the passing entries as a list,
+rather than entry by entry.
 */
 
 #include "TEntryListBlock.h"
 #include "TString.h"
 
+#include <algorithm>
+#include <cstring>
+
 ClassImp(TEntryListBlock);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of bits set in word
+
+inline Int_t R__BitCount(UInt_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_popcount(word);
+#else
+   Int_t n = 0;
+   for (; word; word &= word - 1)
+      ++n;
+   return n;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Position of the lowest bit set in word, which must not be 0
+
+inline Int_t R__LowestBit(UInt_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_ctz(word);
+#else
+   Int_t n = 0;
+   for (; !(word & 1); word >>= 1)
+      ++n;
+   return n;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// True if the bit of entry is set in the bits representation
+
+inline Bool_t R__TestBit(const UShort_t *bits, Int_t entry)
+{
+   return (bits[entry >> 4] & (1 << (entry & 15))) != 0;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default c-tor
 
@@ -206,34 +257,14 @@ Int_t TEntryListBlock::Contains(Int_t entry)
       Bool_t result = (fIndices[i] & (1<<j))!=0;
       return result;
    }
-   //list
-   if (entry < fCurrent) fCurrent = 0;
-   if (fPassing && fIndices){
-      for (Int_t i = fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return kTRUE;
-         }
-      }
-   } else {
-      if (!fIndices || fNPassed==0){
-         //all entries pass
-         return kTRUE;
-      }
-      if (entry > fIndices[fNPassed-1])
-         return kTRUE;
-      for (Int_t i= fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return kFALSE;
-         }
-         if (fIndices[i]>entry){
-            fCurrent = i;
-            return kTRUE;
-         }
-      }
+   //list, sorted
+   if (fPassing && fIndices)
+      return std::binary_search(fIndices, fIndices + fNPassed, entry);
+   if (!fIndices || fNPassed==0){
+      //all entries pass
+      return kTRUE;
    }
-   return 0;
+   return !std::binary_search(fIndices, fIndices + fNPassed, entry);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -242,132 +273,193 @@ Int_t TEntryListBlock::Contains(Int_t entry)
 
 Int_t TEntryListBlock::Merge(TEntryListBlock *block)
 {
-   Int_t i, j;
    if (block->GetNPassed() == 0) return GetNPassed();
    if (GetNPassed() == 0){
       //this block is empty
-      fN = block->fN;
-      fIndices = new UShort_t[fN];
-      for (i=0; i<fN; i++)
-         fIndices[i] = block->fIndices[i];
-      fNPassed = block->fNPassed;
-      fType = block->fType;
-      fPassing = block->fPassing;
-      fCurrent = block->fCurrent;
-      fLastIndexReturned = -1;
-      fLastIndexQueried = -1;
-      return fNPassed;
+      *this = *block;
+      return GetNPassed();
    }
-   if (fType==0){
-      //stored as bits
-      if (block->fType == 0){
-         for (i=0; i<kBlockSize*16; i++){
-            if (block->Contains(i))
-               Enter(i);
-         }
-      } else {
-         if (block->fPassing){
-            //the other block stores entries that pass
-            for (i=0; i<block->fNPassed; i++){
-               Enter(block->fIndices[i]);
-            }
-         } else {
-            //the other block stores entries that don't pass
-            if (block->fNPassed==0){
-               for (i=0; i<kBlockSize*16; i++){
-                  Enter(i);
-               }
-            }
-            for (j=0; j<block->fIndices[0]; j++)
-               Enter(j);
-            for (i=0; i<block->fNPassed-1; i++){
-               for (j=block->fIndices[i]+1; j<block->fIndices[i+1]; j++){
-                  Enter(j);
-               }
-            }
-            for (j=block->fIndices[block->fNPassed-1]+1; j<kBlockSize*16; j++)
-               Enter(j);
-         }
+   return Combine(block, kUnion);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Keep only the entries which are also in the other block
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Intersect(const TEntryListBlock *block)
+{
+   if (GetNPassed() == 0) return 0;
+   return Combine(block, kIntersection);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the entries which are in the other block
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Subtract(const TEntryListBlock *block)
+{
+   if (GetNPassed() == 0 || block->GetNPassed() == 0) return GetNPassed();
+   return Combine(block, kDifference);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Keep only the entries in the range [first, last)
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Slice(Int_t first, Int_t last)
+{
+   if (first < 0) first = 0;
+   if (last > kBlockSize*16) last = kBlockSize*16;
+   if (GetNPassed() == 0) return 0;
+   if (fType==1 && fPassing){
+      UShort_t *begin = std::lower_bound(fIndices, fIndices + fNPassed, first);
+      UShort_t *end = std::lower_bound(begin, fIndices + fNPassed, last);
+      UShort_t *newlist = new UShort_t[end - begin];
+      std::copy(begin, end, newlist);
+      SetList(newlist, end - begin);
+      return GetNPassed();
+   }
+   UShort_t *bits = new UShort_t[kBlockSize];
+   FillBits(bits);
+   for (Int_t i=0; i<kBlockSize; i++){
+      Int_t low = i*16;
+      if (low + 16 <= first || low >= last) {
+         bits[i] = 0;
+         continue;
       }
+      UInt_t mask = 0xFFFF;
+      if (first > low) mask &= 0xFFFFu << (first - low);
+      if (last < low + 16) mask &= (1u << (last - low)) - 1;
+      bits[i] &= mask;
+   }
+   SetBits(bits);
+   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the content of this block by its union, intersection or difference
+/// with the other block.
+/// When both blocks store their passing entries as sorted lists, the lists are
+/// merged; otherwise the operation is done word by word on the bits
+/// representation of the blocks.
+
+Int_t TEntryListBlock::Combine(const TEntryListBlock *block, EOperation op)
+{
+   const Bool_t isList = fType==1 && fPassing;
+   const Bool_t otherIsList = block->fType==1 && block->fPassing;
+   if (isList && otherIsList && (op != kUnion || fNPassed + block->fNPassed <= kBlockSize)) {
+      const UShort_t *begin1 = fIndices, *end1 = fIndices + fNPassed;
+      const UShort_t *begin2 = block->fIndices, *end2 = block->fIndices + block->fNPassed;
+      UShort_t *newlist = new UShort_t[op == kUnion ? fNPassed + block->fNPassed : fNPassed];
+      UShort_t *newend = nullptr;
+      if (op == kUnion)
+         newend = std::set_union(begin1, end1, begin2, end2, newlist);
+      else if (op == kIntersection)
+         newend = std::set_intersection(begin1, end1, begin2, end2, newlist);
+      else
+         newend = std::set_difference(begin1, end1, begin2, end2, newlist);
+      SetList(newlist, newend - newlist);
+      return GetNPassed();
+   }
+
+   UShort_t other[kBlockSize];
+   block->FillBits(other);
+   if (isList && op != kUnion) {
+      //intersection or difference of a list: it can only get shorter
+      const Bool_t keep = op == kIntersection;
+      UShort_t *newlist = new UShort_t[fNPassed];
+      UShort_t *newend = std::copy_if(fIndices, fIndices + fNPassed, newlist,
+                                      [&other, keep](UShort_t entry) { return R__TestBit(other, entry) == keep; });
+      SetList(newlist, newend - newlist);
+      return GetNPassed();
+   }
+
+   UShort_t *bits = new UShort_t[kBlockSize];
+   FillBits(bits);
+   if (op == kUnion) {
+      for (Int_t i=0; i<kBlockSize; i++)
+         bits[i] |= other[i];
+   } else if (op == kIntersection) {
+      for (Int_t i=0; i<kBlockSize; i++)
+         bits[i] &= other[i];
    } else {
-      //stored as a list
-      if (GetNPassed() + block->GetNPassed() > kBlockSize){
-         //change to bits
-         UShort_t *bits = new UShort_t[kBlockSize];
-         Transform(1, bits);
-         Merge(block);
-      } else {
-         //this is only possible if fPassing=1 in both blocks
-         if (block->fType==1){
-            //second block stored as a list
-            //make a bigger list
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            UShort_t *elst = block->fIndices;
-            Int_t newpos, elpos;
-            newpos = elpos = 0;
-            for (i=0; i<fNPassed; i++) {
-               while (elpos < en && fIndices[i] > elst[elpos]) {
-                  newlist[newpos] = elst[elpos];
-                  newpos++;
-                  elpos++;
-               }
-               if (fIndices[i] == elst[elpos]) elpos++;
-               newlist[newpos] = fIndices[i];
-               newpos++;
-            }
-            while (elpos < en) {
-               newlist[newpos] = elst[elpos];
-               newpos++;
-               elpos++;
-            }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
-         } else {
-            //second block is stored as bits
-
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            Int_t newpos, current;
-            newpos = current = 0;
-            for (i=0; i<kBlockSize*16; i++){
-               if (!block->Contains(i)) continue;
-               while(current < fNPassed && fIndices[current]<i){
-                  newlist[newpos] = fIndices[current];
-                  current++;
-                  newpos++;
-               }
-               if (fIndices[current]==i) current++;
-               newlist[newpos] = i;
-               newpos++;
-            }
-            while(current<fNPassed){
-               newlist[newpos] = fIndices[current];
-               newpos++;
-               current++;
-            }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
-         }
-      }
+      for (Int_t i=0; i<kBlockSize; i++)
+         bits[i] &= ~other[i];
    }
+   SetBits(bits);
+   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the bits representation of this block, whatever its current
+/// representation, into the kBlockSize words of bits
+
+void TEntryListBlock::FillBits(UShort_t *bits) const
+{
+   if (fType==0 && fIndices) {
+      memcpy(bits, fIndices, kBlockSize*sizeof(UShort_t));
+      return;
+   }
+   if (fType!=1 || (fPassing && !fIndices)) {
+      //empty block
+      memset(bits, 0, kBlockSize*sizeof(UShort_t));
+      return;
+   }
+   if (fPassing) {
+      memset(bits, 0, kBlockSize*sizeof(UShort_t));
+      for (Int_t i=0; i<fNPassed; i++)
+         bits[fIndices[i]>>4] |= 1<<(fIndices[i] & 15);
+   } else {
+      memset(bits, 0xFF, kBlockSize*sizeof(UShort_t));
+      for (Int_t i=0; fIndices && i<fNPassed; i++)
+         bits[fIndices[i]>>4] &= ~(1<<(fIndices[i] & 15));
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Adopt the array of kBlockSize words as bits representation of the block
+/// and choose the best representation for the result
+
+void TEntryListBlock::SetBits(UShort_t *bits)
+{
+   Int_t npassed = 0;
+   for (Int_t i=0; i<kBlockSize; i++)
+      npassed += R__BitCount(bits[i]);
+   if (fIndices)
+      delete [] fIndices;
+   fIndices = bits;
+   fN = kBlockSize;
+   fNPassed = npassed;
+   fType = 0;
+   fPassing = 1;
+   fCurrent = 0;
    fLastIndexQueried = -1;
    fLastIndexReturned = -1;
    OptimizeStorage();
-   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Adopt the sorted array of the n passing entries as list representation
+
+void TEntryListBlock::SetList(UShort_t *list, Int_t n)
+{
+   if (fIndices)
+      delete [] fIndices;
+   fIndices = list;
+   fN = n;
+   fNPassed = n;
+   fType = 1;
+   fPassing = 1;
+   fCurrent = 0;
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of entries, passing the selection.
 /// In case, when the block stores entries that pass (fPassing=1) returns fNPassed
 
-Int_t TEntryListBlock::GetNPassed()
+Int_t TEntryListBlock::GetNPassed() const
 {
    if (fPassing)
       return fNPassed;
@@ -382,21 +474,22 @@ Int_t TEntryListBlock::GetNPassed()
 Int_t TEntryListBlock::GetEntry(Int_t entry)
 {
    if (entry > kBlockSize*16) return -1;
-   if (entry > GetNPassed()) return -1;
+   if (entry >= GetNPassed()) return -1;
    if (entry == fLastIndexQueried+1) return Next();
    else {
       Int_t i=0; Int_t j=0; Int_t entries_found=0;
       if (fType==0){
-         if ((fIndices[i] & (1<<j))!=0)
-            entries_found++;
-         while (entries_found<entry+1){
-            if (j==15){i++; j=0;}
-            else j++;
-            if ((fIndices[i] & (1<<j))!=0)
-               entries_found++;
+         //skip the words before the one holding the entry
+         Int_t nbits;
+         while (entries_found + (nbits = R__BitCount(fIndices[i])) <= entry){
+            entries_found += nbits;
+            i++;
          }
+         UInt_t word = fIndices[i];
+         for (; entries_found<entry; entries_found++)
+            word &= word - 1;
          fLastIndexQueried = entry;
-         fLastIndexReturned = i*16+j;
+         fLastIndexReturned = i*16+R__LowestBit(word);
          return fLastIndexReturned;
       }
       if (fType==1){
@@ -453,19 +546,13 @@ Int_t TEntryListBlock::Next()
    }
 
    if (fType==0) {
-      //bits
-      Int_t i=0;
-      Int_t j=0;
+      //bits, skipping the empty words
       fLastIndexReturned++;
-      i = fLastIndexReturned>>4;
-      j = fLastIndexReturned & 15;
-      Bool_t result=(fIndices[i] & (1<<j))!=0;
-      while (result==0){
-         if (j==15) {j=0; i++;}
-         else j++;
-         result = (fIndices[i] & (1<<j))!=0;
-      }
-      fLastIndexReturned = i*16+j;
+      Int_t i = fLastIndexReturned>>4;
+      UInt_t word = fIndices[i] & (0xFFFFu << (fLastIndexReturned & 15));
+      while (word==0)
+         word = fIndices[++i];
+      fLastIndexReturned = i*16+R__LowestBit(word);
       fLastIndexQueried++;
       return fLastIndexReturned;
 
@@ -4510,6 +4510,13 @@ Int_t TTree::Fill()
          if (fAutoSave)
             autoSave = fAutoSave < 0 ? (zipBytes > -fAutoSave) : fEntries % fAutoSave == 0;
 
+         if (autoFlush && !autoSave && fAutoFlush < 0 && fReadProfileRange > 0) {
+            // Wait until the cluster boundaries are aligned with the ranges of entries
+            // processed by the readers (see SetReadProfile).
+            if (fEntries < fReadProfileRange ? fReadProfileRange % fEntries : fEntries % fReadProfileRange)
+               autoFlush = false;
+         }
+
          if (autoFlush || autoSave) {
             // First call FlushBasket to make sure that fTotBytes is up to date.
             FlushBasketsImpl();
@@ -5004,9 +5011,28 @@ Int_t TTree::FlushBasketsImpl() const
       return nerrpar ? -1 : nbpar.load();
    }
 #endif
+   // The branches read together (see SetReadProfile) go first, so that their
+   // baskets are next to each other in the file.
+   // The top level ones are then skipped by the loop over all the branches.
+   if (!fReadProfileBranches.empty()) {
+      std::vector<TBranch*> profileBranches;
+      for (TObject *obj : fLeaves) {
+         TBranch *branch = ((TLeaf*)obj)->GetBranch();
+         if (!IsReadProfileBranch(branch) ||
+             std::find(profileBranches.begin(), profileBranches.end(), branch) != profileBranches.end())
+            continue;
+         profileBranches.push_back(branch);
+         Int_t nwrite = branch->FlushOneBasket(branch->GetWriteBasket());
+         if (nwrite<0) {
+            ++nerror;
+         } else {
+            nbytes += nwrite;
+         }
+      }
+   }
    for (Int_t j = 0; j < nb; j++) {
       TBranch* branch = (TBranch*) lb->UncheckedAt(j);
-      if (branch) {
+      if (branch && !IsReadProfileBranch(branch)) {
          Int_t nwrite = branch->FlushBaskets();
          if (nwrite<0) {
             ++nerror;
@@ -6814,6 +6840,10 @@ Bool_t TTree::Notify()
 /// In case the branch compression factor for the data written so far is less
 /// than compMin, the compression is disabled.
 ///
+/// The branches declared as read together with SetReadProfile get baskets
+/// holding a whole cluster, within maxMemory and up to the basket size wanted
+/// by the readers.
+///
 /// if option ="d" an analysis report is printed.
 
 void TTree::OptimizeBaskets(ULong64_t maxMemory, Float_t minComp, Option_t *option)
@@ -6867,9 +6897,21 @@ void TTree::OptimizeBaskets(ULong64_t maxMemory, Float_t minComp, Option_t *opti
             newBaskets += 1+Int_t(totBytes/oldBsize);
             continue;
          }
-         Double_t bsize = oldBsize*idealFactor*memFactor; //bsize can be very large !
-         if (bsize < 0) bsize = bmax;
-         if (bsize > bmax) bsize = bmax;
+         Double_t bsize;
+         if (IsReadProfileBranch(branch)) {
+            // Branches read together (see SetReadProfile) get one basket per cluster,
+            // scaled like the others to fit in maxMemory and within the size wanted by the readers.
+            Long64_t clusterSize = (fAutoFlush > 0) ? fAutoFlush : branch->GetEntries();
+            Double_t bsizeMax = bmax;
+            if (fReadProfileBasketSize > 0 && fReadProfileBasketSize < bsizeMax) bsizeMax = fReadProfileBasketSize;
+            bsize = Double_t(sizeOfOneEntry)*clusterSize*memFactor;
+            if (bsize < 0) bsize = bsizeMax;
+            if (bsize > bsizeMax) bsize = bsizeMax;
+         } else {
+            bsize = oldBsize*idealFactor*memFactor; //bsize can be very large !
+            if (bsize < 0) bsize = bmax;
+            if (bsize > bmax) bsize = bmax;
+         }
          UInt_t newBsize = UInt_t(bsize);
          if (pass) { // only on the second pass so that it doesn't interfere with scaling
             // If there is an entry offset, it will be stored in the same buffer as the object data; hence,
@@ -8931,6 +8973,79 @@ void TTree::SetPerfStats(TVirtualPerfStats *perf)
    fPerfStats = perf;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the branch is one of the branches read together, see
+/// SetReadProfile. The branches are kept by name, so that a branch deleted
+/// after the call does not leave a dangling pointer behind.
+
+Bool_t TTree::IsReadProfileBranch(const TBranch *branch) const
+{
+   return std::find(fReadProfileBranches.begin(), fReadProfileBranches.end(), branch->GetName()) !=
+          fReadProfileBranches.end();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Describe how the tree will be read, so that it is written in the way that
+/// suits the readers best.
+///
+///  - branches: comma separated list of the branches read together; wildcards
+///    are allowed and a top level branch stands for all its sub-branches.
+///    The baskets of these branches are written first and next to each other
+///    in every cluster, so that a TTreeCache restricted to them reads one
+///    contiguous block per cluster. OptimizeBaskets gives them baskets large
+///    enough to hold a whole cluster.
+///  - entryRange: typical number of consecutive entries processed by a reader,
+///    e.g. by a task of TTreeProcessorMT. When the cluster size is chosen by the
+///    first automatic flush, the flush is postponed until the number of entries
+///    is a divisor or a multiple of entryRange, so that the cluster boundaries
+///    are aligned with the boundaries of the ranges.
+///  - basketSize: if positive, the largest basket size (in bytes, before
+///    compression) wanted by the readers for the branches read together.
+///
+/// The list of branches can for instance be taken from the branches used by
+/// the TTreeCache of a previous job (see TTreeCache::GetCachedBranches).
+/// It must be set after the branches have been created and before the first
+/// cluster is flushed. With implicit multi-threading, the baskets are written
+/// in the order in which their compression completes and are not co-located.
+///
+/// Returns the number of branches selected, or -1 if a name does not match
+/// any branch. Calling SetReadProfile("") removes the profile.
+
+Int_t TTree::SetReadProfile(const char *branches, Long64_t entryRange, Int_t basketSize)
+{
+   fReadProfileBranches.clear();
+   fReadProfileRange = entryRange > 0 ? entryRange : 0;
+   fReadProfileBasketSize = basketSize > 0 ? basketSize : 0;
+
+   Int_t result = 0;
+   TObjArray *leaves = GetListOfLeaves();
+   Int_t nleaves = leaves->GetEntriesFast();
+   std::unique_ptr<TObjArray> names(TString(branches).Tokenize(","));
+   for (auto obj : *names) {
+      TString name(obj->GetName());
+      name = name.Strip(TString::kBoth);
+      if (name.IsNull())
+         continue;
+      TRegexp re(name, kTRUE);
+      Bool_t found = kFALSE;
+      for (Int_t i = 0; i < nleaves; ++i) {
+         TBranch *branch = ((TLeaf *)leaves->UncheckedAt(i))->GetBranch();
+         TString bname(branch->GetName());
+         TString mname(branch->GetMother()->GetName());
+         if (bname != name && mname != name && bname.Index(re) == kNPOS && mname.Index(re) == kNPOS)
+            continue;
+         found = kTRUE;
+         if (!IsReadProfileBranch(branch))
+            fReadProfileBranches.push_back(branch->GetName());
+      }
+      if (!found) {
+         Error("SetReadProfile", "No branch matches %s", name.Data());
+         result = -1;
+      }
+   }
+   return result < 0 ? result : (Int_t)fReadProfileBranches.size();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// The current TreeIndex is replaced by the new index.
 /// Note that this function does not delete the previous index.
@@ -2,9 +2,12 @@
 #include "ROOT/TIOFeatures.hxx"
 #include "TBasket.h"
 #include "TBranch.h"
+#include "TBufferFile.h"
 #include "TEnum.h"
 #include "TEnumConstant.h"
 #include "TMemFile.h"
+#include "TNamed.h"
+#include "TSystem.h"
 #include "TTree.h"
 
 #include "gtest/gtest.h"
@@ -403,3 +406,100 @@ TEST(TBasket, TestSettingIOBits)
    readEntryOffset = reinterpret_cast<Bool_t *>(reinterpret_cast<char *>(basket2) + offset);
    EXPECT_EQ(*readEntryOffset, kTRUE);
 }
+
+// Read compressed and uncompressed baskets, and a plain key, from a memory-mapped file.
+TEST(TBasket, ReadFromMappedFile)
+{
+   const auto filename = "tbasket_mmap_test.root";
+   {
+      TFile f(filename, "RECREATE");
+      TTree t1("t1", "Compressed tree for testing.");
+      TTree t2("t2", "Uncompressed tree for testing.");
+      Int_t idx;
+      t1.Branch("idx", &idx, "idx/I");
+      t2.Branch("idx", &idx, "idx/I");
+      t2.SetBasketSize("*", 128);
+      t2.GetBranch("idx")->SetCompressionLevel(0);
+      for (idx = 0; idx < gSampleEvents; idx++) {
+         t1.Fill();
+         t2.Fill();
+      }
+      f.Write();
+      f.SetCompressionLevel(0);
+      TNamed named("named", "an uncompressed key");
+      named.Write();
+   }
+
+   TFile f(TString::Format("%s?mmap=yes", filename));
+   ASSERT_FALSE(f.IsZombie());
+#ifndef _WIN32
+   EXPECT_TRUE(f.IsMapped());
+#endif
+   for (auto name : {"t1", "t2"}) {
+      TTree *tree = nullptr;
+      f.GetObject(name, tree);
+      ASSERT_NE(tree, nullptr);
+      Int_t saved_idx;
+      tree->SetBranchAddress("idx", &saved_idx);
+      ASSERT_EQ(tree->GetEntries(), gSampleEvents);
+      for (Int_t idx = 0; idx < tree->GetEntries(); idx++) {
+         tree->GetEntry(idx);
+         EXPECT_EQ(idx, saved_idx);
+      }
+   }
+   TNamed *named = nullptr;
+   f.GetObject("named", named);
+   ASSERT_NE(named, nullptr);
+   EXPECT_STREQ(named->GetTitle(), "an uncompressed key");
+   EXPECT_EQ(f.ReOpen("UPDATE"), 1);
+   f.Close();
+   EXPECT_FALSE(f.IsMapped());
+
+   gSystem->Unlink(filename);
+}
+
+// The bulk IO byte-swaps the baskets in place: the uncompressed baskets of a
+// memory-mapped file must be copied, not modified in the mapping.
+TEST(TBasket, BulkReadFromMappedFile)
+{
+   const auto filename = "tbasket_mmap_bulk_test.root";
+   {
+      TFile f(filename, "RECREATE", "", 0);
+      TTree t("t", "Uncompressed tree for testing.");
+      Int_t idx;
+      t.Branch("idx", &idx, "idx/I");
+      t.SetBasketSize("*", 128);
+      for (idx = 0; idx < gSampleEvents; idx++)
+         t.Fill();
+      f.Write();
+   }
+
+   TFile f(TString::Format("%s?mmap=yes", filename));
+   ASSERT_FALSE(f.IsZombie());
+   TTree *tree = nullptr;
+   f.GetObject("t", tree);
+   ASSERT_NE(tree, nullptr);
+   const Long64_t bytesRead = f.GetBytesRead();
+   auto branch = tree->GetBranch("idx");
+   TBufferFile buf(TBuffer::kWrite, 10000);
+   Int_t saved_idx;
+   tree->SetBranchAddress("idx", &saved_idx);
+   for (Int_t pass = 0; pass < 2; ++pass) {
+      for (Long64_t entry = 0; entry < gSampleEvents;) {
+         auto count = branch->GetBulkRead().GetBulkEntries(entry, buf);
+         ASSERT_LT(0, count);
+         auto values = reinterpret_cast<Int_t *>(buf.GetCurrent());
+         for (Int_t i = 0; i < count; ++i)
+            EXPECT_EQ(entry + i, values[i]);
+         tree->GetEntry(entry);
+         EXPECT_EQ(entry, saved_idx);
+         entry += count;
+      }
+   }
+   // The baskets used in place are accounted as read from the file.
+   EXPECT_LT(bytesRead, f.GetBytesRead());
+   tree->ResetBranchAddresses();
+   f.Close();
+
+   gSystem->Unlink(filename);
+}
@@ -0,0 +1,84 @@
+#include "TMemFile.h"
+#include "TNamed.h"
+#include "TString.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <list>
+#include <vector>
+
+static TString ElementName(Int_t entry, Int_t i)
+{
+   return TString::Format("name_%02d_%02d_with_a_long_tail", entry, i);
+}
+
+// Reading a split collection of pointers hands out the objects of the
+// previous entry again, reset to their default value: the members that are
+// not read do not keep the value of the previous entry.
+template <typename COLL>
+static void CheckElementsAreReused()
+{
+   TMemFile file("tbranchelement_recycle.root", "RECREATE");
+   {
+      TTree tree("t", "t");
+      COLL coll;
+      tree.Branch("coll", &coll, 32000, 199);
+      for (Int_t e = 0; e < 3; ++e) {
+         for (auto named : coll)
+            delete named;
+         coll.clear();
+         for (Int_t i = 0; i < 4 - e; ++i)
+            coll.push_back(new TNamed(ElementName(e, i).Data(), "title"));
+         tree.Fill();
+      }
+      for (auto named : coll)
+         delete named;
+      tree.Write();
+   }
+
+   TTree *tree = nullptr;
+   file.GetObject("t", tree);
+   ASSERT_NE(nullptr, tree);
+   COLL *coll = nullptr;
+   tree->SetBranchAddress("coll", &coll);
+
+   ASSERT_LT(0, tree->GetEntry(0));
+   ASSERT_NE(nullptr, coll);
+   ASSERT_EQ(4u, coll->size());
+   std::vector<TNamed *> elements(coll->begin(), coll->end());
+   EXPECT_STREQ("title", coll->front()->GetTitle());
+
+   tree->SetBranchStatus("coll.fTitle", 0);
+   for (Int_t e = 1; e < 3; ++e) {
+      ASSERT_LT(0, tree->GetEntry(e));
+      ASSERT_EQ(4u - e, coll->size());
+      std::size_t i = 0;
+      for (auto named : *coll) {
+         EXPECT_EQ(elements[i], named);
+         EXPECT_STREQ(ElementName(e, i).Data(), named->GetName());
+         EXPECT_STREQ("", named->GetTitle());
+         ++i;
+      }
+   }
+
+   // Reading the same entry again gives the same objects and values.
+   ASSERT_LT(0, tree->GetEntry(2));
+   EXPECT_EQ(elements[0], coll->front());
+   EXPECT_STREQ(ElementName(2, 0).Data(), coll->front()->GetName());
+
+   tree->ResetBranchAddresses();
+   for (auto named : *coll)
+      delete named;
+   delete coll;
+}
+
+TEST(TBranchElement, ReuseElementsOfSplitVectorOfPointers)
+{
+   CheckElementsAreReused<std::vector<TNamed *>>();
+}
+
+TEST(TBranchElement, ReuseElementsOfSplitListOfPointers)
+{
+   CheckElementsAreReused<std::list<TNamed *>>();
+}
@@ -0,0 +1,142 @@
+#include "TChain.h"
+#include "TEnv.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "ROOT/RTreeMetadata.hxx"
+
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+class TChainMetadataTest : public ::testing::Test {
+public:
+   static constexpr Int_t kNFiles = 6;
+   static constexpr const char *kCachePath = "chainmetadata.cache";
+
+protected:
+   void SetUp() override
+   {
+      for (Int_t i = 0; i < kNFiles; ++i) {
+         TFile f(FileName(i).c_str(), "RECREATE");
+         TTree t("t", "t");
+         t.SetAutoFlush(10);
+         Int_t x = 0;
+         t.Branch("x", &x);
+         for (Int_t e = 0; e < 25 * (i + 1); ++e) {
+            x = e;
+            t.Fill();
+         }
+         t.Write();
+      }
+      gSystem->Unlink(kCachePath);
+   }
+
+   void TearDown() override
+   {
+      for (Int_t i = 0; i < kNFiles; ++i)
+         gSystem->Unlink(FileName(i).c_str());
+      gSystem->Unlink(kCachePath);
+      gEnv->SetValue("TChain.ParallelOpen", 0);
+      gEnv->SetValue("TChain.MetadataCache", "");
+   }
+
+   static std::string FileName(Int_t i) { return "chainmetadata" + std::to_string(i) + ".root"; }
+
+   static Long64_t ChainEntries()
+   {
+      TChain c("t");
+      for (Int_t i = 0; i < kNFiles; ++i)
+         c.Add(FileName(i).c_str());
+      Long64_t entries = c.GetEntries();
+      // The offsets must be the ones LoadTree would have computed.
+      EXPECT_EQ(c.GetTreeOffset()[kNFiles], entries);
+      Long64_t sum = 0;
+      for (Long64_t e = 0; e < entries; e += 7) {
+         c.GetEntry(e);
+         sum += c.GetTree()->GetReadEntry();
+      }
+      return entries * 1000000 + sum;
+   }
+};
+
+TEST_F(TChainMetadataTest, ParallelOpen)
+{
+   const auto serial = ChainEntries();
+   gEnv->SetValue("TChain.ParallelOpen", 4);
+   EXPECT_EQ(4u, ROOT::Internal::GetTreeMetadataThreads());
+   EXPECT_EQ(serial, ChainEntries());
+}
+
+TEST_F(TChainMetadataTest, Cache)
+{
+   const auto serial = ChainEntries();
+   gEnv->SetValue("TChain.MetadataCache", kCachePath);
+   EXPECT_TRUE(ROOT::Internal::IsTreeMetadataCacheEnabled());
+   EXPECT_EQ(serial, ChainEntries());
+
+   std::ifstream cache(kCachePath);
+   ASSERT_TRUE(cache.good());
+   std::string line;
+   Int_t nrecords = 0;
+   while (std::getline(cache, line)) {
+      if (!line.empty() && line[0] != '#')
+         ++nrecords;
+   }
+   EXPECT_EQ(kNFiles, nrecords);
+
+   // Served from the cache this time.
+   EXPECT_EQ(serial, ChainEntries());
+}
+
+TEST_F(TChainMetadataTest, CacheAfterUpdate)
+{
+   gEnv->SetValue("TChain.MetadataCache", kCachePath);
+   std::vector<ROOT::Internal::RTreeLocation_t> locations{{FileName(0), "t"}};
+   auto metadata = ROOT::Internal::GetTreeMetadata(locations, 1);
+   ASSERT_EQ(1u, metadata.size());
+   EXPECT_EQ(25, metadata[0].fEntries);
+
+   // The UUID of the file is unchanged, the cached record must not be used.
+   {
+      TFile f(FileName(0).c_str(), "UPDATE");
+      TTree *t = nullptr;
+      f.GetObject("t", t);
+      ASSERT_NE(nullptr, t);
+      Int_t x = 0;
+      t->SetBranchAddress("x", &x);
+      for (Int_t e = 0; e < 5; ++e)
+         t->Fill();
+      t->Write("", TObject::kOverwrite);
+   }
+   metadata = ROOT::Internal::GetTreeMetadata(locations, 1);
+   EXPECT_EQ(30, metadata[0].fEntries);
+   EXPECT_EQ(30, metadata[0].fClusters.back());
+
+   // Only the record of the current state of the file is kept.
+   std::ifstream cache(kCachePath);
+   std::string line;
+   Int_t nrecords = 0;
+   while (std::getline(cache, line)) {
+      if (!line.empty() && line[0] != '#')
+         ++nrecords;
+   }
+   EXPECT_EQ(1, nrecords);
+}
+
+TEST_F(TChainMetadataTest, Clusters)
+{
+   std::vector<ROOT::Internal::RTreeLocation_t> locations{
+      {FileName(0), "t"}, {"nonexistent.root", "t"}, {FileName(1), "nonexistent"}};
+   auto metadata = ROOT::Internal::GetTreeMetadata(locations, 2);
+   ASSERT_EQ(3u, metadata.size());
+   EXPECT_EQ(ROOT::Internal::RTreeMetadata::kOk, metadata[0].fStatus);
+   EXPECT_EQ(25, metadata[0].fEntries);
+   const std::vector<Long64_t> expected{0, 10, 20, 25};
+   EXPECT_EQ(expected, metadata[0].fClusters);
+   EXPECT_EQ(ROOT::Internal::RTreeMetadata::kNoFile, metadata[1].fStatus);
+   EXPECT_EQ(ROOT::Internal::RTreeMetadata::kNoTree, metadata[2].fStatus);
+}
@@ -0,0 +1,84 @@
+#include "TEntryList.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+/// Fill an entry list spanning a few blocks with different densities, so that
+/// all the block representations (bits, passing and non-passing lists) are used.
+std::set<Long64_t> FillList(TEntryList &list, unsigned int seed)
+{
+   std::mt19937 gen(seed);
+   std::uniform_real_distribution<> uniform;
+   const double fractions[] = {0.001, 0.3, 0.99, 0.05, 1.};
+   std::set<Long64_t> entries;
+   for (Int_t block = 0; block < 5; ++block) {
+      const auto fraction = fractions[(block + seed) % 5];
+      for (Long64_t e = block * TEntryList::kBlockSize; e < (block + 1) * TEntryList::kBlockSize; ++e) {
+         if (uniform(gen) < fraction) {
+            list.Enter(e);
+            entries.insert(e);
+         }
+      }
+   }
+   list.OptimizeStorage();
+   return entries;
+}
+
+void CheckList(TEntryList &list, const std::set<Long64_t> &expected)
+{
+   ASSERT_EQ((Long64_t)expected.size(), list.GetN());
+   Int_t i = 0;
+   for (auto e : expected)
+      EXPECT_EQ(e, list.GetEntry(i++));
+   for (auto e : {0LL, 12345LL, 64000LL, 150001LL, 319999LL})
+      EXPECT_EQ(expected.count(e) ? 1 : 0, list.Contains(e));
+}
+
+} // anonymous namespace
+
+TEST(TEntryList, SetOperations)
+{
+   TEntryList l1, l2;
+   const auto e1 = FillList(l1, 1);
+   const auto e2 = FillList(l2, 2);
+
+   std::set<Long64_t> expected;
+   std::set_union(e1.begin(), e1.end(), e2.begin(), e2.end(), std::inserter(expected, expected.end()));
+   TEntryList sum(l1);
+   sum.Add(&l2);
+   CheckList(sum, expected);
+
+   expected.clear();
+   std::set_intersection(e1.begin(), e1.end(), e2.begin(), e2.end(), std::inserter(expected, expected.end()));
+   TEntryList intersection(l1);
+   intersection.Intersect(&l2);
+   CheckList(intersection, expected);
+
+   expected.clear();
+   std::set_difference(e1.begin(), e1.end(), e2.begin(), e2.end(), std::inserter(expected, expected.end()));
+   TEntryList difference(l1);
+   difference.Subtract(&l2);
+   CheckList(difference, expected);
+}
+
+TEST(TEntryList, Slice)
+{
+   TEntryList list;
+   const auto entries = FillList(list, 3);
+   for (auto range : std::vector<std::pair<Long64_t, Long64_t>>{
+           {0, 320000}, {10, 20}, {63999, 64001}, {70000, 250000}, {1000, 1000}, {500000, 600000}}) {
+      std::unique_ptr<TEntryList> slice(list.Slice(range.first, range.second));
+      std::set<Long64_t> expected(entries.lower_bound(range.first), entries.lower_bound(range.second));
+      CheckList(*slice, expected);
+   }
+   // Slicing does not change the list.
+   CheckList(list, entries);
+}
@@ -0,0 +1,86 @@
+#include "ROOT/TObjectArena.hxx"
+#include "TBasket.h"
+#include "TBranch.h"
+#include "TClonesArray.h"
+#include "TMemFile.h"
+#include "TNamed.h"
+#include "TObjString.h"
+#include "TString.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+static const Int_t gNEvents = 200;
+
+static void WriteTree(TMemFile &file)
+{
+   TTree tree("t", "t");
+   TClonesArray ca("TNamed");
+   Int_t n;
+   tree.Branch("n", &n, "n/I");
+   tree.Branch("ca", &ca);
+   for (Int_t e = 0; e < gNEvents; ++e) {
+      n = e;
+      ca.Clear();
+      for (Int_t j = 0; j < e % 7; ++j)
+         new (ca[j]) TNamed(TString::Format("%d_%d", e, j).Data(), "");
+      tree.Fill();
+   }
+   tree.Write();
+}
+
+// Objects that ROOT creates while an arena is in use, e.g. baskets and the
+// elements of a TClonesArray, must not be served by the arena: they outlive it.
+TEST(TObjectArena, ReadTreeAndFillClonesArray)
+{
+   TMemFile file("tobjectarena.root", "RECREATE");
+   WriteTree(file);
+
+   TTree *tree = nullptr;
+   file.GetObject("t", tree);
+   ASSERT_NE(nullptr, tree);
+   TClonesArray *read = nullptr;
+   Int_t n;
+   tree->SetBranchAddress("n", &n);
+   tree->SetBranchAddress("ca", &read);
+
+   TClonesArray kept("TNamed");
+   Int_t nkept = 0;
+   for (Int_t e = 0; e < gNEvents; ++e) {
+      ROOT::TObjectArena arena(1024);
+      tree->GetEntry(e);
+      ASSERT_NE(nullptr, read);
+      ASSERT_EQ(e % 7, read->GetEntriesFast());
+
+      auto tmp = new (arena) TObjString(TString::Format("%d", n));
+      EXPECT_TRUE(arena.Contains(tmp));
+      for (Int_t j = 0; j < read->GetEntriesFast(); ++j) {
+         auto named = static_cast<TNamed *>(read->UncheckedAt(j));
+         EXPECT_FALSE(ROOT::TObjectArena::Owns(named));
+         auto copy = new (kept[nkept++]) TNamed(named->GetName(), tmp->GetName());
+         EXPECT_FALSE(ROOT::TObjectArena::Owns(copy));
+      }
+      delete tmp;
+
+      auto basket = tree->GetBranch("n")->GetBasket(0);
+      ASSERT_NE(nullptr, basket);
+      EXPECT_FALSE(ROOT::TObjectArena::Owns(basket));
+   }
+
+   // Everything created by ROOT is still valid once the arenas are gone.
+   Int_t i = 0;
+   for (Int_t e = 0; e < gNEvents; ++e) {
+      for (Int_t j = 0; j < e % 7; ++j, ++i) {
+         auto named = static_cast<TNamed *>(kept.UncheckedAt(i));
+         EXPECT_STREQ(TString::Format("%d_%d", e, j).Data(), named->GetName());
+         EXPECT_STREQ(TString::Format("%d", e).Data(), named->GetTitle());
+      }
+   }
+   EXPECT_EQ(nkept, i);
+   tree->GetEntry(gNEvents - 1);
+   EXPECT_STREQ(TString::Format("%d_0", gNEvents - 1).Data(), read->UncheckedAt(0)->GetName());
+   tree->ResetBranchAddresses();
+   delete read;
+}
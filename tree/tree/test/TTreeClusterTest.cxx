@@ -2,6 +2,7 @@
 #include "TTree.h"
 #include "TBranch.h"
 #include "TRandom.h"
+#include "TSystem.h"
 
 #include "gtest/gtest.h"
 
@@ -53,3 +54,45 @@ TEST_F(TTreeClusterTest, countBaskets)
 
    delete file;
 }
+
+TEST(TTreeCluster, ReadProfile)
+{
+   const char *fname = "TTreeReadProfile.root";
+   {
+      TRandom random(836);
+      TFile file(fname, "RECREATE");
+      TTree tree("tree", "A test tree");
+      tree.SetAutoFlush(-20000);
+      Double_t x = 0, y = 0, z = 0;
+      tree.Branch("x", &x);
+      tree.Branch("y", &y);
+      tree.Branch("z", &z);
+      EXPECT_EQ(2, tree.SetReadProfile("y, z", 300));
+      EXPECT_EQ(-1, tree.SetReadProfile("y,nonexistent", 300));
+      EXPECT_EQ(2, tree.SetReadProfile("[yz]", 300));
+      for (Int_t ev = 0; ev < 5000; ev++) {
+         x = random.Gaus(100, 7);
+         y = random.Gaus(100, 7);
+         z = random.Gaus(100, 7);
+         tree.Fill();
+      }
+      file.Write();
+   }
+
+   {
+      TFile file(fname);
+      auto tree = file.Get<TTree>("tree");
+      ASSERT_NE(nullptr, tree);
+      // The clusters are aligned with the ranges of 300 entries.
+      ASSERT_GT(tree->GetAutoFlush(), 0);
+      EXPECT_EQ(0, tree->GetAutoFlush() % 300);
+
+      // The baskets of y and z are next to each other in every cluster.
+      auto y = tree->GetBranch("y");
+      auto z = tree->GetBranch("z");
+      ASSERT_EQ(y->GetWriteBasket(), z->GetWriteBasket());
+      for (Int_t i = 0; i < y->GetWriteBasket(); ++i)
+         EXPECT_EQ(y->GetBasketSeek(i) + y->GetBasketBytes()[i], z->GetBasketSeek(i));
+   }
+   gSystem->Unlink(fname);
+}
@@ -67,6 +67,8 @@ protected:
    virtual void      InitArrays(Int_t newsize);
 
 private:
+   friend class TTreePlayer; // TTreePlayer::DrawSelectMT fills the buffers from the values of its tasks
+
    TSelectorDraw(const TSelectorDraw&);             // not implemented
    TSelectorDraw& operator=(const TSelectorDraw&);  // not implemented
 
@@ -29,6 +29,7 @@
 
 #include "TObjArray.h"
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -92,6 +93,16 @@ protected:
       Int_t fVirtAccumCache = 0;
    };
 
+   // State of one evaluation of the compiled operator list, see SetJIT.
+   struct JitFrame {
+      TTreeFormula *fFormula;
+      Int_t         fInstance;
+      Bool_t        fWillLoad;
+      Bool_t        fOutOfRange;
+   };
+   typedef Double_t (*JitLoad_t)(void *frame, Int_t code);
+   typedef Double_t (*JitFunc_t)(void *frame, JitLoad_t load);
+
    TTree      *fTree;             //! pointer to Tree
    Int_t       fCodes[kMAXCODES]; //  List of leaf numbers referenced in formula
    Int_t       fNdata[kMAXCODES]; //! This caches the physical number of element in the leaf or data member.
@@ -131,6 +142,11 @@ protected:
 
    RealInstanceCache fRealInstanceCache; //! Cache accelerating the GetRealInstance function
 
+   JitFunc_t   fJitFunc = nullptr;  //! Compiled version of the operator list, see SetJIT
+   Bool_t      fJitTried = kFALSE;  //! True if the compilation of the operator list was attempted
+
+   static std::atomic<Int_t> fgJIT; //! Whether to compile the operator lists (-1: read from gEnv)
+
    TTreeFormula(const char *name, const char *formula, TTree *tree, const std::vector<std::string>& aliases);
    void Init(const char *name, const char *formula);
    Bool_t      BranchHasMethod(TLeaf* leaf, TBranch* branch, const char* method,const char* params, Long64_t readentry) const;
@@ -149,6 +165,11 @@ protected:
    virtual void*     GetValuePointerFromMethod(Int_t i, TLeaf *leaf) const;
    Int_t             GetRealInstance(Int_t instance, Int_t codeindex);
 
+   std::string       GetJitExpression() const;
+   void              PrepareJit();
+   Double_t          EvalJitInstance(Int_t instance);
+   static Double_t   EvalJitVariable(void *frame, Int_t code);
+
    void              LoadBranches();
    Bool_t            LoadCurrentDim();
    void              ResetDimensions();
@@ -198,12 +219,15 @@ public:
    //the mutable keyword.
    //NOTE: Also modify the code in PrintValue which current goes around this limitation :(
    virtual Bool_t      IsInteger(Bool_t fast=kTRUE) const;
+           Bool_t      IsJITCompiled() const { return fJitFunc != nullptr; }
            Bool_t      IsQuickLoad() const { return fQuickLoad; }
+   static  Bool_t      IsJIT();
    virtual Bool_t      IsString() const;
    virtual Bool_t      Notify() { UpdateFormulaLeaves(); return kTRUE; }
    virtual char       *PrintValue(Int_t mode=0) const;
    virtual char       *PrintValue(Int_t mode, Int_t instance, const char *decform = "9.9") const;
    virtual void        SetAxis(TAxis *axis=0);
+   static  void        SetJIT(Bool_t enable);
            void        SetQuickLoad(Bool_t quick) { fQuickLoad = quick; }
    virtual void        SetTree(TTree *tree) {fTree = tree;}
    virtual void        ResetLoading();
@@ -25,6 +25,8 @@
 #include "TVirtualIndex.h"
 #include "TTreeFormula.h"
 
+#include <vector>
+
 class TTreeIndex : public TVirtualIndex {
 
 protected:
@@ -39,6 +41,16 @@ protected:
    TTreeFormula  *fMajorFormulaParent;  //! Pointer to major TreeFormula in Parent tree (if any)
    TTreeFormula  *fMinorFormulaParent;  //! Pointer to minor TreeFormula in Parent tree (if any)
 
+   // A sample of the sorted values, see FindValues.
+   struct LookupNode {
+      Long64_t fMajor;
+      Long64_t fMinor;
+      Long64_t fPos;
+   };
+   std::vector<LookupNode> fLookup;     //! Every kLookupStride-th sorted value, in Eytzinger layout
+
+   void                   BuildLookup();
+
 private:
    TTreeIndex(const TTreeIndex&);            // Not implemented.
    TTreeIndex &operator=(const TTreeIndex&); // Not implemented.
@@ -23,6 +23,9 @@
 
 #include "TVirtualPerfStats.h"
 #include "TString.h"
+#include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -44,6 +47,17 @@ public:
       UInt_t fMissed = {0};     // Number of times the basket was read directly from the file.
    };
 
+   struct BranchInfo {
+      ULong64_t fBaskets = {0};        // Number of baskets read.
+      ULong64_t fBytesRead = {0};      // Number of bytes of these baskets on file.
+      ULong64_t fBytesUnzipped = {0};  // Number of bytes obtained by decompressing them.
+      Double_t  fReadTime = {0};       // Time spent getting the baskets from the caches or the file.
+      Double_t  fUnzipTime = {0};      // Time spent decompressing the baskets.
+      ULong64_t fCacheMisses = {0};    // Number of baskets that were not found in the TTreeCache.
+      ULong64_t fUnzipCacheHits = {0}; // Number of baskets taken already decompressed from the TTreeCacheUnzip.
+      Double_t  fUnzipCacheWait = {0}; // Time spent waiting for the TTreeCacheUnzip.
+   };
+
    using BasketList_t = std::vector<std::pair<TBranch*, std::vector<size_t>>>;
 
 protected:
@@ -73,8 +87,27 @@ protected:
    std::unordered_map<TBranch*, size_t>  fBranchIndexCache; // Cache the index of the branch in the cache's array.
    std::vector<std::vector<BasketInfo> > fBasketsInfo;      // Details on which baskets was used, cached, 'miss-cached' or read uncached.Browse
 
+   struct TraceEvent {
+      const std::string *fBranch;  // Name of the branch, key of fBranchInfo
+      Int_t     fThread;           // Index of the thread, see fThreadInfo
+      Int_t     fNbytes;           // Size of the basket on file
+      Int_t     fObjlen;           // Size of the basket after decompression, 0 if it was not compressed
+      Double_t  fStart;            // When the basket was requested
+      Double_t  fUnzipStart;       // When its decompression started, 0 if it was not decompressed
+      Double_t  fStop;             // When the basket was ready
+      Bool_t    fFromUnzipCache;   // Whether it was decompressed by the TTreeCacheUnzip
+   };
+
+   std::map<std::string, BranchInfo> fBranchInfo;  //!Read and unzip counters per branch
+   std::vector<BranchInfo>   fThreadInfo;          //!Read and unzip counters per thread
+   std::vector<TraceEvent>   fTraceEvents;         //!Every basket read, if fTrace is set
+   Bool_t                    fTrace = {kFALSE};    //!Whether to record fTraceEvents
+   mutable std::mutex        fMutex;               //!Protects the data updated by several threads
+
    BasketInfo &GetBasketInfo(TBranch *b, size_t basketNumber);
    BasketInfo &GetBasketInfo(size_t bi, size_t basketNumber);
+   void        WriteJSON(std::ostream &out) const;
+   void        WriteTraceEvents(std::ostream &out) const;
 
 public:
    TTreePerfStats();
@@ -102,6 +135,9 @@ public:
    TStopwatch      *GetStopwatch() const {return fWatch;}
    virtual Int_t    GetTreeCacheSize() const {return fTreeCacheSize;}
    virtual Double_t GetUnzipTime() const {return fUnzipTime; }
+   BranchInfo       GetBranchInfo(const char *branchname) const;
+   std::map<Int_t, BranchInfo> GetThreadInfo() const;
+   Bool_t           GetTraceEvents() const { return fTrace; }
    virtual void     Paint(Option_t *chopt="");
    virtual void     Print(Option_t *option="") const;
 
@@ -112,6 +148,8 @@ public:
    virtual void     FileOpenEvent(TFile *, const char *, Double_t) {}
    virtual void     FileReadEvent(TFile *file, Int_t len, Double_t start);
    virtual void     UnzipEvent(TObject *tree, Long64_t pos, Double_t start, Int_t complen, Int_t objlen);
+   virtual void     BasketReadEvent(TBranch *branch, Int_t nbytes, Int_t objlen, Double_t start, Double_t unzipStart,
+                                    Bool_t fromUnzipCache);
    virtual void     RateEvent(Double_t , Double_t , Long64_t , Long64_t) {}
 
    virtual void     SaveAs(const char *filename="",Option_t *option="") const;
@@ -131,18 +169,19 @@ public:
    virtual void     SetReadCalls(Int_t ncalls) {fReadCalls = ncalls;}
    virtual void     SetRealNorm(Double_t rnorm) {fRealNorm = rnorm;}
    virtual void     SetRealTime(Double_t rtime) {fRealTime = rtime;}
+   virtual void     SetTraceEvents(Bool_t trace = kTRUE) { fTrace = trace; }
    virtual void     SetTreeCacheSize(Int_t nbytes) {fTreeCacheSize = nbytes;}
    virtual void     SetUnzipTime(Double_t uztime) {fUnzipTime = uztime;}
 
    virtual void     PrintBasketInfo(Option_t *option = "") const;
-   virtual void     SetLoaded(TBranch *b, size_t basketNumber) { ++GetBasketInfo(b, basketNumber).fLoaded; }
-   virtual void     SetLoaded(size_t bi, size_t basketNumber) { ++GetBasketInfo(bi, basketNumber).fLoaded; }
-   virtual void     SetLoadedMiss(TBranch *b, size_t basketNumber) { ++GetBasketInfo(b, basketNumber).fLoadedMiss; }
-   virtual void     SetLoadedMiss(size_t bi, size_t basketNumber) { ++GetBasketInfo(bi, basketNumber).fLoadedMiss; }
-   virtual void     SetMissed(TBranch *b, size_t basketNumber) { ++GetBasketInfo(b, basketNumber).fMissed; }
-   virtual void     SetMissed(size_t bi, size_t basketNumber) { ++GetBasketInfo(bi, basketNumber).fMissed; }
-   virtual void     SetUsed(TBranch *b, size_t basketNumber) { ++GetBasketInfo(b, basketNumber).fUsed; }
-   virtual void     SetUsed(size_t bi, size_t basketNumber) { ++GetBasketInfo(bi, basketNumber).fUsed; }
+   virtual void     SetLoaded(TBranch *b, size_t basketNumber) { std::lock_guard<std::mutex> lock(fMutex); ++GetBasketInfo(b, basketNumber).fLoaded; }
+   virtual void     SetLoaded(size_t bi, size_t basketNumber) { std::lock_guard<std::mutex> lock(fMutex); ++GetBasketInfo(bi, basketNumber).fLoaded; }
+   virtual void     SetLoadedMiss(TBranch *b, size_t basketNumber) { std::lock_guard<std::mutex> lock(fMutex); ++GetBasketInfo(b, basketNumber).fLoadedMiss; }
+   virtual void     SetLoadedMiss(size_t bi, size_t basketNumber) { std::lock_guard<std::mutex> lock(fMutex); ++GetBasketInfo(bi, basketNumber).fLoadedMiss; }
+   virtual void     SetMissed(TBranch *b, size_t basketNumber);
+   virtual void     SetMissed(size_t bi, size_t basketNumber);
+   virtual void     SetUsed(TBranch *b, size_t basketNumber) { std::lock_guard<std::mutex> lock(fMutex); ++GetBasketInfo(b, basketNumber).fUsed; }
+   virtual void     SetUsed(size_t bi, size_t basketNumber) { std::lock_guard<std::mutex> lock(fMutex); ++GetBasketInfo(bi, basketNumber).fUsed; }
    virtual void     UpdateBranchIndices(TObjArray *branchNames);
 
    BasketList_t     GetDuplicateBasketCache() const;
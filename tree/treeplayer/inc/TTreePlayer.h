@@ -59,6 +59,7 @@ protected:
    void           TakeAction(Int_t nfill, Int_t &npoints, Int_t &action, TObject *obj, Option_t *option);
    void           TakeEstimate(Int_t nfill, Int_t &npoints, Int_t action, TObject *obj, Option_t *option);
    void           DeleteSelectorFromFile();
+   Bool_t         DrawSelectMT(const char *varexp, const char *selection, Option_t *option, Long64_t nentries, Long64_t firstentry, Long64_t &nrows);
 
 public:
    TTreePlayer();
@@ -17,6 +17,7 @@
 
 #include "TTreeReaderValue.h"
 #include "TTreeReaderUtils.h"
+#include <ROOT/RSpan.hxx>
 #include <type_traits>
 
 namespace ROOT {
@@ -34,6 +35,9 @@ Base class of TTreeReaderArray.
 
       std::size_t GetSize() const { return fImpl->GetSize(GetProxy()); }
       Bool_t IsEmpty() const { return !GetSize(); }
+      /// Whether the elements are laid out contiguously in memory and can be accessed
+      /// as a whole, e.g. through TTreeReaderArray::AsSpan(), without being copied.
+      bool IsContiguous() const { return fImpl && fImpl->IsContiguous(GetProxy()); }
 
       virtual EReadStatus GetReadStatus() const { return fImpl ? fImpl->fReadStatus : kReadError; }
 
@@ -214,6 +218,14 @@ public:
    const_iterator cbegin() const { return const_iterator(0u, this); }
    const_iterator cend() const { return const_iterator(GetSize(), this); }
 
+   /// Return a view on the elements of the current entry, in the memory they were read into.
+   /// Only meaningful if IsContiguous(); the view is invalidated by loading another entry.
+   std::span<T> AsSpan()
+   {
+      const auto size = GetSize();
+      return size ? std::span<T>(&At(0), size) : std::span<T>();
+   }
+
 protected:
 #define R__TTreeReaderArray_TypeString(T) #T
    virtual const char *GetDerivedTypeName() const { return R__TTreeReaderArray_TypeString(T); }
@@ -74,6 +74,8 @@ namespace Internal {
       virtual ~TVirtualCollectionReader();
       virtual size_t GetSize(Detail::TBranchProxy*) = 0;
       virtual void* At(Detail::TBranchProxy*, size_t /*idx*/) = 0;
+      /// Whether At(idx) is At(0) plus idx elements, i.e. the elements are stored next to each other.
+      virtual bool IsContiguous(Detail::TBranchProxy*) { return false; }
    };
 
 }
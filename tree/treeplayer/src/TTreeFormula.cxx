@@ -45,6 +45,8 @@
 #include "TFormLeafInfoReference.h"
 
 #include "TEntryList.h"
+#include "TEnv.h"
+#include "TVirtualMutex.h"
 
 #include <ctype.h>
 #include <stdio.h>
@@ -52,6 +54,8 @@
 #include <stdlib.h>
 #include <typeinfo>
 #include <algorithm>
+#include <type_traits>
+#include <unordered_map>
 
 const Int_t kMaxLen     = 1024;
 
@@ -91,6 +95,9 @@ The following method are available from the TFormLeafInfo interface:
  -  IsString()
  -  ReadValue(char *where, Int_t instance = 0) : Internal function to interpret the location 'where'
  -  Update() : react to the possible loading of a shared library.
+
+The operator list of the formula can be compiled to native code instead of
+being interpreted for every entry, see TTreeFormula::SetJIT.
 */
 
 ClassImp(TTreeFormula);
@@ -3999,6 +4006,11 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
       }
    }
 
+   if (std::is_same<T, Double_t>::value && IsJIT()) {
+      if (!fJitTried) PrepareJit();
+      if (fJitFunc) return EvalJitInstance(instance);
+   }
+
    T tab[kMAXFOUND];
    const Int_t kMAXSTRINGFOUND = 10;
    const char *stringStackLocal[kMAXSTRINGFOUND];
@@ -4405,6 +4417,290 @@ template double TTreeFormula::EvalInstance<double> (int, char const**);
 template long double TTreeFormula::EvalInstance<long double> (int, char const**);
 template long long TTreeFormula::EvalInstance<long long> (int, char const**);
 
+std::atomic<Int_t> TTreeFormula::fgJIT{-1};
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Helper functions of the compiled formulas, reproducing the handling of the
+/// indeterminations done by TTreeFormula::EvalInstance.
+
+const char *gJitPrelude = R"CODE(
+#include "TMath.h"
+#include <algorithm>
+#include <cmath>
+namespace R__TTreeFormulaJit {
+inline double Bool(bool b) { return b ? 1 : 0; }
+inline double Div(double a, double b) { return b == 0 ? 0 : a / b; }
+inline double Mod(double a, double b) { return double(Long64_t(a) % Long64_t(b)); }
+inline double Tan(double x) { return TMath::Cos(x) == 0 ? 0 : TMath::Tan(x); }
+inline double ACos(double x) { return TMath::Abs(x) > 1 ? 0 : TMath::ACos(x); }
+inline double ASin(double x) { return TMath::Abs(x) > 1 ? 0 : TMath::ASin(x); }
+inline double TanH(double x) { return TMath::CosH(x) == 0 ? 0 : TMath::TanH(x); }
+inline double ACosH(double x) { return x < 1 ? 0 : TMath::ACosH(x); }
+inline double ATanH(double x) { return TMath::Abs(x) > 1 ? 0 : TMath::ATanH(x); }
+inline double Sq(double x) { return x * x; }
+inline double Sqrt(double x) { return TMath::Sqrt(TMath::Abs(x)); }
+inline double Log(double x) { return x > 0 ? TMath::Log(x) : 0; }
+inline double Log10(double x) { return x > 0 ? TMath::Log10(x) : 0; }
+inline double Exp(double x) { return x < -700 ? 0 : TMath::Exp(x > 700 ? 700 : x); }
+inline double Sign(double x) { return x < 0 ? -1 : 1; }
+inline double Int(double x) { return double(Long64_t(x)); }
+inline double BitAnd(double a, double b) { return ULong64_t(a) & ULong64_t(b); }
+inline double BitOr(double a, double b) { return ULong64_t(a) | ULong64_t(b); }
+inline double LeftShift(double a, double b) { return ULong64_t(a) << ULong64_t(b); }
+inline double RightShift(double a, double b) { return ULong64_t(a) >> ULong64_t(b); }
+}
+)CODE";
+
+/// Compiled functions, indexed by their body, shared by all the formulas.
+std::unordered_map<std::string, void *> gJitFunctions;
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the operator lists of the formulas are compiled to native
+/// code. By default, this is taken from the rootrc setting `TTreeFormula.JIT`.
+
+Bool_t TTreeFormula::IsJIT()
+{
+   Int_t jit = fgJIT;
+   if (jit < 0) {
+      // Do not override a concurrent SetJIT.
+      fgJIT.compare_exchange_strong(jit, gEnv->GetValue("TTreeFormula.JIT", 0) ? 1 : 0);
+      jit = fgJIT;
+   }
+   return jit;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the compilation of the formulas to native code.
+///
+/// When enabled, the operator list of a formula is translated into a C++
+/// function, compiled by the interpreter the first time the formula is
+/// evaluated, and called instead of walking the operator list for every
+/// instance of every entry. This speeds up TTree::Draw, TTree::Scan,
+/// TTree::CopyTree and the creation of entry lists from a selection when
+/// the expressions are made of several operations. The values of the
+/// variables are still read by the TTreeFormula (loading of the branches,
+/// array instances, TFormLeafInfo) and the result is identical to the
+/// interpreted evaluation. Formulas using strings, aliases, external cuts,
+/// function calls, ternary operators or the special functions (Sum$, Min$,
+/// Alt$, ...) are always interpreted; IsJITCompiled tells, once a formula
+/// was evaluated, whether its compiled version is used.
+///
+/// The compiled functions are shared by all the formulas with the same
+/// operator list, so a given expression is compiled once per process.
+
+void TTreeFormula::SetJIT(Bool_t enable)
+{
+   fgJIT = enable ? 1 : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the operator list into a C++ expression of the variable
+/// loader `v(f, code)`. Return an empty string if the formula uses an
+/// operation which cannot be compiled.
+
+std::string TTreeFormula::GetJitExpression() const
+{
+   std::vector<std::string> stack;
+   auto unary = [&stack](const char *func) {
+      if (stack.empty()) return kFALSE;
+      stack.back() = std::string(func) + "(" + stack.back() + ")";
+      return kTRUE;
+   };
+   auto binary = [&stack](const char *prefix, const char *infix, const char *suffix) {
+      if (stack.size() < 2) return kFALSE;
+      std::string right = std::move(stack.back());
+      stack.pop_back();
+      stack.back() = prefix + stack.back() + infix + right + suffix;
+      return kTRUE;
+   };
+   auto function = [&binary](const char *func) {
+      return binary((std::string(func) + "(").c_str(), ", ", ")");
+   };
+
+   for (Int_t i = 0; i < fNoper; ++i) {
+      const Int_t action = GetAction(i);
+      const Int_t param = GetActionParam(i);
+      Bool_t ok = kTRUE;
+      switch (action) {
+         case kEnd: i = fNoper; break;
+         // The short-circuit of && and || is the one of C++.
+         case kBoolOptimize: break;
+         case kConstant: {
+            if (!TMath::Finite(fConst[param])) return "";
+            stack.push_back(Form("double(%.17g)", fConst[param]));
+            break;
+         }
+         case kDefinedVariable: {
+            switch (fLookupType[param]) {
+               case kDirect: case kDataMember: case kMethod: case kTreeMember:
+               case kIndexOfEntry: case kIndexOfLocalEntry: case kEntries: case kLocalEntries:
+               case kLength: case kIteration:
+                  stack.push_back("v(f, " + std::to_string(param) + ")");
+                  break;
+               default: return "";
+            }
+            break;
+         }
+         case kpi:      stack.push_back("TMath::ACos(-1.)"); break;
+         case kAdd:        ok = binary("(", " + ", ")"); break;
+         case kSubstract:  ok = binary("(", " - ", ")"); break;
+         case kMultiply:   ok = binary("(", " * ", ")"); break;
+         case kDivide:     ok = function("R__TTreeFormulaJit::Div"); break;
+         case kModulo:     ok = function("R__TTreeFormulaJit::Mod"); break;
+         case kcos:        ok = unary("TMath::Cos"); break;
+         case ksin:        ok = unary("TMath::Sin"); break;
+         case ktan:        ok = unary("R__TTreeFormulaJit::Tan"); break;
+         case kacos:       ok = unary("R__TTreeFormulaJit::ACos"); break;
+         case kasin:       ok = unary("R__TTreeFormulaJit::ASin"); break;
+         case katan:       ok = unary("TMath::ATan"); break;
+         case kcosh:       ok = unary("TMath::CosH"); break;
+         case ksinh:       ok = unary("TMath::SinH"); break;
+         case ktanh:       ok = unary("R__TTreeFormulaJit::TanH"); break;
+         case kacosh:      ok = unary("R__TTreeFormulaJit::ACosH"); break;
+         case kasinh:      ok = unary("TMath::ASinH"); break;
+         case katanh:      ok = unary("R__TTreeFormulaJit::ATanH"); break;
+         case katan2:      ok = function("TMath::ATan2"); break;
+         case kfmod:       ok = function("fmod"); break;
+         case kpow:        ok = function("TMath::Power"); break;
+         case ksq:         ok = unary("R__TTreeFormulaJit::Sq"); break;
+         case ksqrt:       ok = unary("R__TTreeFormulaJit::Sqrt"); break;
+         case kmin:        ok = function("std::min<double>"); break;
+         case kmax:        ok = function("std::max<double>"); break;
+         case klog:        ok = unary("R__TTreeFormulaJit::Log"); break;
+         case kexp:        ok = unary("R__TTreeFormulaJit::Exp"); break;
+         case klog10:      ok = unary("R__TTreeFormulaJit::Log10"); break;
+         case kabs:        ok = unary("TMath::Abs"); break;
+         case ksign:       ok = unary("R__TTreeFormulaJit::Sign"); break;
+         case kint:        ok = unary("R__TTreeFormulaJit::Int"); break;
+         case kSignInv:    ok = unary("-1 * "); break;
+         case kAnd:        ok = binary("R__TTreeFormulaJit::Bool((", ") != 0 && (", ") != 0)"); break;
+         case kOr:         ok = binary("R__TTreeFormulaJit::Bool((", ") != 0 || (", ") != 0)"); break;
+         case kEqual:      ok = binary("R__TTreeFormulaJit::Bool(", " == ", ")"); break;
+         case kNotEqual:   ok = binary("R__TTreeFormulaJit::Bool(", " != ", ")"); break;
+         case kLess:       ok = binary("R__TTreeFormulaJit::Bool(", " < ", ")"); break;
+         case kGreater:    ok = binary("R__TTreeFormulaJit::Bool(", " > ", ")"); break;
+         case kLessThan:   ok = binary("R__TTreeFormulaJit::Bool(", " <= ", ")"); break;
+         case kGreaterThan: ok = binary("R__TTreeFormulaJit::Bool(", " >= ", ")"); break;
+         case kNot:        ok = unary("R__TTreeFormulaJit::Bool(0 == "); if (ok) stack.back() += ")"; break;
+         case kBitAnd:     ok = function("R__TTreeFormulaJit::BitAnd"); break;
+         case kBitOr:      ok = function("R__TTreeFormulaJit::BitOr"); break;
+         case kLeftShift:  ok = function("R__TTreeFormulaJit::LeftShift"); break;
+         case kRightShift: ok = function("R__TTreeFormulaJit::RightShift"); break;
+         default: return "";
+      }
+      if (!ok) return "";
+   }
+   if (stack.size() != 1) return "";
+   return stack.front();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile the operator list, if possible, see SetJIT.
+
+void TTreeFormula::PrepareJit()
+{
+   fJitTried = kTRUE;
+   fJitFunc = nullptr;
+   if (TestBit(kMissingLeaf) || fAxis) return;
+   const std::string expression = GetJitExpression();
+   if (expression.empty()) return;
+
+   R__LOCKGUARD(gInterpreterMutex);
+   auto known = gJitFunctions.find(expression);
+   if (known != gJitFunctions.end()) {
+      fJitFunc = (JitFunc_t)known->second;
+      return;
+   }
+   if (!gInterpreter) return;
+   if (gJitFunctions.empty() && !gInterpreter->Declare(gJitPrelude)) return;
+   const std::string name = "R__TTreeFormulaJit::Eval" + std::to_string(gJitFunctions.size());
+   const std::string code = "namespace R__TTreeFormulaJit { double Eval" + std::to_string(gJitFunctions.size()) +
+                            "(void *f, double (*v)(void *, int)) { return " + expression + "; } }";
+   void *func = nullptr;
+   if (gInterpreter->Declare(code.c_str()))
+      func = (void *)gInterpreter->Calc(("(long)&" + name).c_str());
+   // Remember failures too, not to retry the compilation for every formula.
+   gJitFunctions[expression] = func;
+   fJitFunc = (JitFunc_t)func;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the value of the variable `code` for the compiled evaluation.
+/// This does the same as the kDefinedVariable case of EvalInstance.
+
+Double_t TTreeFormula::EvalJitVariable(void *frameptr, Int_t code)
+{
+   JitFrame &frame = *(JitFrame *)frameptr;
+   if (frame.fOutOfRange) return 0;
+   TTreeFormula *self = frame.fFormula;
+   const Int_t instance = frame.fInstance;
+
+   switch (self->fLookupType[code]) {
+      case kIndexOfEntry:      return self->fTree->GetReadEntry();
+      case kIndexOfLocalEntry: return self->fTree->GetTree()->GetReadEntry();
+      case kEntries:           return self->fTree->GetEntries();
+      case kLocalEntries:      return self->fTree->GetTree()->GetEntries();
+      case kLength:            return self->fManager->fNdata;
+      case kIteration:         return instance;
+      case kTreeMember: {
+         const Int_t real_instance = self->GetRealInstance(instance,code);
+         if (real_instance >= self->fNdata[code]) {
+            frame.fOutOfRange = kTRUE;
+            return 0;
+         }
+         return ((TFormLeafInfo*)self->fDataMembers.UncheckedAt(code))->GetTypedValue<Double_t>((TLeaf*)0x0,real_instance);
+      }
+   }
+
+   TLeaf *leaf = (TLeaf*)self->fLeaves.UncheckedAt(code);
+   const Int_t real_instance = self->GetRealInstance(instance,code);
+   if (frame.fWillLoad) {
+      TBranch *branch = (TBranch*)self->fBranches.UncheckedAt(code);
+      if (branch) {
+         R__LoadBranch(branch,branch->GetTree()->GetReadEntry(),self->fQuickLoad);
+      } else {
+         branch = leaf->GetBranch();
+         Long64_t treeEntry = branch->GetTree()->GetReadEntry();
+         if (branch->GetReadEntry() != treeEntry) branch->GetEntry(treeEntry);
+      }
+   } else {
+      TBranch *br = leaf->GetBranch();
+      Long64_t treeEntry = br->GetTree()->GetReadEntry();
+      if (br->GetReadEntry() != treeEntry) br->GetEntry(treeEntry);
+   }
+   if (real_instance >= self->fNdata[code]) {
+      frame.fOutOfRange = kTRUE;
+      return 0;
+   }
+   switch (self->fLookupType[code]) {
+      case kDirect:     return leaf->GetTypedValue<Double_t>(real_instance);
+      case kMethod:     return self->GetValueFromMethod(code,leaf);
+      case kDataMember: return ((TFormLeafInfo*)self->fDataMembers.UncheckedAt(code))->GetTypedValue<Double_t>(leaf,real_instance);
+   }
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the compiled operator list for the given instance.
+///
+/// Since the short-circuit of the boolean operators may skip the loading of
+/// some branches, the variables are always loaded as if a boolean
+/// optimization happened (see TT_EVAL_INIT_LOOP), which only costs a
+/// comparison of entry numbers.
+
+Double_t TTreeFormula::EvalJitInstance(Int_t instance)
+{
+   JitFrame frame{this, instance, instance==0 || fNeedLoading, kFALSE};
+   fNeedLoading = kFALSE;
+   if (frame.fWillLoad) fDidBooleanOptimization = kTRUE;
+   const Double_t result = fJitFunc(&frame, &TTreeFormula::EvalJitVariable);
+   return frame.fOutOfRange ? 0 : result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return DataMember corresponding to code.
 ///
@@ -5066,6 +5362,9 @@ void TTreeFormula::UpdateFormulaLeaves()
 {
    Int_t nleaves = fLeafNames.GetEntriesFast();
    ResetBit( kMissingLeaf );
+   // The lookup of the leaves may change, check again whether we can be compiled.
+   fJitTried = kFALSE;
+   fJitFunc = nullptr;
    for (Int_t i=0;i<nleaves;i++) {
       if (!fTree) break;
       if (!fLeafNames[i]) continue;
@@ -15,30 +15,145 @@ A Tree Index with majorname and minorname.
 
 #include "TTreeIndex.h"
 #include "TTree.h"
+#include "TChain.h"
+#include "TFile.h"
 #include "TMath.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
 
 ClassImp(TTreeIndex);
 
+namespace {
 
-struct IndexSortComparator {
+/// Number of sorted values per node of TTreeIndex::fLookup.
+constexpr Long64_t kLookupStride = 16;
 
-  IndexSortComparator(Long64_t *major, Long64_t *minor)
-        : fValMajor(major), fValMinor(minor)
-  {}
+/// One entry of the index during its construction.
+struct IndexEntry {
+   Long64_t fMajor;
+   Long64_t fMinor;
+   Long64_t fEntry;
 
-   template<typename Index>
-   bool operator()(Index i1, Index i2) {
-      if( *(fValMajor + i1) == *(fValMajor + i2) )
-         return *(fValMinor + i1) < *(fValMinor + i2);
-      else
-         return *(fValMajor + i1) < *(fValMajor + i2);
+   // Ties are broken by the entry number to make the index deterministic.
+   bool operator<(const IndexEntry &other) const
+   {
+      if (fMajor != other.fMajor) return fMajor < other.fMajor;
+      if (fMinor != other.fMinor) return fMinor < other.fMinor;
+      return fEntry < other.fEntry;
    }
-
-  // pointers to the start of index values tables keeping uppder 64bit and lower 64bit
-  // of combined indexed 128bit value
-  Long64_t *fValMajor, *fValMinor;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the major and minor formulas of all the entries of tree using the
+/// implicit multi-threading pool. Every task reads a range of clusters with
+/// its own instance of the tree, so this is only done for a tree read from a
+/// file. Return false if the values have to be computed sequentially.
+
+Bool_t R__FillIndexEntriesMT(TTree *tree, const TString &majorname, const TString &minorname,
+                             std::vector<IndexEntry> &entries)
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled() || !tree->GetImplicitMT()) return kFALSE;
+   if (tree->InheritsFrom(TChain::Class())) return kFALSE;
+   if (tree->GetListOfFriends() && tree->GetListOfFriends()->GetSize()) return kFALSE;
+   TFile *file = tree->GetCurrentFile();
+   TDirectory *dir = tree->GetDirectory();
+   if (!file || !dir || file->IsWritable() || file->InheritsFrom("TMemFile")) return kFALSE;
+
+   const Long64_t nentries = entries.size();
+   std::vector<std::pair<Long64_t, Long64_t>> clusters;
+   auto clusterIter = tree->GetClusterIterator(0);
+   Long64_t start;
+   while ((start = clusterIter()) < nentries) {
+      clusters.emplace_back(start, std::min(clusterIter.GetNextEntry(), nentries));
+   }
+   if (clusters.size() < 2) return kFALSE;
+
+   const std::size_t nchunks = std::min<std::size_t>(clusters.size(), 4 * ROOT::GetImplicitMTPoolSize());
+   TString treePath = tree->GetName();
+   if (dir != file) {
+      TString dirPath = dir->GetPath();
+      treePath = TString(dirPath(dirPath.Index(":/")+2, dirPath.Length())) + "/" + treePath;
+   }
+   // The full URL keeps the protocol and the options the file was opened with.
+   const TString url = file->GetEndpointUrl()->GetUrl();
+   TList *aliases = tree->GetListOfAliases();
+
+   std::atomic<bool> ok(true);
+   auto fillChunk = [&](UInt_t i) {
+      TDirectory::TContext ctxt;
+      std::unique_ptr<TFile> f(TFile::Open(url));
+      TTree *t = f && !f->IsZombie() ? dynamic_cast<TTree*>(f->Get(treePath)) : nullptr;
+      if (!t) { ok = false; return; }
+      t->SetImplicitMT(kFALSE);
+      if (aliases) {
+         for (TObject *alias : *aliases) t->SetAlias(alias->GetName(), alias->GetTitle());
+      }
+      TTreeFormula major("Major", majorname.Data(), t);
+      TTreeFormula minor("Minor", minorname.Data(), t);
+      if (major.GetNdim() != 1 || minor.GetNdim() != 1) { ok = false; return; }
+      major.SetQuickLoad(kTRUE);
+      minor.SetQuickLoad(kTRUE);
+      const Long64_t first = clusters[i * clusters.size() / nchunks].first;
+      const Long64_t last = clusters[(i + 1) * clusters.size() / nchunks - 1].second;
+      for (Long64_t entry = first; entry < last; ++entry) {
+         if (t->LoadTree(entry) < 0) { ok = false; return; }
+         entries[entry] = {(Long64_t) major.EvalInstance<LongDouble_t>(),
+                           (Long64_t) minor.EvalInstance<LongDouble_t>(), entry};
+      }
+   };
+   ROOT::TThreadExecutor pool;
+   pool.Foreach(fillChunk, ROOT::TSeqU(nchunks));
+   return ok;
+#else
+   (void)tree;
+   (void)majorname;
+   (void)minorname;
+   (void)entries;
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sort the index entries; with implicit multi-threading enabled, large
+/// indices are sorted by a parallel merge sort.
+
+void R__SortIndexEntries(std::vector<IndexEntry> &entries)
+{
+#ifdef R__USE_IMT
+   const std::size_t kMinChunkSize = 1 << 16;
+   const std::size_t nchunks = std::min<std::size_t>(ROOT::GetImplicitMTPoolSize(), entries.size() / kMinChunkSize);
+   if (ROOT::IsImplicitMTEnabled() && nchunks > 1) {
+      std::vector<std::size_t> bounds;
+      for (std::size_t i = 0; i <= nchunks; ++i) bounds.push_back(i * entries.size() / nchunks);
+      auto begin = entries.begin();
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](UInt_t i) { std::sort(begin + bounds[i], begin + bounds[i+1]); }, ROOT::TSeqU(nchunks));
+      // Merge pairs of neighbouring sorted runs until a single one is left.
+      for (std::size_t width = 1; width < nchunks; width *= 2) {
+         const std::size_t npairs = (nchunks + 2 * width - 1) / (2 * width);
+         pool.Foreach([&](UInt_t p) {
+            const std::size_t lo = bounds[2 * p * width];
+            const std::size_t mid = bounds[std::min(2 * p * width + width, nchunks)];
+            const std::size_t hi = bounds[std::min(2 * p * width + 2 * width, nchunks)];
+            if (mid < hi) std::inplace_merge(begin + lo, begin + mid, begin + hi);
+         }, ROOT::TSeqU(npairs));
+      }
+      return;
+   }
+#endif
+   std::sort(entries.begin(), entries.end());
+}
+
+} // anonymous namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor for TTreeIndex
@@ -161,35 +276,34 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    //   return;
    //}
 
-   Long64_t *tmp_major = new Long64_t[fN];
-   Long64_t *tmp_minor = new Long64_t[fN];
-   Long64_t i;
+   std::vector<IndexEntry> entries(fN);
    Long64_t oldEntry = fTree->GetReadEntry();
-   Int_t current = -1;
-   for (i=0;i<fN;i++) {
-      Long64_t centry = fTree->LoadTree(i);
-      if (centry < 0) break;
-      if (fTree->GetTreeNumber() != current) {
-         current = fTree->GetTreeNumber();
-         fMajorFormula->UpdateFormulaLeaves();
-         fMinorFormula->UpdateFormulaLeaves();
+   if (!R__FillIndexEntriesMT(fTree, fMajorName, fMinorName, entries)) {
+      Int_t current = -1;
+      for (Long64_t i=0;i<fN;i++) {
+         Long64_t centry = fTree->LoadTree(i);
+         if (centry < 0) break;
+         if (fTree->GetTreeNumber() != current) {
+            current = fTree->GetTreeNumber();
+            fMajorFormula->UpdateFormulaLeaves();
+            fMinorFormula->UpdateFormulaLeaves();
+         }
+         entries[i].fMajor = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
+         entries[i].fMinor = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
+         entries[i].fEntry = i;
       }
-      tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
-      tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
    }
+   R__SortIndexEntries(entries);
    fIndex = new Long64_t[fN];
-   for(i = 0; i < fN; i++) { fIndex[i] = i; }
-   std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
-   //TMath::Sort(fN,w,fIndex,0);
    fIndexValues = new Long64_t[fN];
    fIndexValuesMinor = new Long64_t[fN];
-   for (i=0;i<fN;i++) {
-      fIndexValues[i] = tmp_major[fIndex[i]];
-      fIndexValuesMinor[i] = tmp_minor[fIndex[i]];
+   for (Long64_t i=0;i<fN;i++) {
+      fIndex[i] = entries[i].fEntry;
+      fIndexValues[i] = entries[i].fMajor;
+      fIndexValuesMinor[i] = entries[i].fMinor;
    }
+   BuildLookup();
 
-   delete [] tmp_major;
-   delete [] tmp_minor;
    fTree->LoadTree(oldEntry);
 }
 
@@ -262,29 +376,19 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
 
    // Sort.
    if (!delaySort) {
-      Long64_t *addValues = GetIndexValues();
-      Long64_t *addValues2 = GetIndexValuesMinor();
-      Long64_t *ind = fIndex;
-      Long64_t *conv = new Long64_t[fN];
-
-      for(Long64_t i = 0; i < fN; i++) { conv[i] = i; }
-      std::sort(conv, conv+fN, IndexSortComparator(addValues, addValues2) );
-      //Long64_t *w = fIndexValues;
-      //TMath::Sort(fN,w,conv,0);
-
-      fIndex = new Long64_t[fN];
-      fIndexValues = new Long64_t[fN];
-      fIndexValuesMinor = new Long64_t[fN];
-
-      for (Int_t i=0;i<fN;i++) {
-         fIndex[i] = ind[conv[i]];
-         fIndexValues[i] = addValues[conv[i]];
-         fIndexValuesMinor[i] = addValues2[conv[i]];
+      std::vector<IndexEntry> entries(fN);
+      for (Long64_t i = 0; i < fN; i++) {
+         entries[i] = {fIndexValues[i], fIndexValuesMinor[i], fIndex[i]};
+      }
+      R__SortIndexEntries(entries);
+      for (Long64_t i = 0; i < fN; i++) {
+         fIndex[i] = entries[i].fEntry;
+         fIndexValues[i] = entries[i].fMajor;
+         fIndexValuesMinor[i] = entries[i].fMinor;
       }
-      delete [] addValues;
-      delete [] addValues2;
-      delete [] ind;
-      delete [] conv;
+      BuildLookup();
+   } else {
+      fLookup.clear();
    }
 }
 
@@ -346,14 +450,61 @@ Long64_t TTreeIndex::GetEntryNumberFriend(const TTree *parent)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Sample every kLookupStride-th sorted value into fLookup, in Eytzinger
+/// layout: the node k has its children at 2k and 2k+1, so that the first
+/// steps of a search hit the same few cache lines for all the lookups and the
+/// following ones are prefetched together.
+
+void TTreeIndex::BuildLookup()
+{
+   fLookup.clear();
+   const Long64_t nsamples = (fN + kLookupStride - 1) / kLookupStride;
+   if (nsamples < 2) return;
+   fLookup.resize(nsamples + 1);
+   // In-order traversal of the implicit tree, node 0 is not used.
+   Long64_t sample = 0;
+   std::vector<Long64_t> stack;
+   Long64_t k = 1;
+   while (k <= nsamples || !stack.empty()) {
+      while (k <= nsamples) {
+         stack.push_back(k);
+         k = 2 * k;
+      }
+      k = stack.back();
+      stack.pop_back();
+      const Long64_t pos = sample++ * kLookupStride;
+      fLookup[k] = {fIndexValues[pos], fIndexValuesMinor[pos], pos};
+      k = 2 * k + 1;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// find position where major|minor values are in the IndexValues tables
 /// this is the index in IndexValues table, not entry# !
 /// use lower_bound STD algorithm.
+///
+/// The search first walks the sampled values of fLookup to find the block
+/// of kLookupStride values holding the position, then bisects the block.
 
 Long64_t TTreeIndex::FindValues(Long64_t major, Long64_t minor) const
 {
    Long64_t mid, step, pos = 0, count = fN;
+   if (!fLookup.empty()) {
+      const Long64_t nsamples = fLookup.size() - 1;
+      Long64_t k = 1;
+      while (k <= nsamples) {
+         const LookupNode &node = fLookup[k];
+         k = 2 * k + (node.fMajor < major || (node.fMajor == major && node.fMinor < minor));
+      }
+      // Undo the right turns and the last left turn: fLookup[k] is the first
+      // sample not lower than major|minor, if any.
+      while (k & 1) k >>= 1;
+      k >>= 1;
+      const Long64_t end = k ? fLookup[k].fPos : fN;
+      pos = k ? std::max<Long64_t>(end - kLookupStride, 0) : (nsamples - 1) * kLookupStride;
+      count = end - pos;
+   }
    // find lower bound using bisection
    while( count > 0 ) {
       step = count / 2;
@@ -560,6 +711,7 @@ void TTreeIndex::Streamer(TBuffer &R__b)
       }
       fIndex      = new Long64_t[fN];
       R__b.ReadFastArray(fIndex,fN);
+      BuildLookup();
       R__b.CheckByteCount(R__s, R__c, TTreeIndex::IsA());
    } else {
       R__c = R__b.WriteVersion(TTreeIndex::IsA(), kTRUE);
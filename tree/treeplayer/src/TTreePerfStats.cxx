@@ -67,6 +67,25 @@ The Draw or Print functions print the following information:
  -  ReadRT    = Zipped MBytes per RT second
  -  ReadCP    = Zipped MBytes per CP second
 
+Print("branch") adds a table of per-branch counters, filled for every basket
+read by the monitored tree (or by the trees of a monitored TChain): bytes
+read and decompressed, time spent reading and decompressing, baskets not
+found in the TTreeCache, and baskets taken from the TTreeCacheUnzip together
+with the time spent waiting for them. The same counters are kept per thread.
+They are updated under a lock, so that a single TTreePerfStats can monitor a
+tree read with implicit multi-threading, or be attached with SetPerfStats to
+the trees read by several threads.
+
+The counters can be exported as JSON, and every basket read can be recorded
+(see SetTraceEvents) and exported in the Chrome trace event format, to be
+inspected with chrome://tracing or Perfetto:
+~~~{.cpp}
+   ps->SetTraceEvents();
+   ...
+   ps->SaveAs("ioperf.json", "counters"); // summary and per-branch, per-thread counters
+   ps->SaveAs("ioperf.trace", "trace");   // one event per basket read and decompression
+~~~
+
  ### NOTE 1 :
 The ReadTotal value indicates the effective number of zipped bytes
 returned to the application. The physical number of bytes read
@@ -97,8 +116,49 @@ The Physical disk speed is DiskIO + DiskIO*ReadExtra/100.
 #include "TDatime.h"
 #include "TMath.h"
 
+#include <atomic>
+#include <fstream>
+
 ClassImp(TTreePerfStats);
 
+namespace {
+
+/// Small index identifying the calling thread in the per-thread counters.
+Int_t R__GetThreadIndex()
+{
+   static std::atomic<Int_t> nthreads(0);
+   thread_local Int_t index = nthreads++;
+   return index;
+}
+
+/// Quote and escape a string for JSON.
+std::string R__JSONString(const std::string &str)
+{
+   std::string out = "\"";
+   for (char c : str) {
+      if (c == '"' || c == '\\') {
+         out += '\\';
+         out += c;
+      } else if ((unsigned char)c < 0x20) {
+         out += TString::Format("\\u%04x", (unsigned int)c).Data();
+      } else {
+         out += c;
+      }
+   }
+   return out + '"';
+}
+
+/// Write the counters of info as JSON members.
+void R__WriteBranchInfo(std::ostream &out, const TTreePerfStats::BranchInfo &info)
+{
+   out << "\"baskets\": " << info.fBaskets << ", \"bytesRead\": " << info.fBytesRead
+       << ", \"bytesUnzipped\": " << info.fBytesUnzipped << ", \"readTime\": " << info.fReadTime
+       << ", \"unzipTime\": " << info.fUnzipTime << ", \"cacheMisses\": " << info.fCacheMisses
+       << ", \"unzipCacheHits\": " << info.fUnzipCacheHits << ", \"unzipCacheWait\": " << info.fUnzipCacheWait;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// default constructor (used when reading an object only)
 
@@ -280,6 +340,7 @@ void TTreePerfStats::ExecuteEvent(Int_t /*event*/, Int_t /*px*/, Int_t /*py*/)
 void TTreePerfStats::FileReadEvent(TFile *file, Int_t len, Double_t start)
 {
    if (file == this->fFile){
+      std::lock_guard<std::mutex> lock(fMutex);
       Long64_t offset = file->GetRelOffset();
       Int_t np = fGraphIO->GetN();
       Int_t entry = fTree->GetReadEntry();
@@ -308,10 +369,96 @@ void TTreePerfStats::UnzipEvent(TObject * tree, Long64_t /* pos */, Double_t sta
    if (tree == this->fTree){
       Double_t tnow = TTimeStamp();
       Double_t dtime = tnow-start;
+      std::lock_guard<std::mutex> lock(fMutex);
       fUnzipTime += dtime;
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Record the read of a basket of branch, see TVirtualPerfStats::BasketReadEvent.
+/// -  nbytes is the size of the basket on file
+/// -  objlen is its decompressed size, 0 if it was not compressed
+/// -  start is the TimeStamp when the basket was requested
+/// -  unzipStart is the TimeStamp before unzip, 0 if it was not unzipped here
+/// -  fromUnzipCache tells whether it was unzipped by the TTreeCacheUnzip
+
+void TTreePerfStats::BasketReadEvent(TBranch *branch, Int_t nbytes, Int_t objlen, Double_t start, Double_t unzipStart,
+                                     Bool_t fromUnzipCache)
+{
+   Double_t stop = TTimeStamp();
+   Int_t thread = R__GetThreadIndex();
+
+   std::lock_guard<std::mutex> lock(fMutex);
+   auto iter = fBranchInfo.emplace(branch->GetName(), BranchInfo()).first;
+   if ((Int_t)fThreadInfo.size() <= thread)
+      fThreadInfo.resize(thread + 1);
+   for (BranchInfo *info : {&iter->second, &fThreadInfo[thread]}) {
+      ++info->fBaskets;
+      info->fBytesRead += nbytes;
+      info->fBytesUnzipped += objlen;
+      if (fromUnzipCache) {
+         ++info->fUnzipCacheHits;
+         info->fUnzipCacheWait += stop - start;
+      } else if (unzipStart > 0) {
+         info->fReadTime += unzipStart - start;
+         info->fUnzipTime += stop - unzipStart;
+      } else {
+         info->fReadTime += stop - start;
+      }
+   }
+   if (fTrace)
+      fTraceEvents.push_back({&iter->first, thread, nbytes, objlen, start, unzipStart, stop, fromUnzipCache});
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the counters of the branch named branchname.
+
+TTreePerfStats::BranchInfo TTreePerfStats::GetBranchInfo(const char *branchname) const
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   auto iter = fBranchInfo.find(branchname);
+   return iter == fBranchInfo.end() ? BranchInfo() : iter->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the counters of each thread that read baskets, by thread index.
+
+std::map<Int_t, TTreePerfStats::BranchInfo> TTreePerfStats::GetThreadInfo() const
+{
+   std::map<Int_t, BranchInfo> result;
+   std::lock_guard<std::mutex> lock(fMutex);
+   for (size_t i = 0; i < fThreadInfo.size(); ++i) {
+      if (fThreadInfo[i].fBaskets)
+         result.emplace(i, fThreadInfo[i]);
+   }
+   return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record that basket basketNumber of b was not found in the TTreeCache.
+
+void TTreePerfStats::SetMissed(TBranch *b, size_t basketNumber)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   ++GetBasketInfo(b, basketNumber).fMissed;
+   ++fBranchInfo[b->GetName()].fCacheMisses;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record that basket basketNumber of the bi-th branch of the TTreeCache was
+/// not found in it.
+
+void TTreePerfStats::SetMissed(size_t bi, size_t basketNumber)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   ++GetBasketInfo(bi, basketNumber).fMissed;
+   TFile *file = fTree ? fTree->GetCurrentFile() : nullptr;
+   TTreeCache *cache = file ? dynamic_cast<TTreeCache *>(file->GetCacheRead(fTree)) : nullptr;
+   if (cache && bi < (size_t)cache->GetCachedBranches()->GetEntriesFast()) {
+      ++fBranchInfo[cache->GetCachedBranches()->UncheckedAt(bi)->GetName()].fCacheMisses;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// When the run is finished this function must be called
 /// to save the current parameters in the file and Tree in this object
@@ -559,6 +706,17 @@ void TTreePerfStats::Print(Option_t * option) const
    }
    if (basket)
       PrintBasketInfo(option);
+   if (opts.Contains("branch")) {
+      std::lock_guard<std::mutex> lock(fMutex);
+      printf("%-30s %8s %10s %10s %9s %9s %8s %8s %9s\n", "Branch", "Baskets", "ReadMB", "UnzipMB", "ReadTime",
+             "UnzipTime", "CacheMiss", "UZCHits", "UZCWait");
+      for (auto &entry : fBranchInfo) {
+         const BranchInfo &info = entry.second;
+         printf("%-30s %8llu %10.3f %10.3f %9.3f %9.3f %8llu %8llu %9.3f\n", entry.first.c_str(), info.fBaskets,
+                1e-6 * info.fBytesRead, 1e-6 * info.fBytesUnzipped, info.fReadTime, info.fUnzipTime, info.fCacheMisses,
+                info.fUnzipCacheHits, info.fUnzipCacheWait);
+      }
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -628,15 +786,103 @@ void TTreePerfStats::PrintBasketInfo(Option_t *option) const
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Save this object to filename
-
-void TTreePerfStats::SaveAs(const char *filename, Option_t * /*option*/) const
+/// Save this object to filename.
+///
+/// With option "trace", the basket reads recorded since SetTraceEvents are
+/// written in the Chrome trace event format. With option "counters", the
+/// totals and the per-branch and per-thread counters are written as JSON.
+/// Otherwise the object is saved by TObject::SaveAs, e.g. as a macro or, if
+/// filename ends with ".json", with TBufferJSON.
+
+void TTreePerfStats::SaveAs(const char *filename, Option_t *option) const
 {
    TTreePerfStats *ps = (TTreePerfStats*)this;
    ps->Finish();
+   TString opt(option);
+   opt.ToLower();
+   if (opt.Contains("trace") || opt.Contains("counters")) {
+      std::ofstream out(filename);
+      if (!out) {
+         Error("SaveAs", "Cannot open %s", filename);
+         return;
+      }
+      if (opt.Contains("trace"))
+         WriteTraceEvents(out);
+      else
+         WriteJSON(out);
+      return;
+   }
    ps->TObject::SaveAs(filename);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write the totals and the per-branch and per-thread counters as JSON.
+
+void TTreePerfStats::WriteJSON(std::ostream &out) const
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   out << "{\n  \"name\": " << R__JSONString(fName.Data()) << ",\n  \"host\": " << R__JSONString(fHostInfo.Data())
+       << ",\n  \"treeCacheSize\": " << fTreeCacheSize << ",\n  \"bytesRead\": " << fBytesRead
+       << ",\n  \"bytesReadExtra\": " << fBytesReadExtra << ",\n  \"readCalls\": " << fReadCalls
+       << ",\n  \"realTime\": " << fRealTime << ",\n  \"cpuTime\": " << fCpuTime << ",\n  \"diskTime\": " << fDiskTime
+       << ",\n  \"unzipTime\": " << fUnzipTime << ",\n  \"branches\": [";
+   const char *sep = "\n";
+   for (auto &entry : fBranchInfo) {
+      out << sep << "    {\"name\": " << R__JSONString(entry.first) << ", ";
+      R__WriteBranchInfo(out, entry.second);
+      out << "}";
+      sep = ",\n";
+   }
+   out << "\n  ],\n  \"threads\": [";
+   sep = "\n";
+   for (size_t i = 0; i < fThreadInfo.size(); ++i) {
+      if (!fThreadInfo[i].fBaskets)
+         continue;
+      out << sep << "    {\"thread\": " << i << ", ";
+      R__WriteBranchInfo(out, fThreadInfo[i]);
+      out << "}";
+      sep = ",\n";
+   }
+   out << "\n  ]\n}\n";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the recorded basket reads (see SetTraceEvents) in the Chrome trace
+/// event format: one complete event per read and per decompression, on the
+/// timeline of the thread that did it, in microseconds from the first read.
+
+void TTreePerfStats::WriteTraceEvents(std::ostream &out) const
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   Double_t origin = 0;
+   for (auto &event : fTraceEvents) {
+      if (origin == 0 || event.fStart < origin)
+         origin = event.fStart;
+   }
+   auto writeEvent = [&](const char *sep, const TraceEvent &event, const char *cat, Double_t begin, Double_t end,
+                         Int_t bytes) {
+      out << sep << "  {\"name\": " << R__JSONString(*event.fBranch) << ", \"cat\": \"" << cat
+          << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << event.fThread
+          << ", \"ts\": " << TString::Format("%.3f", 1e6 * (begin - origin))
+          << ", \"dur\": " << TString::Format("%.3f", 1e6 * (end - begin)) << ", \"args\": {\"bytes\": " << bytes
+          << "}}";
+   };
+   out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+   const char *sep = "\n";
+   for (auto &event : fTraceEvents) {
+      if (event.fFromUnzipCache) {
+         writeEvent(sep, event, "unzipcache", event.fStart, event.fStop, event.fObjlen);
+      } else if (event.fUnzipStart > 0) {
+         writeEvent(sep, event, "read", event.fStart, event.fUnzipStart, event.fNbytes);
+         writeEvent(",\n", event, "unzip", event.fUnzipStart, event.fStop, event.fObjlen);
+      } else {
+         writeEvent(sep, event, "read", event.fStart, event.fStop, event.fNbytes);
+      }
+      sep = ",\n";
+   }
+   out << "\n]}\n";
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Save primitive as a C++ statement(s) on output stream out
 
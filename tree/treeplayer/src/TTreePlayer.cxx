@@ -19,6 +19,11 @@ extra libraries (Histogram, display, etc).
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "Riostream.h"
 #include "TTreePlayer.h"
 #include "TROOT.h"
@@ -77,6 +82,10 @@ extra libraries (Histogram, display, etc).
 #include "TTreeCache.h"
 #include "TStyle.h"
 #include "TVirtualMutex.h"
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 #include "HFitInterface.h"
 #include "Foption.h"
@@ -415,8 +424,10 @@ Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Opt
    // Do not process more than fMaxEntryLoop entries
    if (nentries > fTree->GetMaxEntryLoop()) nentries = fTree->GetMaxEntryLoop();
 
-   // invoke the selector
-   Long64_t nrows = Process(fSelector,option,nentries,firstentry);
+   // invoke the selector, in parallel if possible
+   Long64_t nrows = -1;
+   if (!DrawSelectMT(varexp0,selection,option,nentries,firstentry,nrows))
+      nrows = Process(fSelector,option,nentries,firstentry);
    fSelectedRows = nrows;
    fDimension = fSelector->GetDimension();
 
@@ -535,6 +546,260 @@ Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Opt
    return fSelectedRows;
 }
 
+#ifdef R__USE_IMT
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// A TSelectorDraw that keeps the values of the selected rows instead of
+/// filling its object, see TTreePlayer::DrawSelectMT.
+
+class TSelectorDrawRecorder : public TSelectorDraw {
+private:
+   TList fDrawInput;           ///< The expression and the selection
+   std::vector<Double_t> fRows; ///< fDimension values and the weight of every selected row
+
+public:
+   TSelectorDrawRecorder(const char *varexp, const char *selection)
+   {
+      fDrawInput.SetOwner();
+      fDrawInput.Add(new TNamed("varexp", varexp));
+      fDrawInput.Add(new TNamed("selection", selection));
+      SetInputList(&fDrawInput);
+   }
+
+   void TakeAction() override
+   {
+      for (Int_t i = 0; i < fNfill; ++i) {
+         for (Int_t k = 0; k < fDimension; ++k)
+            fRows.push_back(fVal[k][i]);
+         fRows.push_back(fW[i]);
+      }
+      fSelectedRows += fNfill;
+   }
+
+   std::vector<Double_t> &GetRows() { return fRows; }
+};
+
+/// An instance of the tree used by the tasks of TTreePlayer::DrawSelectMT.
+struct TDrawSlot {
+   std::unique_ptr<TH1> fHist;    ///< Copy of the histogram, booked but not filled by the selector
+   std::unique_ptr<TFile> fFile;  ///< The file of the tree, opened by the first task using the slot
+   TTree *fTree = nullptr;        ///< The tree, owned by fFile
+};
+
+} // anonymous namespace
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process the entries of DrawSelect with the implicit multi-threading pool.
+///
+/// This applies when implicit multi-threading is enabled (see
+/// ROOT::EnableImplicitMT and TTree::SetImplicitMT) and the expression is
+/// projected into an already existing histogram with fixed binning, e.g.
+/// ~~~ {.cpp}
+///    TH1F h("h", "px", 100, -3, 3);
+///    tree->Draw("px>>h", "pz>0");
+/// ~~~
+/// The tree must be read from a file and must not have friends nor event or
+/// entry lists.
+///
+/// The entries are split at cluster boundaries in contiguous ranges; the
+/// tasks read the ranges with their own instances of the tree and evaluate
+/// the expression and the selection. The values of the selected rows are
+/// then given to the selector of this player in entry order, as its entry
+/// loop would, a few ranges at a time. The histogram, GetV1() and friends,
+/// GetW() and GetSelectedRows() are thus exactly the ones of a sequential
+/// processing.
+///
+/// Return kFALSE if the entries have to be processed sequentially, otherwise
+/// set nrows to the number of selected entries, or to -1 in case of error,
+/// the histogram being then left as booked by the selector.
+
+Bool_t TTreePlayer::DrawSelectMT(const char *varexp0, const char *selection, Option_t *option, Long64_t nentries, Long64_t firstentry, Long64_t &nrows)
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled() || !fTree->GetImplicitMT()) return kFALSE;
+   if (fTree->InheritsFrom(TChain::Class())) return kFALSE;
+   if (fTree->GetEventList() || fTree->GetEntryList()) return kFALSE;
+   if (fTree->GetListOfFriends() && fTree->GetListOfFriends()->GetSize()) return kFALSE;
+   TFile *file = fTree->GetCurrentFile();
+   TDirectory *dir = fTree->GetDirectory();
+   if (!file || !dir || file->IsWritable() || file->InheritsFrom("TMemFile")) return kFALSE;
+
+   nentries = GetEntriesToProcess(firstentry, nentries);
+   if (firstentry < 0 || nentries <= 0) return kFALSE;
+
+   // Only an existing histogram is booked the same way by the tasks.
+   TString varexp = varexp0;
+   Ssiz_t hpos = varexp.Index(">>");
+   if (hpos == kNPOS) return kFALSE;
+   TString hname = varexp(hpos+2, varexp.Length()-hpos-2);
+   hname = hname.Strip(TString::kBoth);
+   if (hname.BeginsWith("+")) {
+      hname.Remove(0, 1);
+      hname = hname.Strip(TString::kBoth);
+   }
+   if (hname.IsNull() || hname.Contains("(")) return kFALSE;
+   TH1 *hist = dynamic_cast<TH1*>(gDirectory->Get(hname));
+   if (!hist || hist->GetBuffer()) return kFALSE;
+   for (TAxis *axis : {hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()}) {
+      if (axis->CanExtend() || axis->IsAlphanumeric()) return kFALSE;
+   }
+
+   // Ranges of whole clusters; the values of a wave of ranges are kept in memory.
+   const UInt_t nslots = ROOT::GetImplicitMTPoolSize();
+   const Long64_t kMaxRangeEntries = 1 << 20;
+   const Long64_t rangeEntries = std::min(nentries / (4 * nslots) + 1, kMaxRangeEntries);
+   const Long64_t lastentry = firstentry + nentries;
+   std::vector<std::pair<Long64_t, Long64_t>> ranges;
+   auto clusterIter = fTree->GetClusterIterator(firstentry);
+   Long64_t start;
+   while ((start = clusterIter()) < lastentry) {
+      const Long64_t end = std::min(clusterIter.GetNextEntry(), lastentry);
+      if (!ranges.empty() && ranges.back().second - ranges.back().first < rangeEntries)
+         ranges.back().second = end;
+      else
+         ranges.emplace_back(std::max(start, firstentry), end);
+   }
+   if (ranges.size() < 2) return kFALSE;
+
+   // Prepare the selector as the entry loop of Process would, which books
+   // (and resets, unless requested otherwise) the histogram.
+   fTree->SetNotify(fSelector);
+   fSelector->SetOption(option);
+   fSelector->Begin(fTree);
+   fSelector->SlaveBegin(fTree);
+   fSelector->Notify();
+   if (fSelector->GetAbort() == TSelector::kAbortProcess || fSelector->GetStatus() == -1) {
+      fTree->SetNotify(0);
+      nrows = -1;
+      return kTRUE;
+   }
+   const Int_t action = fSelector->GetAction();
+   const Int_t dimension = fSelector->GetDimension();
+   if (fSelector->GetObject() != hist || dimension <= 0 ||
+       (action != 1 && action != 2 && action != 3 && action != 4 && action != 23)) {
+      fTree->SetNotify(0);
+      return kFALSE;
+   }
+
+   TString treePath = fTree->GetName();
+   if (dir != file) {
+      TString dirPath = dir->GetPath();
+      treePath = TString(dirPath(dirPath.Index(":/")+2, dirPath.Length())) + "/" + treePath;
+   }
+   // The full URL keeps the options the file was opened with.
+   const TString url = file->GetEndpointUrl()->GetUrl();
+   TString taskOption = option;
+   taskOption.ToLower();
+   taskOption.ReplaceAll("norm", "");
+   taskOption += " goff";
+   const Double_t weight = fTree->GetWeight();
+   const Long64_t estimate = fTree->GetEstimate();
+   TList *aliases = fTree->GetListOfAliases();
+
+   std::mutex slotsMutex;
+   std::vector<std::unique_ptr<TDrawSlot>> slots;
+   std::vector<TDrawSlot *> idleSlots;
+   std::vector<std::vector<Double_t>> rows(ranges.size());
+
+   auto recordRange = [&](UInt_t i) -> Bool_t {
+      TDrawSlot *slot = nullptr;
+      {
+         std::lock_guard<std::mutex> lock(slotsMutex);
+         if (idleSlots.empty()) {
+            slots.emplace_back(new TDrawSlot);
+            slot = slots.back().get();
+            slot->fHist.reset(static_cast<TH1 *>(hist->Clone()));
+            slot->fHist->SetDirectory(nullptr);
+         } else {
+            slot = idleSlots.back();
+            idleSlots.pop_back();
+         }
+      }
+      TDirectory::TContext ctxt;
+      if (!slot->fFile) {
+         slot->fFile.reset(TFile::Open(url));
+         if (slot->fFile && !slot->fFile->IsZombie())
+            slot->fTree = dynamic_cast<TTree *>(slot->fFile->Get(treePath));
+         if (slot->fTree) {
+            slot->fTree->SetImplicitMT(kFALSE);
+            slot->fTree->SetEstimate(estimate);
+            slot->fTree->SetWeight(weight);
+            if (aliases) {
+               for (TObject *alias : *aliases) slot->fTree->SetAlias(alias->GetName(), alias->GetTitle());
+            }
+         }
+      }
+      Bool_t ok = kFALSE;
+      if (slot->fTree) {
+         slot->fFile->cd();
+         slot->fHist->SetDirectory(slot->fFile.get());
+         TSelectorDrawRecorder recorder(varexp0, selection);
+         Long64_t n = slot->fTree->Process(&recorder, taskOption, ranges[i].second - ranges[i].first, ranges[i].first);
+         slot->fHist->SetDirectory(nullptr);
+         ok = n >= 0 && recorder.GetAction() == action && recorder.GetDimension() == dimension;
+         rows[i] = std::move(recorder.GetRows());
+      }
+      std::lock_guard<std::mutex> lock(slotsMutex);
+      idleSlots.push_back(slot);
+      return ok;
+   };
+
+   // The histogram as booked, to undo the waves already given to the selector
+   // if a later one fails.
+   std::unique_ptr<TH1> booked(static_cast<TH1 *>(hist->Clone()));
+   booked->SetDirectory(nullptr);
+
+   ROOT::TThreadExecutor pool;
+   const std::size_t waveSize = 2 * nslots;
+   nrows = 0;
+   for (std::size_t wave = 0; wave < ranges.size() && nrows >= 0; wave += waveSize) {
+      const std::size_t waveEnd = std::min(ranges.size(), wave + waveSize);
+      const auto ok = pool.Map(recordRange, ROOT::TSeqU((UInt_t)wave, (UInt_t)waveEnd));
+      if (std::find(ok.begin(), ok.end(), kFALSE) != ok.end()) {
+         Error("DrawSelect", "Could not process the entries of the tree %s in parallel", fTree->GetName());
+         nrows = -1;
+         break;
+      }
+      // Give the values to the selector in entry order, as ProcessFill does.
+      for (std::size_t i = wave; i < waveEnd; ++i) {
+         const std::vector<Double_t> &values = rows[i];
+         for (std::size_t r = 0; r < values.size(); r += dimension + 1) {
+            for (Int_t k = 0; k < dimension; ++k)
+               fSelector->fVal[k][fSelector->fNfill] = values[r + k];
+            fSelector->fW[fSelector->fNfill] = values[r + dimension];
+            if (++fSelector->fNfill >= fTree->GetEstimate()) {
+               fSelector->TakeAction();
+               fSelector->fNfill = 0;
+            }
+         }
+         std::vector<Double_t>().swap(rows[i]);
+      }
+   }
+   if (nrows >= 0) {
+      fSelector->SlaveTerminate();
+      fSelector->Terminate();
+      nrows = fSelector->GetStatus();
+   } else {
+      hist->Reset();
+      hist->Add(booked.get());
+      fSelector->fNfill = 0;
+      fSelector->fSelectedRows = 0;
+   }
+   fTree->SetNotify(0);
+   return kTRUE;
+#else
+   (void)varexp0;
+   (void)selection;
+   (void)option;
+   (void)nentries;
+   (void)firstentry;
+   (void)nrows;
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fit  a projected item(s) from a Tree.
 /// Returns -1 in case of error or number of selected events in case of success.
@@ -27,6 +27,7 @@ objects.
 #include "TROOT.h"
 #include "ROOT/TTreeProcessorMT.hxx"
 #include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/RTreeMetadata.hxx"
 
 using namespace ROOT;
 
@@ -101,23 +102,11 @@ TTreeView::MakeReaderWithEntryList(TEntryList &globalList, Long64_t start, Long6
    auto localList = std::make_unique<TEntryList>();
 
    for (auto gl : globalEntryLists) {
-      Long64_t entry = gl->GetEntry(0);
-
-      // this may be owned by the local list
-      auto tmp_list = new TEntryList(gl->GetName(), gl->GetTitle(), gl->GetFileName(), gl->GetTreeName());
-
-      do {
-         if (entry >= end) {
-            break;
-         } else if (entry >= start) {
-            tmp_list->Enter(entry);
-         }
-      } while ((entry = gl->Next()) >= 0);
-
+      // Slice does not touch the iteration state of the global list, which is shared by all tasks.
+      // The local list copies the entries of tmp_list.
+      std::unique_ptr<TEntryList> tmp_list(gl->Slice(start, end));
       if (tmp_list->GetN() > 0) {
-         localList->Add(tmp_list);
-      } else {
-         delete tmp_list;
+         localList->Add(tmp_list.get());
       }
    }
 
@@ -168,20 +157,24 @@ static ClustersAndEntries MakeClusters(const std::string &treeName, const std::v
    std::vector<std::vector<EntryCluster>> clustersPerFile;
    std::vector<Long64_t> entriesPerFile;
    entriesPerFile.reserve(nFileNames);
+   // The files are opened concurrently, and their metadata possibly taken from a cache,
+   // see ROOT::Internal::GetTreeMetadata.
+   std::vector<RTreeLocation_t> locations;
+   for (const auto &fileName : fileNames)
+      locations.emplace_back(fileName, treeName);
+   const auto nThreads = nFileNames > 1 ? GetTreeMetadataThreads() : 1u;
+   const auto metadata = GetTreeMetadata(locations, nThreads);
+
    Long64_t offset = 0ll;
-   for (const auto &fileName : fileNames) {
-      auto fileNameC = fileName.c_str();
-      std::unique_ptr<TFile> f(TFile::Open(fileNameC)); // need TFile::Open to load plugins if need be
-      if (!f || f->IsZombie()) {
+   for (std::size_t i = 0; i < nFileNames; ++i) {
+      auto fileNameC = fileNames[i].c_str();
+      if (metadata[i].fStatus == RTreeMetadata::kNoFile) {
          Error("TTreeProcessorMT::Process", "An error occurred while opening file %s: skipping it.", fileNameC);
          clustersPerFile.emplace_back(std::vector<EntryCluster>());
          entriesPerFile.emplace_back(0ULL);
          continue;
       }
-      TTree *t = nullptr; // not a leak, t will be deleted by f
-      f->GetObject(treeName.c_str(), t);
-
-      if (!t) {
+      if (metadata[i].fStatus == RTreeMetadata::kNoTree) {
          Error("TTreeProcessorMT::Process", "An error occurred while getting tree %s from file %s: skipping this file.",
                treeName.c_str(), fileNameC);
          clustersPerFile.emplace_back(std::vector<EntryCluster>());
@@ -189,15 +182,13 @@ static ClustersAndEntries MakeClusters(const std::string &treeName, const std::v
          continue;
       }
 
-      auto clusterIter = t->GetClusterIterator(0);
-      Long64_t start = 0ll, end = 0ll;
-      const Long64_t entries = t->GetEntries();
+      const Long64_t entries = metadata[i].fEntries;
+      const auto &boundaries = metadata[i].fClusters;
       // Iterate over the clusters in the current file
       std::vector<EntryCluster> clusters;
-      while ((start = clusterIter()) < entries) {
-         end = clusterIter.GetNextEntry();
+      for (std::size_t c = 0; c + 1 < boundaries.size(); ++c) {
          // Add the current file's offset to start and end to make them (chain) global
-         clusters.emplace_back(EntryCluster{start + offset, end + offset});
+         clusters.emplace_back(EntryCluster{boundaries[c] + offset, boundaries[c + 1] + offset});
       }
       offset += entries;
       clustersPerFile.emplace_back(std::move(clusters));
@@ -36,6 +36,13 @@ ROOT::Internal::TVirtualCollectionReader::~TVirtualCollectionReader() {}
 namespace {
    using namespace ROOT::Internal;
 
+   // Whether the elements of the collection are stored next to each other;
+   // std::vector<bool> is a bitset and vectors of pointers need a dereference.
+   bool IsContiguousCollection(TVirtualCollectionProxy *collection) {
+      return collection->GetCollectionType() == ROOT::kSTLvector && !collection->HasPointers()
+         && collection->GetType() != kBool_t;
+   }
+
    // Reader interface for clones arrays
    class TClonesReader: public TVirtualCollectionReader {
    public:
@@ -99,6 +106,11 @@ namespace {
             return myCollectionProxy->At(idx);
          }
       }
+
+      bool IsContiguous(ROOT::Detail::TBranchProxy* proxy) override {
+         TVirtualCollectionProxy *myCollectionProxy = GetCP(proxy);
+         return myCollectionProxy && IsContiguousCollection(myCollectionProxy);
+      }
    };
 
    class TCollectionLessSTLReader final: public TVirtualCollectionReader {
@@ -145,6 +157,10 @@ namespace {
             return myCollectionProxy->At(idx);
          }
       }
+
+      bool IsContiguous(ROOT::Detail::TBranchProxy* /*proxy*/) override {
+         return IsContiguousCollection(fLocalCollection);
+      }
    };
 
 
@@ -193,6 +209,9 @@ namespace {
       void SetBasicTypeSize(Int_t size){
          fBasicTypeSize = size;
       }
+
+      // The elements are laid out one after the other starting at the proxy's address.
+      bool IsContiguous(ROOT::Detail::TBranchProxy* /*proxy*/) override { return true; }
    };
 
    template <class BASE>
@@ -311,6 +330,9 @@ namespace {
          return (Byte_t*)address + (fElementSize * idx);
       }
 
+      // The leaf array is read in one block into its buffer.
+      bool IsContiguous(ROOT::Detail::TBranchProxy* /*proxy*/) override { return true; }
+
    protected:
       void ProxyRead(){
          fValueReader->ProxyRead();
@@ -208,3 +208,38 @@ TEST(TTreeReaderArray, Float16_t)
       }
    }
 }
+
+TEST(TTreeReaderArray, Contiguous)
+{
+   TTree tree("TTreeReaderArrayTree", "In-memory test tree");
+   std::vector<float> vecf{17.f, 18.f, 19.f};
+   std::vector<bool> vecb{true, false, true};
+   int n = 4;
+   double arr[4] = {1., 2., 3., 4.};
+   tree.Branch("vec", &vecf);
+   tree.Branch("vecb", &vecb);
+   tree.Branch("n", &n);
+   tree.Branch("arr", &arr, "arr[n]/D");
+   tree.Fill();
+   tree.ResetBranchAddresses();
+
+   TTreeReader tr(&tree);
+   TTreeReaderArray<float> vec(tr, "vec");
+   TTreeReaderArray<bool> vb(tr, "vecb");
+   TTreeReaderArray<double> a(tr, "arr");
+   tr.SetEntry(0);
+
+   EXPECT_TRUE(vec.IsContiguous());
+   EXPECT_FALSE(vb.IsContiguous());
+   EXPECT_TRUE(a.IsContiguous());
+
+   auto span = vec.AsSpan();
+   ASSERT_EQ(3u, span.size());
+   EXPECT_EQ(&vec[0], span.data());
+   EXPECT_FLOAT_EQ(19.f, span[2]);
+
+   auto aspan = a.AsSpan();
+   ASSERT_EQ(4u, aspan.size());
+   EXPECT_EQ(&a[0], aspan.data());
+   EXPECT_DOUBLE_EQ(4., aspan[3]);
+}
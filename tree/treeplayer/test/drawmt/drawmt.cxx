@@ -0,0 +1,114 @@
+#include <TFile.h>
+#include <TH1D.h>
+#include <TH2F.h>
+#include <TProfile.h>
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+void WriteDrawTree(const char *filename)
+{
+   TFile file(filename, "RECREATE");
+   TTree t("t", "t");
+   int i = 0;
+   double x = 0.;
+   t.Branch("i", &i);
+   t.Branch("x", &x);
+   t.SetAutoFlush(1000);
+   for (i = 0; i < 100000; ++i) {
+      x = (i % 997) / 128.; // exactly representable, for exact sums
+      t.Fill();
+   }
+   t.Write();
+}
+
+void ExpectSameHistograms(const TH1 &h1, const TH1 &h2)
+{
+   ASSERT_EQ(h1.GetNcells(), h2.GetNcells());
+   for (int bin = 0; bin < h1.GetNcells(); ++bin) {
+      EXPECT_EQ(h1.GetBinContent(bin), h2.GetBinContent(bin));
+      EXPECT_EQ(h1.GetBinError(bin), h2.GetBinError(bin));
+   }
+   EXPECT_EQ(h1.GetEntries(), h2.GetEntries());
+   std::vector<double> stats1(TH1::kNstat), stats2(TH1::kNstat);
+   h1.GetStats(stats1.data());
+   h2.GetStats(stats2.data());
+   EXPECT_EQ(stats1, stats2);
+}
+
+TEST(TTreeDrawMT, SameAsSequential)
+{
+   const char *filename = "treeplayer_drawmt.root";
+   WriteDrawTree(filename);
+
+   TFile file(filename);
+   auto t = file.Get<TTree>("t");
+   t->SetEstimate(100);
+
+   TH1D h1("h1", "x", 100, 0., 8.);
+   TH2F h2("h2", "x:i", 10, 0., 100000., 10, 0., 8.);
+   TProfile p("p", "x:i", 10, 0., 100000.);
+   TH1D h1mt("h1mt", "x", 100, 0., 8.);
+   TH2F h2mt("h2mt", "x:i", 10, 0., 100000., 10, 0., 8.);
+   TProfile pmt("pmt", "x:i", 10, 0., 100000.);
+
+   EXPECT_EQ(t->Draw("x>>h1", "i%3==0", "goff"), 33334);
+   EXPECT_EQ(t->Draw("x:i>>h2", "", "goff"), 100000);
+   EXPECT_EQ(t->Draw("x:i>>p", "x>1", "goff", 50000, 20000), 43481);
+
+   ROOT::EnableImplicitMT(4);
+   EXPECT_EQ(t->Draw("x>>h1mt", "i%3==0", "goff"), 33334);
+   EXPECT_EQ(t->Draw("x:i>>h2mt", "", "goff"), 100000);
+   EXPECT_EQ(t->Draw("x:i>>pmt", "x>1", "goff", 50000, 20000), 43481);
+   // Adding to the existing content.
+   EXPECT_EQ(t->Draw("x>>+h1mt", "i%3==0", "goff"), 33334);
+   ROOT::DisableImplicitMT();
+
+   ExpectSameHistograms(h1, h1mt);
+   ExpectSameHistograms(h2, h2mt);
+   ExpectSameHistograms(p, pmt);
+   EXPECT_EQ(t->Draw("x>>+h1", "i%3==0", "goff"), 33334);
+   ExpectSameHistograms(h1, h1mt);
+
+   gSystem->Unlink(filename);
+}
+
+// Non-integer weights give the same sums only if the rows are filled in the
+// same order; GetV1(), GetV2() and GetW() hold the values of the last rows.
+TEST(TTreeDrawMT, SameOrderAsSequential)
+{
+   const char *filename = "treeplayer_drawmt_order.root";
+   WriteDrawTree(filename);
+
+   TFile file(filename);
+   auto t = file.Get<TTree>("t");
+
+   for (Long64_t estimate : {1000ll, 1000000ll}) {
+      t->SetEstimate(estimate);
+      TH2F h("h", "x:i", 10, 0., 100000., 100, 0., 8.);
+      TH2F hmt("hmt", "x:i", 10, 0., 100000., 100, 0., 8.);
+
+      const Long64_t nrows = t->Draw("x:i>>h", "0.1*x+0.3", "goff");
+      ASSERT_EQ(100000, nrows);
+      const Long64_t nvalues = nrows > estimate ? nrows % estimate : nrows;
+      std::vector<double> v1(t->GetV1(), t->GetV1() + nvalues);
+      std::vector<double> v2(t->GetV2(), t->GetV2() + nvalues);
+      std::vector<double> w(t->GetW(), t->GetW() + nvalues);
+
+      ROOT::EnableImplicitMT(4);
+      EXPECT_EQ(nrows, t->Draw("x:i>>hmt", "0.1*x+0.3", "goff"));
+      ROOT::DisableImplicitMT();
+
+      ExpectSameHistograms(h, hmt);
+      EXPECT_EQ(nrows, t->GetSelectedRows());
+      EXPECT_EQ(v1, std::vector<double>(t->GetV1(), t->GetV1() + nvalues));
+      EXPECT_EQ(v2, std::vector<double>(t->GetV2(), t->GetV2() + nvalues));
+      EXPECT_EQ(w, std::vector<double>(t->GetW(), t->GetW() + nvalues));
+   }
+
+   gSystem->Unlink(filename);
+}
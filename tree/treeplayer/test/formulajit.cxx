@@ -0,0 +1,97 @@
+#include "TTree.h"
+#include "TTreeFormula.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+std::unique_ptr<TTree> MakeFormulaTree()
+{
+   auto tree = std::make_unique<TTree>("t", "t");
+   tree->SetDirectory(nullptr);
+   int n = 0;
+   float arr[10];
+   double x = 0.;
+   Long64_t bits = 0;
+   tree->Branch("n", &n);
+   tree->Branch("arr", arr, "arr[n]/F");
+   tree->Branch("x", &x);
+   tree->Branch("bits", &bits);
+   for (int i = 0; i < 100; ++i) {
+      n = i % 10;
+      for (int j = 0; j < n; ++j)
+         arr[j] = 0.25f * (i - 4 * j);
+      x = (i - 50) / 7.;
+      bits = i * 37;
+      tree->Fill();
+   }
+   return tree;
+}
+
+/// Evaluate all the instances of all the entries; set compiled to whether the
+/// compiled version of the formula was used.
+std::vector<double> EvalAll(TTree &tree, const char *expression, bool &compiled)
+{
+   std::vector<double> values;
+   TTreeFormula formula("f", expression, &tree);
+   EXPECT_FALSE(formula.GetNdim() == 0) << expression;
+   for (Long64_t entry = 0; entry < tree.GetEntries(); ++entry) {
+      tree.LoadTree(entry);
+      const int ndata = formula.GetNdata();
+      values.push_back(ndata);
+      for (int i = 0; i < ndata; ++i)
+         values.push_back(formula.EvalInstance(i));
+   }
+   compiled = formula.IsJITCompiled();
+   return values;
+}
+
+} // anonymous namespace
+
+TEST(TTreeFormula, JIT)
+{
+   auto tree = MakeFormulaTree();
+   const char *expressions[] = {"x*x+2*x-1",
+                                "x/(n-5)",
+                                "sqrt(x)+log(x)+exp(x*100)+tan(x)",
+                                "acos(x/10)+asin(x/10)+atanh(x/10)+acosh(x)",
+                                "abs(x)>1 && n%3==0",
+                                "x<0 || arr>2",
+                                "!(n>4) + (n!=2) - sign(x)",
+                                "arr*x - int(arr)",
+                                "min(arr,x)+max(arr,n)+pow(x,2)+fmod(x,0.3)",
+                                "(bits&0xff)+(bits|3)+(bits>>2)+(bits<<1)",
+                                "Entry$*2+Iteration$",
+                                "-x+TMath::Pi()"};
+   bool isCompiled = false;
+   for (auto expression : expressions) {
+      TTreeFormula::SetJIT(kFALSE);
+      const auto interpreted = EvalAll(*tree, expression, isCompiled);
+      EXPECT_FALSE(isCompiled) << expression;
+      TTreeFormula::SetJIT(kTRUE);
+      const auto compiled = EvalAll(*tree, expression, isCompiled);
+      EXPECT_TRUE(isCompiled) << expression;
+      ASSERT_EQ(interpreted.size(), compiled.size()) << expression;
+      for (std::size_t i = 0; i < interpreted.size(); ++i)
+         EXPECT_EQ(interpreted[i], compiled[i]) << expression << " at " << i;
+   }
+   TTreeFormula::SetJIT(kFALSE);
+}
+
+TEST(TTreeFormula, JITFallback)
+{
+   auto tree = MakeFormulaTree();
+   // Ternaries are not compiled: the interpreted evaluation is used.
+   const char *expression = "n>5 ? x : arr";
+   bool isCompiled = true;
+   TTreeFormula::SetJIT(kFALSE);
+   const auto interpreted = EvalAll(*tree, expression, isCompiled);
+   TTreeFormula::SetJIT(kTRUE);
+   const auto jit = EvalAll(*tree, expression, isCompiled);
+   EXPECT_FALSE(isCompiled);
+   EXPECT_EQ(interpreted, jit);
+   TTreeFormula::SetJIT(kFALSE);
+}
@@ -0,0 +1,137 @@
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreePerfStats.h"
+
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string ReadFile(const char *fname)
+{
+   std::ifstream in(fname);
+   std::stringstream content;
+   content << in.rdbuf();
+   return content.str();
+}
+
+} // anonymous namespace
+
+TEST(TTreePerfStats, PerBranch)
+{
+   const char *fname = "perfstats.root";
+   {
+      TFile f(fname, "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(100);
+      Int_t x = 0;
+      Double_t y = 0;
+      t.Branch("x", &x);
+      t.Branch("y", &y);
+      for (Int_t i = 0; i < 1000; ++i) {
+         x = i;
+         y = 0.5 * i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   {
+      TFile f(fname);
+      auto t = f.Get<TTree>("t");
+      ASSERT_NE(nullptr, t);
+      TTreePerfStats ps("ioperf", t);
+      ps.SetTraceEvents();
+      for (Long64_t e = 0; e < t->GetEntries(); ++e)
+         t->GetEntry(e);
+
+      for (auto name : {"x", "y"}) {
+         auto info = ps.GetBranchInfo(name);
+         EXPECT_EQ(10u, info.fBaskets) << name;
+         EXPECT_LT(0u, info.fBytesRead) << name;
+         EXPECT_LT(0u, info.fBytesUnzipped) << name;
+      }
+      EXPECT_EQ(0u, ps.GetBranchInfo("z").fBaskets);
+      auto threads = ps.GetThreadInfo();
+      ASSERT_EQ(1u, threads.size());
+      EXPECT_EQ(20u, threads.begin()->second.fBaskets);
+
+      ps.SaveAs("perfstats.json", "counters");
+      ps.SaveAs("perfstats.trace", "trace");
+   }
+
+   auto json = ReadFile("perfstats.json");
+   EXPECT_NE(std::string::npos, json.find("{\"name\": \"x\", \"baskets\": 10,"));
+   EXPECT_NE(std::string::npos, json.find("\"threads\": ["));
+   auto trace = ReadFile("perfstats.trace");
+   EXPECT_EQ(0u, trace.find("{\"displayTimeUnit\": \"ms\", \"traceEvents\": ["));
+   EXPECT_NE(std::string::npos, trace.find("\"name\": \"y\", \"cat\": \"unzip\""));
+
+   for (auto name : {fname, "perfstats.json", "perfstats.trace"})
+      gSystem->Unlink(name);
+}
+
+#ifdef R__USE_IMT
+// With IMT, TTree::GetEntry reads the branches in parallel: the baskets are
+// accounted to the thread which read them.
+TEST(TTreePerfStats, PerThreadMT)
+{
+   const char *fname = "perfstatsmt.root";
+   const Int_t nBranches = 8;
+   {
+      TFile f(fname, "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(100);
+      std::vector<Double_t> values(nBranches);
+      for (Int_t b = 0; b < nBranches; ++b)
+         t.Branch(TString::Format("b%d", b), &values[b]);
+      for (Int_t i = 0; i < 1000; ++i) {
+         for (Int_t b = 0; b < nBranches; ++b)
+            values[b] = i * b;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   ROOT::EnableImplicitMT(4);
+   {
+      TFile f(fname);
+      auto t = f.Get<TTree>("t");
+      ASSERT_NE(nullptr, t);
+      TTreePerfStats ps("ioperf", t);
+      for (Long64_t e = 0; e < t->GetEntries(); ++e)
+         t->GetEntry(e);
+
+      TTreePerfStats::BranchInfo branchTotal;
+      for (Int_t b = 0; b < nBranches; ++b) {
+         auto info = ps.GetBranchInfo(TString::Format("b%d", b));
+         EXPECT_EQ(10u, info.fBaskets) << b;
+         branchTotal.fBaskets += info.fBaskets;
+         branchTotal.fBytesRead += info.fBytesRead;
+         branchTotal.fBytesUnzipped += info.fBytesUnzipped;
+      }
+
+      TTreePerfStats::BranchInfo threadTotal;
+      auto threads = ps.GetThreadInfo();
+      EXPECT_LE(1u, threads.size());
+      for (auto &thread : threads) {
+         threadTotal.fBaskets += thread.second.fBaskets;
+         threadTotal.fBytesRead += thread.second.fBytesRead;
+         threadTotal.fBytesUnzipped += thread.second.fBytesUnzipped;
+      }
+      EXPECT_EQ(10u * nBranches, threadTotal.fBaskets);
+      EXPECT_EQ(branchTotal.fBaskets, threadTotal.fBaskets);
+      EXPECT_EQ(branchTotal.fBytesRead, threadTotal.fBytesRead);
+      EXPECT_EQ(branchTotal.fBytesUnzipped, threadTotal.fBytesUnzipped);
+   }
+   ROOT::DisableImplicitMT();
+
+   gSystem->Unlink(fname);
+}
+#endif
@@ -0,0 +1,88 @@
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeIndex.h"
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <memory>
+#include <utility>
+
+TEST(TTreeIndex, Lookup)
+{
+   TTree t("t", "t");
+   t.SetDirectory(nullptr);
+   int run = 0, event = 0;
+   t.Branch("run", &run);
+   t.Branch("event", &event);
+   std::map<std::pair<Long64_t, Long64_t>, Long64_t> reference;
+   for (int i = 0; i < 10000; ++i) {
+      run = (i * 7919) % 37;
+      event = (i * 104729) % 1000;
+      t.Fill();
+      reference.emplace(std::make_pair(run, event), i);
+   }
+   ASSERT_EQ(t.BuildIndex("run", "event"), 10000);
+   auto index = static_cast<TTreeIndex *>(t.GetTreeIndex());
+   for (Long64_t i = 1; i < index->GetN(); ++i) {
+      auto prev = std::make_pair(index->GetIndexValues()[i - 1], index->GetIndexValuesMinor()[i - 1]);
+      auto cur = std::make_pair(index->GetIndexValues()[i], index->GetIndexValuesMinor()[i]);
+      EXPECT_LE(prev, cur);
+   }
+   for (Long64_t r = -1; r <= 38; ++r) {
+      for (Long64_t e = -1; e <= 1001; e += 3) {
+         auto found = reference.find(std::make_pair(r, e));
+         Long64_t entry = t.GetEntryNumberWithIndex(r, e);
+         if (found == reference.end()) {
+            EXPECT_EQ(entry, -1);
+         } else {
+            t.GetEntry(entry);
+            EXPECT_EQ(run, r);
+            EXPECT_EQ(event, e);
+         }
+      }
+   }
+}
+
+TEST(TTreeIndex, BuildInParallel)
+{
+   const char *filename = "treeplayer_treeindex.root";
+   {
+      TFile f(filename, "RECREATE");
+      TTree t("t", "t");
+      Long64_t run = 0, event = 0;
+      t.Branch("run", &run);
+      t.Branch("event", &event);
+      t.SetAutoFlush(1000);
+      for (Long64_t i = 0; i < 200000; ++i) {
+         run = 10 - i / 20000;
+         event = (i * 7919) % 20000;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TFile f(filename);
+   auto t = f.Get<TTree>("t");
+   ASSERT_EQ(t->BuildIndex("run", "event"), 200000);
+   std::unique_ptr<TTreeIndex> serial(static_cast<TTreeIndex *>(t->GetTreeIndex()));
+   t->SetTreeIndex(nullptr);
+
+   ROOT::EnableImplicitMT(4);
+   ASSERT_EQ(t->BuildIndex("run", "event"), 200000);
+   ROOT::DisableImplicitMT();
+   auto parallel = static_cast<TTreeIndex *>(t->GetTreeIndex());
+
+   ASSERT_EQ(serial->GetN(), parallel->GetN());
+   for (Long64_t i = 0; i < serial->GetN(); ++i) {
+      EXPECT_EQ(serial->GetIndex()[i], parallel->GetIndex()[i]);
+      EXPECT_EQ(serial->GetIndexValues()[i], parallel->GetIndexValues()[i]);
+      EXPECT_EQ(serial->GetIndexValuesMinor()[i], parallel->GetIndexValuesMinor()[i]);
+   }
+   EXPECT_EQ(t->GetEntryNumberWithIndex(10, 7919), 1);
+   EXPECT_EQ(t->GetEntryNumberWithIndex(1, 0), 180000);
+
+   gSystem->Unlink(filename);
+}